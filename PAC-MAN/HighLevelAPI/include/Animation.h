@@ -43,6 +43,13 @@ public:
 	// Clone an animation, returning a dynamically allocated copy.
 	Component* Clone() const override;
 
+	// Reset the animation to match the archetype's, so a pooled object can be reused.
+	// Params:
+	//   archetype = The matching component of the object's archetype.
+	// Returns:
+	//   True, as the animation can always be reset.
+	bool Reset(const Component& archetype) override;
+
 	// Initialize components.
 	void Initialize() override;
 
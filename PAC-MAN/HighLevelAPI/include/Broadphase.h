@@ -0,0 +1,101 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	Broadphase.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <Vector2D.h>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Forward Declarations:
+//------------------------------------------------------------------------------
+
+class Collider;
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// A collider as seen by the broadphase for a single collision step.
+struct BroadphaseProxy
+{
+	// Constructor
+	// Params:
+	//   collider = The collider this proxy represents.
+	BroadphaseProxy(Collider* collider = nullptr);
+
+	// The collider this proxy represents.
+	Collider* collider;
+
+	// World-space bounds of the collider (only valid if bounded is true).
+	Vector2D min;
+	Vector2D max;
+
+	// Whether the collider has finite bounds. Unbounded colliders are paired with everything.
+	bool bounded;
+};
+
+// A pair of proxies that might be colliding.
+struct BroadphasePair
+{
+	// Constructor
+	// Params:
+	//   first = The index of the first proxy.
+	//   second = The index of the second proxy (always greater than first).
+	BroadphasePair(unsigned first, unsigned second);
+
+	// Orders pairs the same way a nested loop over the proxy list would visit them.
+	bool operator<(const BroadphasePair& other) const;
+
+	// Indices into the proxy list that was passed to the broadphase.
+	unsigned first;
+	unsigned second;
+};
+
+// Broadphase interface - Culls the list of collider pairs the narrowphase needs to test.
+class Broadphase
+{
+public:
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Destructor
+	virtual ~Broadphase();
+
+	// Finds every pair of proxies that might be colliding.
+	// Params:
+	//   proxies = The colliders taking part in this collision step, in object list order.
+	//   pairs = The list that will be filled with candidate pairs, sorted by (first, second).
+	virtual void FindPairs(const std::vector<BroadphaseProxy>& proxies, std::vector<BroadphasePair>& pairs) = 0;
+
+	// Forgets a collider that is leaving the simulation. Broadphases that keep state
+	//   between steps must drop it here, as the collider's memory may be reused.
+	// Params:
+	//   collider = The collider being removed.
+	virtual void RemoveCollider(const Collider& collider);
+
+	// Checks whether the bounds of two proxies overlap.
+	// Params:
+	//   a = The first proxy.
+	//   b = The second proxy.
+	// Returns:
+	//   True if either proxy is unbounded or their bounds overlap.
+	static bool BoundsOverlap(const BroadphaseProxy& a, const BroadphaseProxy& b);
+};
+
+//------------------------------------------------------------------------------
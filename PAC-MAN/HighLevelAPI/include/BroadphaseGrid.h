@@ -0,0 +1,101 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	BroadphaseGrid.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "Broadphase.h"
+
+#include <unordered_map>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// Uniform grid broadphase - Buckets colliders into a spatial hash of fixed-size cells
+//   and only pairs colliders that share a cell.
+class BroadphaseGrid : public Broadphase
+{
+public:
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Constructor
+	// Params:
+	//   cellSize = The width and height of each grid cell in world units.
+	//   maxCellsPerProxy = Colliders covering more cells than this are treated as unbounded.
+	BroadphaseGrid(float cellSize = 64.0f, unsigned maxCellsPerProxy = 64);
+
+	// Finds every pair of proxies that might be colliding.
+	// Params:
+	//   proxies = The colliders taking part in this collision step, in object list order.
+	//   pairs = The list that will be filled with candidate pairs, sorted by (first, second).
+	void FindPairs(const std::vector<BroadphaseProxy>& proxies, std::vector<BroadphasePair>& pairs) override;
+
+	// Sets the size of the grid cells.
+	// Params:
+	//   cellSize = The width and height of each grid cell in world units.
+	void SetCellSize(float cellSize);
+
+	// Gets the size of the grid cells.
+	float GetCellSize() const;
+
+private:
+	//------------------------------------------------------------------------------
+	// Private Structures:
+	//------------------------------------------------------------------------------
+
+	// The range of cells covered by a proxy.
+	struct CellRange
+	{
+		int minX;
+		int minY;
+		int maxX;
+		int maxY;
+	};
+
+	//------------------------------------------------------------------------------
+	// Private Functions:
+	//------------------------------------------------------------------------------
+
+	// Converts a world coordinate to a cell coordinate.
+	int ToCell(float coordinate) const;
+
+	// Packs a pair of cell coordinates into a hash key.
+	static long long CellKey(int x, int y);
+
+	//------------------------------------------------------------------------------
+	// Private Variables:
+	//------------------------------------------------------------------------------
+
+	float cellSize;
+	unsigned maxCellsPerProxy;
+
+	// Proxy indices in each cell. Buckets are kept between steps so their memory is reused.
+	std::unordered_map<long long, std::vector<unsigned>> cells;
+
+	// Buckets that have been written to during the current step.
+	std::vector<std::pair<long long, std::vector<unsigned>*>> usedCells;
+
+	// Cell coverage of each proxy during the current step.
+	std::vector<CellRange> ranges;
+
+	// Proxies that have no finite bounds (or cover too many cells).
+	std::vector<unsigned> unboundedProxies;
+};
+
+//------------------------------------------------------------------------------
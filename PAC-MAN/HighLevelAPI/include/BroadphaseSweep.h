@@ -0,0 +1,121 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	BroadphaseSweep.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "Broadphase.h"
+
+#include <unordered_map>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// Sort and sweep broadphase - Keeps the x-axis endpoints of every collider sorted between
+//   steps. Objects move coherently, so repairing the order with an insertion sort is close
+//   to linear, and a single sweep over the endpoints finds every overlapping pair. Colliders
+//   seen for the first time are sorted separately and merged in. Select it with
+//   GameObjectManager::SetBroadphase.
+class BroadphaseSweep : public Broadphase
+{
+public:
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Constructor
+	BroadphaseSweep();
+
+	// Finds every pair of proxies that might be colliding.
+	// Params:
+	//   proxies = The colliders taking part in this collision step, in object list order.
+	//   pairs = The list that will be filled with candidate pairs, sorted by (first, second).
+	void FindPairs(const std::vector<BroadphaseProxy>& proxies, std::vector<BroadphasePair>& pairs) override;
+
+	// Forgets a collider that is leaving the simulation.
+	// Params:
+	//   collider = The collider being removed.
+	void RemoveCollider(const Collider& collider) override;
+
+private:
+	//------------------------------------------------------------------------------
+	// Private Structures:
+	//------------------------------------------------------------------------------
+
+	// A collider tracked across steps.
+	struct SweepProxy
+	{
+		const Collider* collider;
+
+		// The proxy's index in the list passed to FindPairs this step.
+		unsigned index;
+
+		// The step this proxy was last seen in.
+		unsigned step;
+
+		// Whether the proxy has been removed and its endpoints should be discarded.
+		bool removed;
+	};
+
+	// One end of a proxy's interval on the x-axis.
+	struct Endpoint
+	{
+		float value;
+		unsigned proxy;
+		bool isMin;
+	};
+
+	//------------------------------------------------------------------------------
+	// Private Functions:
+	//------------------------------------------------------------------------------
+
+	// Discards the endpoints of removed proxies and recycles their slots.
+	void RemoveDeadProxies();
+
+	// Gets the position of one end of a proxy's interval on the x-axis.
+	// Params:
+	//   proxy = The proxy.
+	//   isMin = Whether to get the start of the interval instead of the end.
+	static float GetEndpointValue(const BroadphaseProxy& proxy, bool isMin);
+
+	// Checks whether one endpoint must be sorted before another.
+	static bool EndpointLess(const Endpoint& a, const Endpoint& b);
+
+	//------------------------------------------------------------------------------
+	// Private Variables:
+	//------------------------------------------------------------------------------
+
+	// Every tracked collider, and a map from collider to slot.
+	std::vector<SweepProxy> sweepProxies;
+	std::unordered_map<const Collider*, unsigned> proxyLookup;
+	std::vector<unsigned> freeProxies;
+	bool hasRemovedProxies;
+
+	// Endpoints of every tracked proxy, sorted along the x-axis.
+	std::vector<Endpoint> endpoints;
+
+	// Endpoints of proxies first seen this step, waiting to be merged into the sorted list.
+	std::vector<Endpoint> newEndpoints;
+
+	// Proxies whose intervals contain the current sweep position.
+	std::vector<unsigned> activeProxies;
+
+	// Incremented every time pairs are found.
+	unsigned currentStep;
+};
+
+//------------------------------------------------------------------------------
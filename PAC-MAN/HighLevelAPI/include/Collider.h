@@ -26,6 +26,7 @@
 class Transform;
 class Physics;
 class GameObject;
+class Vector2D;
 
 //------------------------------------------------------------------------------
 // Public Consts:
@@ -100,13 +101,48 @@ public:
 	// Check if two objects are colliding and send collision events.
 	// Params:
 	//	 other = Reference to the second collider component.
-	void CheckCollision(const Collider& other);
+	//   wasColliding = Whether the two colliders were touching during the previous step.
+	// Returns:
+	//   Whether the two colliders are touching.
+	bool CheckCollision(const Collider& other, bool wasColliding = false);
+
+	// Send collision events to two colliders that are touching.
+	// Params:
+	//	 other = Reference to the second collider component.
+	//   wasColliding = Whether the two colliders were touching during the previous step.
+	void SendCollisionEvents(const Collider& other, bool wasColliding) const;
+
+	// Send collision exit events to two colliders that have stopped touching.
+	// Params:
+	//	 other = Reference to the second collider component.
+	void EndCollision(const Collider& other) const;
+
+	// Check whether the collision groups and masks of two colliders allow them to collide.
+	// Params:
+	//	 other = Reference to the second collider component.
+	// Returns:
+	//   True if each collider's group is included in the other's mask.
+	bool CanCollideWith(const Collider& other) const;
+
+	// Compute a world-space axis-aligned box that contains this collider, used by the broadphase.
+	// Params:
+	//   min = Receives the bottom-left corner of the box.
+	//   max = Receives the top-right corner of the box.
+	// Returns:
+	//   False if the collider has no finite bounds and must be tested against every other collider.
+	virtual bool GetBounds(Vector2D& min, Vector2D& max) const;
 
 	// Perform intersection test between two arbitrary colliders.
 	// Params:
 	//	 other = Reference to the second collider component.
 	virtual bool IsCollidingWith(const Collider& other) const = 0;
 
+	// Whether IsCollidingWith can change either object (for example by resolving the collision),
+	//   so it must be run on the main thread in dispatch order instead of on a worker thread.
+	// Returns:
+	//   False, as most colliders only read state while testing.
+	virtual bool HasCollisionSideEffects() const;
+
 	// Get the type of this component.
 	ColliderType GetType() const;
 
@@ -115,6 +151,21 @@ public:
 	//   handler = A pointer to the collision handler function.
 	void SetCollisionHandler(CollisionEventHandler handler);
 
+	// Sets the function called on the first step this collider touches another collider.
+	// Params:
+	//   handler = A pointer to the collision handler function.
+	void SetCollisionEnterHandler(CollisionEventHandler handler);
+
+	// Sets the function called on every following step the colliders keep touching.
+	// Params:
+	//   handler = A pointer to the collision handler function.
+	void SetCollisionStayHandler(CollisionEventHandler handler);
+
+	// Sets the function called on the first step the colliders are no longer touching.
+	// Params:
+	//   handler = A pointer to the collision handler function.
+	void SetCollisionExitHandler(CollisionEventHandler handler);
+
 	// Sets the map collision handler function for the collider.
 	// Params:
 	//   handler = A pointer to the collision handler function.
@@ -145,6 +196,11 @@ private:
 
 	// Function pointer for collision handler
 	CollisionEventHandler handler;
+
+	// Function pointers for collision state changes
+	CollisionEventHandler enterHandler;
+	CollisionEventHandler stayHandler;
+	CollisionEventHandler exitHandler;
 	
 	// Function pointer for tilemap collision handling
 	MapCollisionEventHandler mapHandler;
@@ -14,6 +14,7 @@
 //------------------------------------------------------------------------------
 
 #include <Collider.h>				// Collider
+#include <Intersection2D.h>			// Convex Polygon
 #include <vector>					// Vector
 
 //------------------------------------------------------------------------------
@@ -34,6 +35,11 @@ private:
 
 	// The local points of the collider
 	std::vector<LineSegment> localLines;
+
+	// The cached world-space polygon, and the transform and matrix version it was calculated from
+	mutable ConvexPolygon worldPolygon;
+	mutable const Transform* worldPolygonTransform;
+	mutable unsigned worldPolygonVersion;
 public:
 	//------------------------------------------------------------------------------
 	// Public Functions
@@ -63,7 +69,8 @@ public:
 	//	parser: The parser we are using to write the component into a file
 	virtual void Serialize(Parser& parser) const override;
 
-	// Reads the component from a file
+	// Reads the component from a file. Throws a ParseException if the file has more than
+	// ConvexPolygon::maxVertices sides
 	// Params:
 	//	parser: The parser we are using to read the component from the file
 	virtual void Deserialize(Parser& parser) override;
@@ -75,7 +82,9 @@ public:
 	// if the collider's shape is not a convex, then the collision detection will not be accurate
 	// Params:
 	//	segment: The line segment
-	void AddSide(const LineSegment& segment);
+	// Returns:
+	//	False if the collider already has ConvexPolygon::maxVertices sides, in which case the side is not added
+	bool AddSide(const LineSegment& segment);
 
 	// Check for a collision between a convex polygon and another collider
 	// Params:
@@ -84,6 +93,14 @@ public:
 	//	Whether the two colliders are colliding with each other
 	bool IsCollidingWith(const Collider& with) const override;
 
+	// Computes a world-space axis-aligned box containing the polygon, used by the broadphase
+	// Params:
+	//	min: Receives the bottom-left corner of the box
+	//	max: Receives the top-right corner of the box
+	// Returns:
+	//	Whether the collider has any sides to bound
+	bool GetBounds(Vector2D& min, Vector2D& max) const override;
+
 	// Gets the line segments of the convex collider in local space
 	// Returns:
 	//	A list with the line segments of the line collider
@@ -94,4 +111,10 @@ public:
 	//	A list with the line segments transformed to world space
 	std::vector<LineSegment> GetLineSegments() const;
 
+	// Gets the vertices and normals of the collider in world space. They are only recalculated
+	// after the transform or sides change
+	// Returns:
+	//	The world-space polygon
+	const ConvexPolygon& GetWorldPolygon() const;
+
 };
\ No newline at end of file
@@ -26,16 +26,13 @@
 
 class Vector2D;
 
-//------------------------------------------------------------------------------
-// Public Consts:
-//------------------------------------------------------------------------------
-
-const int cLineSegmentMax = 10;
-
 //------------------------------------------------------------------------------
 // Public Structures:
 //------------------------------------------------------------------------------
 
+// Line collider - Any number of line segments that points and circles are swept against.
+//   The world-space segments are kept in a bounding volume hierarchy, which is rebuilt
+//   when the collider's transform changes, so it suits lines that rarely move.
 class ColliderLine : public Collider
 {
 public:
@@ -66,13 +63,28 @@ public:
 	//	 p1 = The line segment's ending position.
 	void AddLineSegment(const Vector2D& p0, const Vector2D& p1);
 
-	// Check for collision between a line collider and another arbitrary collider.
+	// Check for collision between a line collider and a point or circle collider. The other object
+	//   is swept from its old translation to its new one, and bounced off of the first line it hits
+	//   until it stops hitting lines or the resolution limit is reached.
 	// Params:
 	//	 other = Reference to the other collider component.
 	// Returns:
 	//	 Return the results of the collision check.
 	bool IsCollidingWith(const Collider& other) const override;
 
+	// Compute a world-space axis-aligned box that contains this collider, used by the broadphase.
+	// Params:
+	//   min = Receives the bottom-left corner of the box.
+	//   max = Receives the top-right corner of the box.
+	// Returns:
+	//   True, as this collider always has finite bounds.
+	bool GetBounds(Vector2D& min, Vector2D& max) const override;
+
+	// Whether IsCollidingWith can change either object.
+	// Returns:
+	//   True if reflection is enabled, as reflected objects are moved and their velocity changed.
+	bool HasCollisionSideEffects() const override;
+
 	// Save object data to file.
 	// Params:
 	//   parser = The parser object used to save the object's data.
@@ -89,6 +101,53 @@ public:
 	LineSegment GetLineWithTransform(unsigned index) const;
 
 private:
+	//------------------------------------------------------------------------------
+	// Private Structures:
+	//------------------------------------------------------------------------------
+
+	// A node of the bounding volume hierarchy.
+	struct BVHNode
+	{
+		// The box containing every segment below the node.
+		Vector2D min;
+		Vector2D max;
+
+		// For leaves, the range of world segments in the node. For other nodes, count is 0 and
+		//   first is the index of the left child, with the right child directly after it.
+		unsigned first;
+		unsigned count;
+	};
+
+	//------------------------------------------------------------------------------
+	// Private Functions:
+	//------------------------------------------------------------------------------
+
+	// Transforms the segments into world space and rebuilds the hierarchy, if the transform or
+	//   segments have changed since the last time.
+	void UpdateWorldSegments() const;
+
+	// Builds the node for a range of world segments, splitting it in half along its longest axis until it is small enough.
+	// Params:
+	//   node = The index of the node to build.
+	//   first = The first world segment in the range.
+	//   count = How many world segments are in the range.
+	void BuildNode(unsigned node, unsigned first, unsigned count) const;
+
+	// Finds the first segment a moving point or circle hits.
+	// Params:
+	//   path = The start and end positions of the center.
+	//   radius = The radius of the circle, or 0 for a point.
+	//   intersection = Receives the center at the moment of contact.
+	//   contactLine = Receives the line the center is reflected over.
+	// Returns:
+	//   True if any segment was hit.
+	bool FindFirstIntersection(const LineSegment& path, float radius, Vector2D& intersection, LineSegment& contactLine) const;
+
+	// Orders segments by the x-coordinate of their midpoints.
+	static bool MidpointLessX(const LineSegment& a, const LineSegment& b);
+
+	// Orders segments by the y-coordinate of their midpoints.
+	static bool MidpointLessY(const LineSegment& a, const LineSegment& b);
 
 	//------------------------------------------------------------------------------
 	// Private Variables:
@@ -102,6 +161,14 @@ private:
 
 	// Should the collider perform reflection
 	bool reflection;
+
+	// The segments in world space, ordered so that each leaf of the hierarchy covers a contiguous range.
+	mutable std::vector<LineSegment> worldSegments;
+	mutable std::vector<BVHNode> nodes;
+
+	// The transform and matrix version the world segments were calculated from.
+	mutable const Transform* worldTransform;
+	mutable unsigned worldVersion;
 };
 
 //------------------------------------------------------------------------------
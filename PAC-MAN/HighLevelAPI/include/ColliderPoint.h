@@ -51,6 +51,14 @@ public:
 	// Returns:
 	//	 Return the results of the collision check.
 	bool IsCollidingWith(const Collider& other) const override;
+
+	// Compute a world-space axis-aligned box that contains this collider, used by the broadphase.
+	// Params:
+	//   min = Receives the bottom-left corner of the box.
+	//   max = Receives the top-right corner of the box.
+	// Returns:
+	//   True, as this collider always has finite bounds.
+	bool GetBounds(Vector2D& min, Vector2D& max) const override;
 };
 
 //------------------------------------------------------------------------------
@@ -17,6 +17,7 @@
 
 #include "Collider.h"
 #include "Vector2D.h"
+#include "Intersection2D.h"
 
 //------------------------------------------------------------------------------
 
@@ -75,6 +76,20 @@ public:
 	//	 Return the results of the collision check.
 	bool IsCollidingWith(const Collider& other) const override;
 
+	// Compute a world-space axis-aligned box that contains this collider, used by the broadphase.
+	// Params:
+	//   min = Receives the bottom-left corner of the box.
+	//   max = Receives the top-right corner of the box.
+	// Returns:
+	//   True, as this collider always has finite bounds.
+	bool GetBounds(Vector2D& min, Vector2D& max) const override;
+
+	// Get the world-space corners and axes of the rectangle. They are only recalculated
+	//   after the transform or extents change.
+	// Returns:
+	//	 The oriented bounding box of the rectangle.
+	const OBBShape& GetWorldShape() const;
+
 private:
 	//------------------------------------------------------------------------------
 	// Private Variables:
@@ -82,6 +97,11 @@ private:
 
 	// Extents of the rectangle collider.
 	Vector2D extents;
+
+	// The cached world-space shape, and the transform and matrix version it was calculated from.
+	mutable OBBShape worldShape;
+	mutable const Transform* worldShapeTransform;
+	mutable unsigned worldShapeVersion;
 };
 
 //------------------------------------------------------------------------------
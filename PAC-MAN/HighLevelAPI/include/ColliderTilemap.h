@@ -17,6 +17,7 @@
 
 #include "Collider.h"
 #include "Vector2D.h"
+#include <vector>
 
 //------------------------------------------------------------------------------
 
@@ -44,6 +45,8 @@ enum RectangleSide
 };
 
 // Tilemap collider class - goes on Tilemap object
+// Keeps one bit per cell of the tilemap marking whether the cell is solid, packed 64 cells to a
+//   word, so a span of cells is tested a word at a time. The bits follow edits to the tilemap.
 class ColliderTilemap : public Collider
 {
 public:
@@ -54,6 +57,9 @@ public:
 	// Constructor for Tilemap collider.
 	ColliderTilemap();
 
+	// Destructor for Tilemap collider.
+	~ColliderTilemap();
+
 	// Clone an collider and return a pointer to the cloned object.
 	// Returns:
 	//   A pointer to a collider.
@@ -62,18 +68,33 @@ public:
 	// Debug drawing for colliders.
 	void Draw() override;
 
-	// Check for collision between a tilemap and another arbitrary collider.
+	// Check for collision between a tilemap and a point, circle, or rectangle collider.
+	//   Objects with physics are swept from their old translation to their new one, and stopped
+	//   at the first solid tile crossed on each axis.
 	// Params:
 	//	 other = Reference to the second collider component.
 	// Returns:
 	//	 Return the results of the collision check.
 	bool IsCollidingWith(const Collider& other) const override;
 
+	// Whether IsCollidingWith can change either object.
+	// Returns:
+	//   True, as colliding objects are moved out of solid tiles and sent map collision events.
+	bool HasCollisionSideEffects() const override;
+
 	// Sets the tilemap to use for this collider.
 	// Params:
 	//   map = A pointer to the tilemap resource.
 	void SetTilemap(const Tilemap* map);
 
+	// Checks whether any cell in a rectangle of the tilemap is solid. Cells outside the map are not solid.
+	// Params:
+	//   minColumn = The left edge of the rectangle.
+	//   minRow = The top edge of the rectangle.
+	//   maxColumn = The right edge of the rectangle.
+	//   maxRow = The bottom edge of the rectangle.
+	bool IsAreaSolid(int minColumn, int minRow, int maxColumn, int maxRow) const;
+
 private:
 	//------------------------------------------------------------------------------
 	// Private Functions:
@@ -96,6 +117,66 @@ private:
 	//   or true if there is a tile at that position.
 	bool IsCollidingAtPosition(float x, float y) const;
 
+	// Determines whether a circle overlaps a collidable cell in the tilemap.
+	// Params:
+	//   center = The center of the circle, in world coordinates.
+	//   radius = The radius of the circle, in world units.
+	bool IsCircleColliding(const Vector2D& center, float radius) const;
+
+	// Moves a box through cell space one axis at a time, stopping it at the first solid cell its
+	//   leading edge crosses. Cells the box already overlaps do not stop it.
+	// Params:
+	//   boxMin = The top-left corner of the box in cell space. Receives the corner where the box stops.
+	//   boxMax = The bottom-right corner of the box in cell space. Receives the corner where the box stops.
+	//   movement = How far to move the box, in cell space.
+	//   collisions = Receives which sides of the box were stopped, in world space.
+	// Returns:
+	//   True if the box was stopped on either axis.
+	bool SweepBox(Vector2D& boxMin, Vector2D& boxMax, const Vector2D& movement, MapCollision& collisions) const;
+
+	// Converts a point from world space to cell space, where cell (column, row) covers the unit
+	//   square from (column, row) to (column + 1, row + 1).
+	// Params:
+	//   point = The point in world space.
+	Vector2D WorldToCell(const Vector2D& point) const;
+
+	// Converts a point from cell space to world space.
+	// Params:
+	//   point = The point in cell space.
+	Vector2D CellToWorld(const Vector2D& point) const;
+
+	// Converts a world-space box to the box that contains it in cell space.
+	// Params:
+	//   center = The center of the box, in world coordinates.
+	//   extents = Half the width and height of the box, in world units.
+	//   boxMin = Receives the top-left corner of the box in cell space.
+	//   boxMax = Receives the bottom-right corner of the box in cell space.
+	void WorldToCellBox(const Vector2D& center, const Vector2D& extents, Vector2D& boxMin, Vector2D& boxMax) const;
+
+	// Checks whether a cell of the tilemap is solid. Cells outside the map are not solid.
+	// Params:
+	//   column = The column of the cell.
+	//   row = The row of the cell.
+	bool IsCellSolid(int column, int row) const;
+
+	// Reads the cells in a rectangle of the tilemap into the solid bits.
+	// Params:
+	//   minColumn = The left edge of the rectangle.
+	//   minRow = The top edge of the rectangle.
+	//   maxColumn = The right edge of the rectangle.
+	//   maxRow = The bottom edge of the rectangle.
+	void BuildSolidBits(int minColumn, int minRow, int maxColumn, int maxRow);
+
+	// Reads the changed cells of the tilemap into the solid bits.
+	// Params:
+	//   context = The tilemap collider that subscribed.
+	//   tilemap = The tilemap that changed.
+	//   minColumn = The left edge of the changed rectangle.
+	//   minRow = The top edge of the changed rectangle.
+	//   maxColumn = The right edge of the changed rectangle.
+	//   maxRow = The bottom edge of the changed rectangle.
+	static void OnTilemapChanged(void* context, const Tilemap& tilemap, int minColumn, int minRow, int maxColumn, int maxRow);
+
 	// Moves an object and sets its velocity based on where it collided with the tilemap.
 	// Params:
 	//   objectRectangle = A bounding rectangle that encompasses the object.
@@ -120,6 +201,14 @@ private:
 
 	// The tilemap
 	const Tilemap* map;
+
+	// Dimensions of the tilemap, in cells.
+	int columns;
+	int rows;
+
+	// One bit per cell, set if the cell is solid. Each row starts on a new word.
+	std::vector<unsigned long long> solidBits;
+	unsigned wordsPerRow;
 };
 
 //------------------------------------------------------------------------------
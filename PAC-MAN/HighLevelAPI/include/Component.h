@@ -46,6 +46,14 @@ public:
 	// Clones the component, returning a dynamically allocated copy.
 	virtual Component* Clone() const = 0;
 
+	// Resets the component to match a component of the same type from the object's archetype,
+	//   so a pooled object can be reused without cloning its components again.
+	// Params:
+	//   archetype = The matching component of the object's archetype.
+	// Returns:
+	//   False if the component cannot be reset in place and must be cloned again.
+	virtual bool Reset(const Component& archetype);
+
 	// Retrieve component's owner object (if any).
 	GameObject* GetOwner() const;
 };
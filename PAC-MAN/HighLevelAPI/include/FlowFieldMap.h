@@ -0,0 +1,213 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	FlowFieldMap.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "TileCoord.h"
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Forward References:
+//------------------------------------------------------------------------------
+
+class Tilemap;
+class Vector2D;
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// Flow field map - Shares breadth-first distance fields over a space's tilemap between every
+//   object heading for the same tile. Each field holds the number of steps from every tile to its
+//   target, so an object picks its next tile by comparing the costs of its neighbors. A field is
+//   built the first time its target is asked for, and kept until the map is edited or it is the
+//   least recently used field when there are too many.
+// Empty cells (value 0) are walkable. Each field may also treat one other cell value as walkable,
+//   such as a door that only some objects may pass through.
+class FlowFieldMap
+{
+public:
+	//------------------------------------------------------------------------------
+	// Public Structures:
+	//------------------------------------------------------------------------------
+
+	// How costs are measured.
+	enum Mode
+	{
+		// The number of steps through the map to the target.
+		MODE_FLOW_FIELD = 0,
+
+		// The straight-line distance to the target, ignoring walls, as in the original arcade games.
+		MODE_GREEDY,
+	};
+
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Constructor
+	FlowFieldMap();
+
+	// Destructor
+	~FlowFieldMap();
+
+	// Sets the tilemap the fields are built over, discarding every field.
+	// Params:
+	//   tilemap = The tilemap of the space's grid, or nullptr if there is none.
+	//   wrapsAround = Whether moving off one edge of the map leads onto the opposite edge.
+	void SetTilemap(const Tilemap* tilemap, bool wrapsAround);
+
+	// Sets how costs are measured.
+	void SetMode(Mode mode);
+
+	// Gets how costs are measured.
+	Mode GetMode() const;
+
+	// Gets the cost of moving from a tile to a target. Lower costs are closer.
+	//   Tiles that cannot reach the target cost more than every tile that can.
+	// Params:
+	//   target = The target, in tile space. In flow field mode the nearest walkable tile is used.
+	//   tile = The tile to move from.
+	//   doorValue = A cell value that is walkable in addition to empty cells, or -1 for none.
+	float GetCost(const Vector2D& target, const TileCoord& tile, int doorValue = -1);
+
+	// Gets the number of steps from a tile to a target through the map.
+	// Params:
+	//   target = The target tile. If it is not walkable, the nearest walkable tile is used.
+	//   tile = The tile to move from.
+	//   doorValue = A cell value that is walkable in addition to empty cells, or -1 for none.
+	// Returns:
+	//   The number of steps, or unreachable if the tile cannot reach the target.
+	unsigned GetDistance(const TileCoord& target, const TileCoord& tile, int doorValue = -1);
+
+	// Sets how many fields are kept (32 by default). Each field takes two bytes per tile of the map.
+	//   Once there are more, the least recently used are discarded.
+	// Params:
+	//   maxFields = The number of fields to keep, at least 1.
+	void SetMaxFields(size_t maxFields);
+
+	// Gets how many fields are kept before the least recently used are discarded.
+	size_t GetMaxFields() const;
+
+	// Discards every field. Call after changing cells of the tilemap.
+	void Invalidate();
+
+	// Forgets the tilemap and discards every field. Call before the tilemap is destroyed.
+	void Clear();
+
+	// Gets how many fields are kept.
+	size_t GetFieldCount() const;
+
+	// Gets how many fields have been built.
+	unsigned GetBuildCount() const;
+
+	//------------------------------------------------------------------------------
+	// Public Variables:
+	//------------------------------------------------------------------------------
+
+	// The distance of tiles that cannot reach the target.
+	static const unsigned unreachable = 0xFFFF;
+
+private:
+	//------------------------------------------------------------------------------
+	// Private Structures:
+	//------------------------------------------------------------------------------
+
+	// The distances from every tile to one target.
+	struct Field
+	{
+		TileCoord target;
+		int doorValue;
+
+		// The value of the use counter when the field was last used.
+		unsigned long long lastUsed;
+
+		// The distance from each tile, in row-major order.
+		std::vector<unsigned short> distances;
+	};
+
+	// Disable copy constructor and assignment operator
+	FlowFieldMap(const FlowFieldMap&) = delete;
+	FlowFieldMap& operator=(const FlowFieldMap&) = delete;
+
+	//------------------------------------------------------------------------------
+	// Private Functions:
+	//------------------------------------------------------------------------------
+
+	// Gets the field for a target, building it if there is none.
+	// Params:
+	//   target = The target tile.
+	//   doorValue = A cell value that is walkable in addition to empty cells, or -1 for none.
+	const Field& GetField(const TileCoord& target, int doorValue);
+
+	// Fills out the distances of a field with a breadth-first search from its target.
+	// Params:
+	//   field = The field to build.
+	void BuildField(Field& field);
+
+	// Gets the tile a coordinate refers to, wrapping coordinates off the edge of the map if it wraps around.
+	// Params:
+	//   tile = The coordinate.
+	//   index = Receives the row-major index of the tile.
+	// Returns:
+	//   False if the coordinate is off the edge of a map that does not wrap around.
+	bool GetIndex(TileCoord tile, unsigned& index) const;
+
+	// Checks whether a cell may be walked through.
+	// Params:
+	//   index = The row-major index of the cell.
+	//   doorValue = A cell value that is walkable in addition to empty cells, or -1 for none.
+	bool IsWalkable(unsigned index, int doorValue) const;
+
+	// Discards every field when cells of the tilemap change.
+	// Params:
+	//   context = The flow field map that subscribed.
+	//   tilemap = The tilemap that changed.
+	//   minColumn = The left edge of the changed rectangle.
+	//   minRow = The top edge of the changed rectangle.
+	//   maxColumn = The right edge of the changed rectangle.
+	//   maxRow = The bottom edge of the changed rectangle.
+	static void OnTilemapChanged(void* context, const Tilemap& tilemap, int minColumn, int minRow, int maxColumn, int maxRow);
+
+	//------------------------------------------------------------------------------
+	// Private Variables:
+	//------------------------------------------------------------------------------
+
+	// The map the fields are built over.
+	const Tilemap* tilemap;
+	bool wrapsAround;
+	int width;
+	int height;
+
+	Mode mode;
+
+	// Fields in use, and discarded fields kept so their storage can be reused.
+	std::vector<Field*> fields;
+	std::vector<Field*> freeFields;
+
+	// The queue of the breadth-first search, kept between builds.
+	std::vector<unsigned> queue;
+
+	// How many fields are kept, and a counter advanced on every use to find the least recently used.
+	size_t maxFields;
+	unsigned long long useCounter;
+
+	// Statistics
+	unsigned buildCount;
+};
+
+//------------------------------------------------------------------------------
@@ -17,6 +17,7 @@
 
 #include <BetaObject.h>
 #include "Serializable.h"
+#include "GameObjectHandle.h"
 
 //------------------------------------------------------------------------------
 
@@ -26,6 +27,7 @@
 
 class Component;
 class Space;
+class GameObjectManager;
 
 //------------------------------------------------------------------------------
 // Public Structures:
@@ -89,13 +91,33 @@ public:
 	//  A pointer to the component if it exists, nullptr otherwise.
 	Component* GetComponent(const std::string& name);
 
-	// Retrieves the component with the given type if it exists.
+	// Retrieves the component with the given type if it exists. Base classes are
+	//   resolved the first time they are requested and cached by type ID after that.
 	// Template params:
 	//  ComponentType = The type of component to retrieve.
 	// Returns:
 	//  A pointer to the component if it exists, nullptr otherwise.
 	template<class ComponentType> 
 	ComponentType* GetComponent()
+	{
+		// Check if this type has already been looked up.
+		const unsigned typeId = GetComponentTypeId<ComponentType>();
+		if (typeId < componentCache.size() && componentCache[typeId].resolved)
+			return static_cast<ComponentType*>(componentCache[typeId].component);
+
+		// Remember the result, even if nothing was found.
+		ComponentType* component = FindComponent<ComponentType>();
+		CacheComponent(typeId, component);
+		return component;
+	}
+
+	// Searches the components for one of the given type, without using or filling the cache.
+	// Template params:
+	//  ComponentType = The type of component to retrieve.
+	// Returns:
+	//  A pointer to the component if it exists, nullptr otherwise.
+	template<class ComponentType>
+	ComponentType* FindComponent() const
 	{
 		// Loop through every component and check if it can be cast to the specified type.
 		for (auto it = components.begin(); it != components.end(); it++)
@@ -119,7 +141,65 @@ public:
 	// Get the space that contains this object.
 	Space* GetSpace() const;
 
+	// Sets the tags of the object, a bitmask that lets groups of objects be found quickly.
+	// Params:
+	//   tags = The new tags.
+	void SetTags(unsigned tags);
+
+	// Gets the tags of the object.
+	unsigned GetTags() const;
+
+	// Whether the object has every one of the given tags.
+	// Params:
+	//   tags = The tags to check for.
+	bool HasTags(unsigned tags) const;
+
+	// Gets a handle to the object that can be kept across frames, or a null handle if the object is not active.
+	GameObjectHandle GetHandle() const;
+
 private:
+	// The object manager keeps its name and tag indices up to date through the private variables below.
+	friend class GameObjectManager;
+
+	//------------------------------------------------------------------------------
+	// Private Structures:
+	//------------------------------------------------------------------------------
+
+	// The result of looking up a component type.
+	struct CachedComponent
+	{
+		Component* component;
+		bool resolved;
+	};
+
+	//------------------------------------------------------------------------------
+	// Private Functions:
+	//------------------------------------------------------------------------------
+
+	// Gets a unique ID for a component type, assigned the first time the type is looked up.
+	// Template params:
+	//  ComponentType = The type of component.
+	template<class ComponentType>
+	static unsigned GetComponentTypeId()
+	{
+		static const unsigned typeId = NextComponentTypeId();
+		return typeId;
+	}
+
+	// Gets the next unused component type ID.
+	static unsigned NextComponentTypeId();
+
+	// Stores the result of looking up a component type.
+	// Params:
+	//   typeId = The ID of the component type.
+	//   component = The component found for the type, or nullptr if there was none.
+	void CacheComponent(unsigned typeId, Component* component);
+
+	// Resets a pooled object to match the archetype it was cloned from.
+	// Params:
+	//   archetype = The object's archetype.
+	void Reset(const GameObject& archetype);
+
 	//------------------------------------------------------------------------------
 	// Private Variables:
 	//------------------------------------------------------------------------------
@@ -127,8 +207,24 @@ private:
 	// Components
 	std::vector<Component*> components;
 
+	// Results of component lookups by type, indexed by component type ID.
+	std::vector<CachedComponent> componentCache;
+
 	// Whether the object has been marked for destruction.
 	bool isDestroyed;
+
+	// Bitmask of the groups the object belongs to.
+	unsigned tags;
+
+	// The object manager whose active list contains the object, and the ID it interned the object's name as.
+	GameObjectManager* manager;
+	unsigned nameId;
+
+	// The handle the object manager assigned the object while it is active.
+	GameObjectHandle handle;
+
+	// The archetype of the pool the object returns to when it is destroyed, or nullptr if it is not pooled.
+	const GameObject* archetype;
 };
 
 //------------------------------------------------------------------------------
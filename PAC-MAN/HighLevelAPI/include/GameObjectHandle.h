@@ -0,0 +1,77 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	GameObjectHandle.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// Game object handle - A 32-bit reference to an active game object, made of a slot index and
+//   the generation of that slot. Handles can be kept across frames: once the object leaves the
+//   active list, the slot's generation changes and the handle no longer resolves.
+class GameObjectHandle
+{
+public:
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Constructor - creates a null handle, which never resolves to an object.
+	GameObjectHandle();
+
+	// Whether this is the null handle.
+	bool IsNull() const;
+
+	// Compares two handles.
+	bool operator==(const GameObjectHandle& other) const;
+	bool operator!=(const GameObjectHandle& other) const;
+
+private:
+	// The object manager creates and resolves handles.
+	friend class GameObjectManager;
+
+	//------------------------------------------------------------------------------
+	// Private Functions:
+	//------------------------------------------------------------------------------
+
+	// Constructor
+	// Params:
+	//   index = The index of the object manager's slot.
+	//   generation = The generation of the slot. Must not be 0.
+	GameObjectHandle(unsigned index, unsigned generation);
+
+	// Gets the index of the object manager's slot.
+	unsigned GetIndex() const;
+
+	// Gets the generation of the slot.
+	unsigned GetGeneration() const;
+
+	//------------------------------------------------------------------------------
+	// Private Variables:
+	//------------------------------------------------------------------------------
+
+	// The low bits store the index and the high bits store the generation. The index bits limit
+	//   an object manager to 2^20 (about a million) objects with handles at a time.
+	static const unsigned indexBits = 20;
+	static const unsigned indexMask = (1u << indexBits) - 1;
+	static const unsigned generationMask = (1u << (32 - indexBits)) - 1;
+
+	unsigned value;
+};
+
+//------------------------------------------------------------------------------
@@ -17,7 +17,9 @@
 
 #include <BetaObject.h>
 #include "GameObject.h"
+#include "Broadphase.h"
 #include <vector>
+#include <unordered_map>
 
 //------------------------------------------------------------------------------
 
@@ -27,6 +29,8 @@
 
 class Space;
 class Vector2D;
+class Collider;
+class PhysicsStorage;
 
 //------------------------------------------------------------------------------
 // Public Structures:
@@ -37,6 +41,21 @@ class Vector2D;
 class GameObjectManager : public BetaObject
 {
 public:
+	//------------------------------------------------------------------------------
+	// Public Structures:
+	//------------------------------------------------------------------------------
+
+	// Statistics for an archetype's object pool.
+	struct PoolStats
+	{
+		// How many created objects were reused from the pool, and how many had to be cloned.
+		unsigned hits;
+		unsigned misses;
+
+		// How many objects are waiting in the pool.
+		size_t available;
+	};
+
 	//------------------------------------------------------------------------------
 	// Public Functions:
 	//------------------------------------------------------------------------------
@@ -58,11 +77,17 @@ public:
 	// Unload the game object manager, destroying all object archetypes.
 	void Unload(void) override;
 
-	// Add a game object to the active game object list.
+	// Add a game object to the active game object list. Objects added while the manager is updating
+	//   are queued, and join the list (and are initialized) together once the objects have updated.
 	// Params:
 	//	 gameObject = Reference to the game object to be added to the list.
 	void AddObject(GameObject& gameObject);
 
+	// Reserves room for the given number of active objects, so adding them does not reallocate the object lists.
+	// Params:
+	//   objectCount = How many active objects to make room for.
+	void Reserve(size_t objectCount);
+
 	// Add a game object to the game object archetype list.
 	// Params:
 	//	 gameObject = Reference to the game object to be added to the list.
@@ -77,6 +102,13 @@ public:
 	//	   else return nullptr.
 	GameObject* GetObjectByName(const std::string& objectName) const;
 
+	// Returns the object a handle refers to.
+	// Params:
+	//	 handle = The handle of the object.
+	// Returns:
+	//   The object, or nullptr if the handle is null, the object has left the active list, or it has been destroyed.
+	GameObject* GetObjectByHandle(GameObjectHandle handle) const;
+
 	// Fills out a vector of game object pointers with all game objects matching the specified name. Does NOT clear the vector beforehand.
 	// Params:
 	//	 objectName = The name of the object to be returned, if found.
@@ -85,6 +117,25 @@ public:
 	//   The number of game objects found.
 	size_t GetAllObjectsByName(const std::string& objectName, std::vector<GameObject*>& objectList) const;
 
+	// Creates a game object from the named archetype, reusing a destroyed object from the archetype's pool if there is one.
+	//   The object still needs to be added with AddObject, and returns to the pool when it is destroyed.
+	// Params:
+	//   archetypeName = The name of the archetype to create the object from.
+	// Returns:
+	//   The new object, or nullptr if there is no archetype with the given name.
+	GameObject* CreateObject(const std::string& archetypeName);
+
+	// Clones objects into the named archetype's pool until it holds the given number of objects.
+	// Params:
+	//   archetypeName = The name of the archetype to fill the pool of.
+	//   count = How many objects the pool should hold.
+	void WarmPool(const std::string& archetypeName, size_t count);
+
+	// Returns the statistics of the named archetype's pool.
+	// Params:
+	//   archetypeName = The name of the archetype.
+	PoolStats GetPoolStats(const std::string& archetypeName) const;
+
 	// Returns a pointer to the first game object archetype matching the specified name.
 	// Params:
 	//	 objectName = The name of the archetype to be returned, if found.
@@ -99,7 +150,92 @@ public:
 	//   objectName = The name of the objects that should be counted.
 	unsigned GetObjectCount(const std::string& objectName) const;
 
+	// Fills out a vector of game object pointers with all game objects that have every one of the specified tags. Does NOT clear the vector beforehand.
+	// Params:
+	//   tags = The tags the objects must have. Must not be 0.
+	//   objectList = A reference to a vector of game object pointers which will be filled with the found game objects.
+	// Returns:
+	//   The number of game objects found.
+	size_t GetAllObjectsWithTags(unsigned tags, std::vector<GameObject*>& objectList) const;
+
+	// Replaces the broadphase used to find potentially colliding pairs.
+	// Params:
+	//   broadphase = The new broadphase. The object manager takes ownership of it.
+	void SetBroadphase(Broadphase* broadphase);
+
+	// Returns the broadphase used to find potentially colliding pairs.
+	Broadphase* GetBroadphase() const;
+
+	// Sets whether removing destroyed objects keeps the remaining objects in order.
+	//   Unordered removal is cheaper, but changes the order objects are updated and drawn in.
+	// Params:
+	//   ordered = Whether destruction should keep objects in order (the default).
+	void SetOrderedDestruction(bool ordered);
+
+	// Sets how many destroyed objects are deleted each frame. Destroyed objects are always
+	//   removed from the active list right away, but deleting them can be spread across frames.
+	// Params:
+	//   objectsPerFrame = The maximum number of objects to delete per frame, or 0 to delete them immediately (the default).
+	void SetReclaimBudget(unsigned objectsPerFrame);
+
+	// Sets whether the transforms and physics components of active objects are kept in contiguous
+	//   arrays and integrated in a single sweep. Must be called while there are no active objects.
+	// Params:
+	//   enabled = Whether to use physics storage (off by default).
+	void SetPhysicsStorage(bool enabled);
+
+	// Returns the physics storage of active objects, or nullptr if it is not in use.
+	PhysicsStorage* GetPhysicsStorage() const;
+
+	// Sets whether the narrowphase tests candidate pairs across the thread pool or on the main thread.
+	//   Events are sent in pair order either way, so both give the same contacts and events.
+	// Params:
+	//   parallel = Whether to use the thread pool (the default).
+	void SetParallelNarrowphase(bool parallel);
+
 private:
+	// Game objects notify the manager when they are destroyed or their tags change.
+	friend class GameObject;
+
+	// The outcome of testing a candidate pair in the narrowphase.
+	enum PairResult
+	{
+		PAIR_SEPARATE = 0,
+		PAIR_TOUCHING,
+
+		// The test has side effects, so it is run on the main thread while events are sent.
+		PAIR_DEFERRED,
+	};
+
+	// Objects that share a name, in the order they were added.
+	struct NameBucket
+	{
+		std::vector<GameObject*> objects;
+
+		// How many of the objects have not been destroyed.
+		unsigned liveCount;
+	};
+
+	// The object a handle index refers to. The generation changes whenever the object leaves the active list.
+	struct HandleSlot
+	{
+		GameObject* object;
+		unsigned generation;
+	};
+
+	// Objects that can be reused instead of cloning an archetype.
+	struct ObjectPool
+	{
+		// Constructor
+		ObjectPool();
+
+		std::vector<GameObject*> objects;
+
+		// Statistics
+		unsigned hits;
+		unsigned misses;
+	};
+
 	// Disable copy constructor and assignment operator
 	GameObjectManager(const GameObjectManager&) = delete;
 	GameObjectManager& operator=(const GameObjectManager&) = delete;
@@ -113,11 +249,93 @@ private:
 	// Destroy any objects marked for destruction.
 	void DestroyObjects();
 
+	// Delete destroyed objects that are waiting to be reclaimed.
+	// Params:
+	//   maxObjects = The maximum number of objects to delete.
+	void ReclaimObjects(size_t maxObjects);
+
+	// Returns an object to its archetype's pool, or deletes it if it does not belong to one.
+	// Params:
+	//   gameObject = The object being released. It must not be in the active list.
+	void ReleaseObject(GameObject* gameObject);
+
 	// Draw all game objects in the active game object list.
 	void Draw(void) override;
 
 	// Check for collisions between each pair of objects
 	void CheckCollisions();
+
+	// Tests one batch of candidate pairs, writing each pair's result to its own slot. Called by the thread pool.
+	// Params:
+	//   context = The object manager.
+	//   begin = The first pair in the batch.
+	//   end = One past the last pair in the batch.
+	static void NarrowphaseBatch(void* context, size_t begin, size_t end);
+
+	// Stop tracking collisions for colliders whose objects are about to be deleted.
+	// Params:
+	//   colliders = The colliders being removed.
+	void RemoveColliders(std::vector<const Collider*>& colliders);
+
+	// Pair of colliders that were touching during a collision step, in the order they were tested.
+	typedef std::pair<Collider*, Collider*> CollisionContact;
+
+	// Make a key that identifies a contact regardless of the order of its colliders.
+	static std::pair<const Collider*, const Collider*> GetContactKey(const Collider* first, const Collider* second);
+
+	// Returns the ID of a name, assigning a new one if the name has not been seen before.
+	// Params:
+	//   objectName = The name to intern.
+	unsigned InternName(const std::string& objectName);
+
+	// Returns the bucket of objects with the given name, or nullptr if the name has never been added.
+	// Params:
+	//   objectName = The name to look up.
+	const NameBucket* FindNameBucket(const std::string& objectName) const;
+
+	// Adds an object to the active list and its indices, without initializing it.
+	// Params:
+	//   gameObject = The object being added.
+	void ActivateObject(GameObject& gameObject);
+
+	// Adds every queued object to the active list, then initializes them grouped by name, so
+	//   objects cloned from the same archetype are initialized together.
+	void FlushSpawnQueue();
+
+	// Checks whether one object's name was interned before another's.
+	static bool NameIdLess(const GameObject* a, const GameObject* b);
+
+	// Assigns a handle to an object entering the active list. Once every slot index is in use,
+	//   the object is given the null handle instead.
+	// Params:
+	//   gameObject = The object being added.
+	void AllocateHandle(GameObject& gameObject);
+
+	// Invalidates the handle of an object leaving the active list.
+	// Params:
+	//   gameObject = The object being removed.
+	void FreeHandle(GameObject& gameObject);
+
+	// Called by a game object in the active list when it is marked for destruction.
+	// Params:
+	//   gameObject = The object that was destroyed.
+	void OnObjectDestroyed(GameObject& gameObject);
+
+	// Called by a game object in the active list when its tags change.
+	// Params:
+	//   gameObject = The object whose tags changed.
+	//   oldTags = The object's tags before the change.
+	void OnTagsChanged(GameObject& gameObject, unsigned oldTags);
+
+	// Removes destroyed objects from a list, keeping the rest in order.
+	// Params:
+	//   objects = The list to remove destroyed objects from.
+	static void RemoveDestroyedObjects(std::vector<GameObject*>& objects);
+
+	// Moves an object's transform and physics state out of the physics storage, if it is in use.
+	// Params:
+	//   gameObject = The object that is leaving the active list.
+	void UnbindPhysics(GameObject& gameObject);
 	
 	//------------------------------------------------------------------------------
 	// Private Variables:
@@ -125,14 +343,57 @@ private:
 	
 	// Objects
 	std::vector<GameObject*> gameObjectActiveList;
+
+	// Objects added during the update, waiting to join the active list.
+	bool isUpdating;
+	std::vector<GameObject*> spawnQueue;
+	std::vector<GameObject*> spawnBatch;
+
+	// Handles of active objects. Freed slots are reused, with a new generation.
+	std::vector<HandleSlot> handleSlots;
+	std::vector<unsigned> freeHandleSlots;
+
+	// Destruction
+	bool orderedDestruction;
+	unsigned reclaimBudget;
+	std::vector<GameObject*> destroyedObjects;
+	std::vector<GameObject*> reclaimQueue;
 	
 	// Archetypes
 	std::vector<GameObject*> gameObjectArchetypes;
+	std::unordered_map<std::string, GameObject*> archetypesByName;
+	std::unordered_map<const GameObject*, ObjectPool> objectPools;
+
+	// Interned names of active objects, and the objects with each name (indexed by name ID).
+	std::unordered_map<std::string, unsigned> nameIds;
+	std::vector<NameBucket> nameBuckets;
+
+	// Active objects with each tag, indexed by bit.
+	static const unsigned maxTags = 32;
+	std::vector<GameObject*> tagBuckets[maxTags];
 	
 	// Time
 	const float fixedUpdateDt;
 	const float maxFixedUpdateTime;
 	float timeAccumulator;
+
+	// Physics
+	PhysicsStorage* physicsStorage;
+
+	// Collisions
+	Broadphase* broadphase;
+	std::vector<BroadphaseProxy> collisionProxies;
+	std::vector<BroadphasePair> collisionPairs;
+	bool parallelNarrowphase;
+
+	// The PairResult of each candidate pair, filled in parallel by the narrowphase.
+	std::vector<unsigned char> pairResults;
+
+	// Contacts from the last collision step, and sorted keys for looking them up.
+	std::vector<CollisionContact> contacts;
+	std::vector<std::pair<const Collider*, const Collider*>> contactKeys;
+	std::vector<CollisionContact> newContacts;
+	std::vector<std::pair<const Collider*, const Collider*>> newContactKeys;
 };
 
 //------------------------------------------------------------------------------
@@ -33,6 +33,28 @@ namespace CS230
 	class Matrix2D;
 }
 
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// An oriented bounding box as its world-space corners and the two axes along its sides.
+struct OBBShape
+{
+	Vector2D corners[4];
+	Vector2D axes[2];
+};
+
+// A convex polygon as its world-space vertices and the outward normal of the side ending at each vertex.
+struct ConvexPolygon
+{
+	// The most sides a polygon can have. Convex colliders refuse to have more.
+	static const unsigned maxVertices = 16;
+
+	Vector2D vertices[maxVertices];
+	Vector2D normals[maxVertices];
+	unsigned count;
+};
+
 //------------------------------------------------------------------------------
 // Public Function Declarations:
 //------------------------------------------------------------------------------
@@ -111,6 +133,14 @@ void ApplyTransformToPoints(const CS230::Matrix2D& matrix, Vector2D* points, uns
 //   True if intersection, false otherwise.
 bool OBBOBBIntersection(const ColliderRectangle& rect1, const ColliderRectangle& rect2);
 
+// Check whether two oriented bounding boxes intersect.
+// Params:
+//  obb1 = The corners and axes of the first box.
+//	obb2 = The corners and axes of the second box.
+// Returns:
+//   True if intersection, false otherwise.
+bool OBBOBBIntersection(const OBBShape& obb1, const OBBShape& obb2);
+
 // Check whether an oriented bounding box and a point intersect.
 // Params:
 //  rect = The OBB.
@@ -137,37 +167,36 @@ void ProjectPolygon(const Vector2D& normal, const std::vector<Vector2D>& vertice
 
 // Check whether two convex polygons interact
 // Params:
-//	lineSegments1: The line segments of the first convex polygon
-//	lineSegments2: The line segments of the second convex polygon
+//	polygon1: The world-space vertices and normals of the first convex polygon
+//	polygon2: The world-space vertices and normals of the second convex polygon
 // Returns:
 //	True if intersection, false otherwise
-bool ConvexHullIntersection(const std::vector<LineSegment>& lineSegments1, const std::vector<LineSegment>& lineSegments2);
+bool ConvexHullIntersection(const ConvexPolygon& polygon1, const ConvexPolygon& polygon2);
 
-// Check whether a convex polygon interacts with a rectangle collider
+// Check whether a convex polygon interacts with an oriented bounding box
 //	Params:
-//	convexSegments: The line segments of the convex polygon
-//	extents: The extents of the rectangle
-//	rectTransform: The transformation of the extents of the rectangle
+//	polygon: The world-space vertices and normals of the convex polygon
+//	obb: The corners and axes of the box
 // Returns:
 //	True if interesction, false otherwise
-bool ConvexHullToOBBIntersection(const std::vector<LineSegment>& convexSegments, const Vector2D& extents, Transform& rectTransform);
+bool ConvexHullToOBBIntersection(const ConvexPolygon& polygon, const OBBShape& obb);
 
 // Check whether a circle is colliding with the convex collider
 //	Params:
-//	convexSegments: The line segments of the convex polygon
+//	polygon: The world-space vertices and normals of the convex polygon
 //	convexTransform: The transforma of the convex figure
 //	circle: The circle we are testing against
 // Returns:
 //	True if intersection, false otherwise
-bool ConvexHullToCircleInteresction(const std::vector<LineSegment>& convexSegments, const Transform& convexTransform, const Circle& circle);
+bool ConvexHullToCircleInteresction(const ConvexPolygon& polygon, const Transform& convexTransform, const Circle& circle);
 
 // Checks whether a point is inside a convex shape
 // Params:
 //	point: The point we are testing
-//	convexSegments: The line segments of the convex polygon
+//	polygon: The world-space vertices and normals of the convex polygon
 // Returns:
 //	True if intersection, false otherwise
-bool ConvexHullToPointIntersection(const std::vector<LineSegment>& convexSegments, const Vector2D& point);
+bool ConvexHullToPointIntersection(const ConvexPolygon& polygon, const Vector2D& point);
 
 // Check whether a moving point and line intersect.
 // Params:
@@ -179,6 +208,19 @@ bool ConvexHullToPointIntersection(const std::vector<LineSegment>& convexSegment
 //   True if intersection, false otherwise.
 bool MovingPointLineIntersection(const LineSegment& staticLine, const LineSegment& movingPoint, Vector2D& intersection, float& t);
 
+// Check whether a moving circle and line intersect, including the rounded ends of the line.
+// Params:
+//  staticLine   = Start and end of the line segment.
+//  movingCircle = Start and end positions of the circle's center.
+//  radius = The radius of the circle. A radius of zero gives the same result as MovingPointLineIntersection.
+//  intersection = The circle's center at the moment of contact, if any.
+//  t = The t value for the intersection.
+//  contactLine = A line through the intersection, parallel to the surface that was hit. Reflecting
+//    the circle's center over it bounces the circle off of the line.
+// Returns:
+//   True if intersection, false otherwise.
+bool MovingCircleLineIntersection(const LineSegment& staticLine, const LineSegment& movingCircle, float radius, Vector2D& intersection, float& t, LineSegment& contactLine);
+
 // Modifies object's position, velocity, and rotation using simple point-line reflection.
 // Params:
 //  transform = Transform of the object that is being reflected.
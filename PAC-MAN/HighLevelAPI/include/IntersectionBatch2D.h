@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	IntersectionBatch2D.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "Intersection2D.h"
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Forward References:
+//------------------------------------------------------------------------------
+
+class ColliderRectangle;
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// Circles stored as one array per field.
+struct CircleArrays
+{
+	const float* centerX;
+	const float* centerY;
+	const float* radius;
+	size_t count;
+};
+
+// Axis-aligned rectangles stored as one array per side.
+struct RectangleArrays
+{
+	const float* left;
+	const float* right;
+	const float* top;
+	const float* bottom;
+	size_t count;
+};
+
+// Oriented bounding boxes stored as one array per corner component and axis component.
+struct OBBArrays
+{
+	const float* cornerX[4];
+	const float* cornerY[4];
+	const float* axisX[2];
+	const float* axisY[2];
+	size_t count;
+};
+
+// Intersection batch - Tests one shape against many shapes stored as arrays, several at a time
+//   with SSE2 or AVX2 instructions when the processor supports them. Every instruction set
+//   gives the same result as the matching function in Intersection2D.h, bit for bit.
+class IntersectionBatch
+{
+public:
+	//------------------------------------------------------------------------------
+	// Public Structures:
+	//------------------------------------------------------------------------------
+
+	// The instructions the batch tests are run with.
+	enum InstructionSet
+	{
+		INSTRUCTIONS_SCALAR = 0,
+		INSTRUCTIONS_SSE2,
+		INSTRUCTIONS_AVX2,
+	};
+
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Gets the instructions the batch tests are run with. Defaults to the widest set the processor supports.
+	static InstructionSet GetInstructionSet();
+
+	// Sets the instructions the batch tests are run with, such as to compare them against each other.
+	// Params:
+	//   instructionSet = The instructions to use. Sets the processor does not support fall back to the widest one it does.
+	static void SetInstructionSet(InstructionSet instructionSet);
+
+	// Gets the widest instruction set the processor supports.
+	static InstructionSet GetSupportedInstructionSet();
+
+	// Check whether a circle intersects each of an array of circles.
+	// Params:
+	//   circle = The circle to test.
+	//   circles = The circles to test against.
+	//   results = Receives 1 for each circle that intersects, or 0. Must have room for circles.count values.
+	// Returns:
+	//   How many circles intersect.
+	static size_t CircleCircleIntersection(const Circle& circle, const CircleArrays& circles, unsigned char* results);
+
+	// Check whether a rectangle intersects each of an array of rectangles.
+	// Params:
+	//   rect = The rectangle to test.
+	//   rects = The rectangles to test against.
+	//   results = Receives 1 for each rectangle that intersects, or 0. Must have room for rects.count values.
+	// Returns:
+	//   How many rectangles intersect.
+	static size_t RectangleRectangleIntersection(const BoundingRectangle& rect, const RectangleArrays& rects, unsigned char* results);
+
+	// Check whether an oriented bounding box intersects each of an array of oriented bounding boxes.
+	// Params:
+	//   obb = The box to test.
+	//   obbs = The boxes to test against.
+	//   results = Receives 1 for each box that intersects, or 0. Must have room for obbs.count values.
+	// Returns:
+	//   How many boxes intersect.
+	static size_t OBBOBBIntersection(const OBBShape& obb, const OBBArrays& obbs, unsigned char* results);
+
+	// Calculates the world-space corners and axes of a rectangle collider, the same way OBBOBBIntersection does.
+	// Params:
+	//   rect = The rectangle collider.
+	//   obb = Receives the corners and axes.
+	static void GetOBBShape(const ColliderRectangle& rect, OBBShape& obb);
+
+private:
+	//------------------------------------------------------------------------------
+	// Private Functions:
+	//------------------------------------------------------------------------------
+
+	// Tests the circles in [begin, end) one at a time, returning how many intersect.
+	static size_t CircleCircleScalar(const Circle& circle, const CircleArrays& circles, size_t begin, size_t end, unsigned char* results);
+
+	// Tests the circles in [begin, end) four at a time, returning how many intersect. The range must be a multiple of four long.
+	static size_t CircleCircleSSE2(const Circle& circle, const CircleArrays& circles, size_t begin, size_t end, unsigned char* results);
+
+	// Tests the circles in [begin, end) eight at a time, returning how many intersect. The range must be a multiple of eight long.
+	static size_t CircleCircleAVX2(const Circle& circle, const CircleArrays& circles, size_t begin, size_t end, unsigned char* results);
+
+	// Tests the rectangles in [begin, end) one at a time, returning how many intersect.
+	static size_t RectangleRectangleScalar(const BoundingRectangle& rect, const RectangleArrays& rects, size_t begin, size_t end, unsigned char* results);
+
+	// Tests the rectangles in [begin, end) four at a time, returning how many intersect. The range must be a multiple of four long.
+	static size_t RectangleRectangleSSE2(const BoundingRectangle& rect, const RectangleArrays& rects, size_t begin, size_t end, unsigned char* results);
+
+	// Tests the rectangles in [begin, end) eight at a time, returning how many intersect. The range must be a multiple of eight long.
+	static size_t RectangleRectangleAVX2(const BoundingRectangle& rect, const RectangleArrays& rects, size_t begin, size_t end, unsigned char* results);
+
+	// Tests the boxes in [begin, end) one at a time, returning how many intersect.
+	static size_t OBBOBBScalar(const OBBShape& obb, const OBBArrays& obbs, size_t begin, size_t end, unsigned char* results);
+
+	// Tests the boxes in [begin, end) four at a time, returning how many intersect. The range must be a multiple of four long.
+	static size_t OBBOBBSSE2(const OBBShape& obb, const OBBArrays& obbs, size_t begin, size_t end, unsigned char* results);
+
+	// Tests the boxes in [begin, end) eight at a time, returning how many intersect. The range must be a multiple of eight long.
+	static size_t OBBOBBAVX2(const OBBShape& obb, const OBBArrays& obbs, size_t begin, size_t end, unsigned char* results);
+
+	// Checks which instruction sets the processor and operating system support.
+	static InstructionSet DetectInstructionSet();
+
+	//------------------------------------------------------------------------------
+	// Private Variables:
+	//------------------------------------------------------------------------------
+
+	// The instructions the batch tests are run with.
+	static InstructionSet instructionSet;
+};
+
+//------------------------------------------------------------------------------
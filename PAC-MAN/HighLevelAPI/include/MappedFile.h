@@ -0,0 +1,75 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	MappedFile.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <string>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// Mapped file - A read-only view of a whole file, mapped into memory so its contents
+//   can be used in place without reading or copying them.
+class MappedFile
+{
+public:
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Constructor
+	MappedFile();
+
+	// Destructor - unmaps the file if one is open.
+	~MappedFile();
+
+	// Maps a file into memory, closing the previous file if there was one.
+	// Params:
+	//   filename = The name of the file to map.
+	// Returns:
+	//   True if the file was mapped, false if it does not exist, is empty, or could not be mapped.
+	bool Open(const std::string& filename);
+
+	// Unmaps the file. Pointers to its data are no longer valid afterwards.
+	void Close();
+
+	// Gets the contents of the file, or nullptr if no file is open.
+	const unsigned char* GetData() const;
+
+	// Gets the size of the file in bytes.
+	size_t GetSize() const;
+
+private:
+	// Disable copy constructor and assignment operator
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	//------------------------------------------------------------------------------
+	// Private Variables:
+	//------------------------------------------------------------------------------
+
+	// Operating system handles of the file and its mapping
+	void* file;
+	void* mapping;
+
+	// The mapped view of the file
+	const unsigned char* data;
+	size_t size;
+};
+
+//------------------------------------------------------------------------------
@@ -25,6 +25,7 @@
 //------------------------------------------------------------------------------
 
 class Transform;
+class PhysicsStorage;
 
 //------------------------------------------------------------------------------
 // Public Structures:
@@ -41,10 +42,25 @@ public:
 	// Create a new physics component.
 	Physics();
 
+	// Copy constructor - the copy is never bound to physics storage.
+	// Params:
+	//   other = The physics component being copied.
+	Physics(const Physics& other);
+
+	// Destructor
+	~Physics();
+
 	// Clone the physics component, returning a dynamically allocated copy.
 	Component* Clone() const override;
 
-	// Initialize components.
+	// Reset the physics component to match the archetype's, so a pooled object can be reused.
+	// Params:
+	//   archetype = The matching component of the object's archetype.
+	// Returns:
+	//   True, as the physics component can always be reset.
+	bool Reset(const Component& archetype) override;
+
+	// Initialize components, moving the component's state into its space's physics storage if the space uses one.
 	void Initialize() override;
 
 	// Loads object data from a file.
@@ -62,7 +78,7 @@ public:
 	//	 dt = Change in time (in seconds) since the last game loop.
 	void Update(float dt) override;
 
-	// Update velocity and translation.
+	// Update velocity and translation. Does nothing while bound to physics storage, which integrates every body at once.
 	// Params:
 	//	 dt = Change in time (in seconds) since the last fixed update.
 	void FixedUpdate(float dt) override;
@@ -113,6 +129,9 @@ public:
 	const Vector2D& GetOldTranslation() const;
 
 private:
+	// The physics storage moves the component's state in and out of its arrays.
+	friend class PhysicsStorage;
+
 	//------------------------------------------------------------------------------
 	// Private Variables:
 	//------------------------------------------------------------------------------
@@ -137,6 +156,11 @@ private:
 
 	// Transform component
 	Transform*	transform;
+
+	// The physics storage holding the component's state while its object is active, or nullptr
+	//   if the state is stored in the variables above.
+	PhysicsStorage*	storage;
+	unsigned	slot;
 };
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,114 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	PhysicsStorage.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <Vector2D.h>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Forward References:
+//------------------------------------------------------------------------------
+
+class Transform;
+class Physics;
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// Physics storage - Keeps the state of every active transform and physics component in
+//   contiguous arrays (one per field), so bodies can be integrated in a single linear
+//   sweep instead of one virtual FixedUpdate call per object. Components bound to the
+//   storage become handles that read and write their slot.
+// References returned by the bound components' getters are invalidated when the storage grows.
+class PhysicsStorage
+{
+public:
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Constructor
+	PhysicsStorage();
+
+	// Destructor
+	~PhysicsStorage();
+
+	// Reserves room in the arrays so they do not grow during play.
+	// Params:
+	//   transformCount = How many transforms to reserve room for.
+	//   bodyCount = How many physics components to reserve room for.
+	void Reserve(size_t transformCount, size_t bodyCount);
+
+	// Moves a transform's state into the storage. Does nothing if it is already bound.
+	// Params:
+	//   transform = The transform to bind.
+	void AddTransform(Transform& transform);
+
+	// Moves a transform's state back into the component. Does nothing if it is not bound.
+	// Params:
+	//   transform = The transform to unbind.
+	void RemoveTransform(Transform& transform);
+
+	// Moves a physics component's state into the storage, binding its transform first if needed.
+	//   Does nothing if it is already bound.
+	// Params:
+	//   physics = The physics component to bind.
+	//   transform = The transform of the physics component's object.
+	void AddPhysics(Physics& physics, Transform& transform);
+
+	// Moves a physics component's state back into the component. Does nothing if it is not bound.
+	// Params:
+	//   physics = The physics component to unbind.
+	void RemovePhysics(Physics& physics);
+
+	// Updates the velocity, translation and rotation of every bound physics component.
+	// Params:
+	//	 dt = A fixed change in time, usually 1/60th of a second.
+	void Integrate(float dt);
+
+private:
+	// Bound components access their slots directly.
+	friend class Transform;
+	friend class Physics;
+
+	//------------------------------------------------------------------------------
+	// Private Variables:
+	//------------------------------------------------------------------------------
+
+	// Transforms. Slots are reused through a free list, so a transform's index never changes while it is bound.
+	std::vector<Vector2D> translations;
+	std::vector<float> rotations;
+	std::vector<Vector2D> scales;
+	std::vector<unsigned char> dirtyFlags;
+	std::vector<Transform*> transformOwners;
+	std::vector<unsigned> freeTransforms;
+
+	// Physics components. Bodies are kept packed for the integration sweep, so removing
+	//   one moves the last body into its slot.
+	std::vector<unsigned> bodyTransforms;
+	std::vector<Vector2D> velocities;
+	std::vector<float> angularVelocities;
+	std::vector<float> inverseMasses;
+	std::vector<Vector2D> forcesSums;
+	std::vector<Vector2D> accelerations;
+	std::vector<Vector2D> oldTranslations;
+	std::vector<Physics*> bodyOwners;
+};
+
+//------------------------------------------------------------------------------
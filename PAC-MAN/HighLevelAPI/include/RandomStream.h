@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	RandomStream.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// Random stream - A counter-based random number generator. The nth number of a stream is a hash of
+//   its seed, its stream id and n, so a stream gives the same numbers no matter which thread draws
+//   them or what other streams are doing. Give every object that draws in parallel its own stream.
+class RandomStream
+{
+public:
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Constructor
+	// Params:
+	//   seed = The seed shared by related streams.
+	//   stream = Which of the seed's streams to draw from.
+	RandomStream(unsigned long long seed = 0, unsigned long long stream = 0);
+
+	// Restarts the stream from its first number.
+	// Params:
+	//   seed = The seed shared by related streams.
+	//   stream = Which of the seed's streams to draw from.
+	void Seed(unsigned long long seed, unsigned long long stream = 0);
+
+	// Creates a new stream with the same seed, using the next number of this stream as its id.
+	RandomStream Split();
+
+	// Generates a random 32-bit number.
+	unsigned Next();
+
+	// Generates a random number in the interval [0, bound). Uses exactly one number of the stream.
+	// Params:
+	//   bound = One more than the highest possible number. Must not be 0.
+	unsigned NextBelow(unsigned bound);
+
+	// Generates a random number in the interval [rangeMin, rangeMax] (inclusive).
+	// Params:
+	//	 rangeMin = The lowest possible number generated.
+	//	 rangeMax = The highest possible number generated.
+	int Range(int rangeMin, int rangeMax);
+
+	// Generates a random floating-point number in the interval [rangeMin, rangeMax).
+	// Params:
+	//	 rangeMin = The lowest possible number generated.
+	//	 rangeMax = The upper limit of the numbers generated.
+	float Range(float rangeMin, float rangeMax);
+
+	// Gets the seed of the stream.
+	unsigned long long GetSeed() const;
+
+	// Gets the id of the stream.
+	unsigned long long GetStream() const;
+
+	// Gets how many numbers have been drawn, which together with the seed and id is the whole state.
+	unsigned long long GetCounter() const;
+
+	// Moves to a position in the stream, such as one saved with GetCounter for a replay.
+	// Params:
+	//   counter = How many numbers should count as already drawn.
+	void SetCounter(unsigned long long counter);
+
+private:
+	//------------------------------------------------------------------------------
+	// Private Functions:
+	//------------------------------------------------------------------------------
+
+	// Scrambles the bits of a 64-bit number (the SplitMix64 finalizer).
+	static unsigned long long Mix(unsigned long long value);
+
+	//------------------------------------------------------------------------------
+	// Private Variables:
+	//------------------------------------------------------------------------------
+
+	unsigned long long seed;
+	unsigned long long stream;
+
+	// The seed and stream id hashed together.
+	unsigned long long key;
+
+	unsigned long long counter;
+};
+
+//------------------------------------------------------------------------------
@@ -17,6 +17,9 @@
 
 #include "GameObjectManager.h"
 #include "ResourceManager.h"
+#include "TileOccupancyMap.h"
+#include "FlowFieldMap.h"
+#include "RandomStream.h"
 #include <BetaObject.h>
 
 //------------------------------------------------------------------------------
@@ -26,6 +29,7 @@
 //------------------------------------------------------------------------------
 
 class Level;
+class Tilemap;
 
 //------------------------------------------------------------------------------
 // Public Structures:
@@ -108,6 +112,32 @@ public:
 	// Returns the resource manager, which you can use to load resources.
 	ResourceManager& GetResourceManager();
 
+	// Returns the tile occupancy map, which you can use to find objects on a tile.
+	TileOccupancyMap& GetTileOccupancy();
+
+	// Returns the flow field map, which you can use to find the way to a tile.
+	FlowFieldMap& GetFlowFields();
+
+	// Returns the space's random stream. It is reseeded whenever a level starts, so a level
+	//   plays out the same way every time it is started with the same seed.
+	RandomStream& GetRandom();
+
+	// Sets the seed the random stream is reset to when a level starts, and reseeds it now.
+	// Params:
+	//   seed = The new seed.
+	void SetRandomSeed(unsigned long long seed);
+
+	// Updates the streamer of a streaming tilemap once per frame, after the objects have updated and
+	//   drawn, until the level changes or restarts. Does nothing if the whole map is in memory.
+	// Params:
+	//   tilemap = The streaming tilemap. It must be removed before it is deleted.
+	void AddStreamingTilemap(const Tilemap& tilemap);
+
+	// Stops updating the streamer of a tilemap added with AddStreamingTilemap.
+	// Params:
+	//   tilemap = The streaming tilemap.
+	void RemoveStreamingTilemap(const Tilemap& tilemap);
+
 private:
 	//------------------------------------------------------------------------------
 	// Private Functions:
@@ -124,6 +154,11 @@ private:
 	float timeScale;
 	Level* currentLevel;
 	Level* nextLevel;
+	TileOccupancyMap tileOccupancy;
+	FlowFieldMap flowFields;
+	RandomStream random;
+	unsigned long long randomSeed;
+	std::vector<const Tilemap*> streamingTilemaps;
 	GameObjectManager objectManager;
 	ResourceManager resourceManager;
 };
@@ -53,6 +53,13 @@ public:
 	// Clone the sprite, returning a dynamically allocated copy.
 	Component* Clone() const override;
 
+	// Reset the sprite to match the archetype's, so a pooled object can be reused.
+	// Params:
+	//   archetype = The matching component of the object's archetype.
+	// Returns:
+	//   True, as the sprite can always be reset.
+	bool Reset(const Component& archetype) override;
+
 	// Initialize components.
 	void Initialize();
 
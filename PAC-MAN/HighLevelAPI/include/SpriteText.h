@@ -56,6 +56,13 @@ public:
 	// Clone the sprite, returning a dynamically allocated copy.
 	Component* Clone() const override;
 
+	// Resetting only handles the base sprite's state, so this sprite is cloned again instead.
+	// Params:
+	//   archetype = The matching component of the object's archetype.
+	// Returns:
+	//   False, as the sprite cannot be reset in place.
+	bool Reset(const Component& archetype) override;
+
 	// Draw a sprite (Sprite can be textured or untextured).
 	void Draw() override;
 
@@ -16,6 +16,7 @@
 //------------------------------------------------------------------------------
 
 #include "Sprite.h"
+#include <vector>
 
 //------------------------------------------------------------------------------
 
@@ -24,6 +25,8 @@
 //------------------------------------------------------------------------------
 
 class Tilemap;
+class Mesh;
+class SpriteSource;
 
 //------------------------------------------------------------------------------
 // Public Structures:
@@ -31,6 +34,9 @@ class Tilemap;
 
 // You are free to change the contents of this structure as long as you do not
 //   change the public interface declared in the header.
+// Maps held fully in memory are baked into one mesh per square chunk of tiles, so drawing the
+//   map takes one draw call per visible chunk. Streamed maps are drawn one tile at a time.
+// Baking assumes the sprite's mesh is a quad one tile in size, as created by the resource manager.
 class SpriteTilemap : public Sprite
 {
 public:
@@ -41,9 +47,19 @@ public:
 	// Create a new sprite for use with a tilemap.
 	SpriteTilemap();
 
+	// Frees the baked meshes.
+	~SpriteTilemap();
+
 	// Clone the sprite, returning a dynamically allocated copy.
 	Component* Clone() const override;
 
+	// Resetting only handles the base sprite's state, so this sprite is cloned again instead.
+	// Params:
+	//   archetype = The matching component of the object's archetype.
+	// Returns:
+	//   False, as the sprite cannot be reset in place.
+	bool Reset(const Component& archetype) override;
+
 	// Draw a sprite (Sprite can be textured or untextured).
 	void Draw() override;
 
@@ -52,6 +68,15 @@ public:
 	//   map = A pointer to the tilemap resource.
 	void SetTilemap(const Tilemap* map);
 
+	// Marks the baked meshes covering a rectangle of tiles as out of date, so they are baked again
+	//   before they are next drawn. Call after editing cells of the tilemap.
+	// Params:
+	//   minColumn = The left edge of the edited rectangle.
+	//   minRow = The top edge of the edited rectangle.
+	//   maxColumn = The right edge of the edited rectangle.
+	//   maxRow = The bottom edge of the edited rectangle.
+	void InvalidateTiles(int minColumn, int minRow, int maxColumn, int maxRow);
+
 	// Converts a coordinate in tile space to world space.
 	// Params:
 	//   tilePos = The coordinate in tile space.
@@ -67,12 +92,83 @@ public:
 	Vector2D WorldToTile(Vector2D worldPos) const;
 
 private:
+	//------------------------------------------------------------------------------
+	// Private Structures:
+	//------------------------------------------------------------------------------
+
+	// The baked mesh of a square chunk of tiles.
+	struct BakedChunk
+	{
+		// The chunk's tiles, or nullptr if every tile is empty.
+		Mesh* mesh;
+
+		// Whether the mesh must be baked again before it is drawn.
+		bool dirty;
+	};
+
+	//------------------------------------------------------------------------------
+	// Private Constants:
+	//------------------------------------------------------------------------------
+
+	// The width and height of a chunk, in tiles.
+	static const unsigned chunkSize = 16;
+
+	//------------------------------------------------------------------------------
+	// Private Functions:
+	//------------------------------------------------------------------------------
+
+	// Draws the tiles in a rectangle with one draw call per tile.
+	// Params:
+	//   minX = The left edge of the rectangle.
+	//   minY = The top edge of the rectangle.
+	//   maxX = The right edge of the rectangle.
+	//   maxY = The bottom edge of the rectangle.
+	void DrawTiles(int minX, int minY, int maxX, int maxY);
+
+	// Draws the baked chunks overlapping a rectangle of tiles, baking any that are out of date.
+	// Params:
+	//   minX = The left edge of the rectangle.
+	//   minY = The top edge of the rectangle.
+	//   maxX = The right edge of the rectangle.
+	//   maxY = The bottom edge of the rectangle.
+	void DrawChunks(int minX, int minY, int maxX, int maxY);
+
+	// Builds the mesh of a chunk from the tilemap, with the UVs of each tile's frame.
+	// Params:
+	//   column = The column of the chunk.
+	//   row = The row of the chunk.
+	void BakeChunk(unsigned column, unsigned row);
+
+	// Frees the baked meshes of every chunk.
+	void FreeChunks();
+
+	// Marks the chunks covering the changed cells of the tilemap as out of date.
+	// Params:
+	//   context = The sprite tilemap that subscribed.
+	//   tilemap = The tilemap that changed.
+	//   minColumn = The left edge of the changed rectangle.
+	//   minRow = The top edge of the changed rectangle.
+	//   maxColumn = The right edge of the changed rectangle.
+	//   maxRow = The bottom edge of the changed rectangle.
+	static void OnTilemapChanged(void* context, const Tilemap& tilemap, int minColumn, int minRow, int maxColumn, int maxRow);
+
 	//------------------------------------------------------------------------------
 	// Private Variables:
 	//------------------------------------------------------------------------------
 
 	// The tilemap
 	const Tilemap* map;
+
+	// The values of the row being drawn.
+	std::vector<int> rowValues;
+
+	// The baked chunks in row-major order, and how many there are across and down.
+	std::vector<BakedChunk> chunks;
+	unsigned chunkColumns;
+	unsigned chunkRows;
+
+	// The sprite source the chunks were baked with.
+	const SpriteSource* bakedSource;
 };
 
 //------------------------------------------------------------------------------
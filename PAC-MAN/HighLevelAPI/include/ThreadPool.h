@@ -0,0 +1,132 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	ThreadPool.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// Thread pool - A fixed set of worker threads that split a range of indices into batches and run
+//   them in parallel with the calling thread.
+// ParallelFor must only be called from the main thread, and is not re-entrant: it must not be called
+//   from inside a job. Systems that use the pool, such as the ghost swarm and the collision narrowphase,
+//   run their jobs one after the other. A nested call asserts, and in release builds runs on the calling thread.
+class ThreadPool
+{
+public:
+	//------------------------------------------------------------------------------
+	// Public Structures:
+	//------------------------------------------------------------------------------
+
+	// A job run on one batch of indices. Jobs for different batches run at the same time, so they
+	//   must only write to state owned by their own indices.
+	// Params:
+	//   context = The pointer that was passed to ParallelFor.
+	//   begin = The first index of the batch.
+	//   end = One past the last index of the batch.
+	typedef void (*JobFunction)(void* context, size_t begin, size_t end);
+
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Runs a job over every index in [0, count), split into batches. Returns once every batch is done.
+	// Params:
+	//   count = How many indices to run the job over.
+	//   batchSize = How many indices each batch covers.
+	//   job = The job to run on each batch.
+	//   context = A pointer passed to every call of the job.
+	void ParallelFor(size_t count, size_t batchSize, JobFunction job, void* context);
+
+	// Gets how many threads run batches, including the calling thread.
+	unsigned GetThreadCount() const;
+
+	// Returns an instance of the thread pool.
+	static ThreadPool& GetInstance();
+
+private:
+	//------------------------------------------------------------------------------
+	// Private Structures:
+	//------------------------------------------------------------------------------
+
+	// A job and how it is split. Each thread copies the job when it picks it up, so a worker
+	//   that is slow to finish cannot see the fields change when the next job starts.
+	struct Job
+	{
+		JobFunction function;
+		void* context;
+		size_t count;
+		size_t batchSize;
+		size_t batchCount;
+
+		// Incremented for each job, so workers can tell new work from a spurious wakeup.
+		unsigned generation;
+	};
+
+	//------------------------------------------------------------------------------
+	// Private Functions:
+	//------------------------------------------------------------------------------
+
+	// Constructor is private to prevent accidental instantiation
+	ThreadPool();
+
+	// Destructor is private to prevent accidental destruction
+	~ThreadPool();
+
+	// Waits for work and runs batches until the pool is destroyed.
+	void WorkerThread();
+
+	// Claims and runs batches of a job until there are none left or another job has started.
+	// Params:
+	//   job = The thread's copy of the job.
+	void RunBatches(const Job& job);
+
+	//------------------------------------------------------------------------------
+	// Private Variables:
+	//------------------------------------------------------------------------------
+
+	// Worker threads. The calling thread also runs batches, so there is one fewer than the hardware has.
+	std::vector<std::thread> workers;
+
+	// Guards everything below except nextBatch and running.
+	std::mutex mutex;
+	std::condition_variable workReady;
+	std::condition_variable workDone;
+
+	// The current job.
+	Job currentJob;
+
+	// The generation of the current job in the high 32 bits and the next batch to be claimed in the low
+	//   32 bits, so a worker that wakes late for an earlier job cannot claim batches of the next one.
+	std::atomic<unsigned long long> nextBatch;
+
+	// How many batches of the current job have finished.
+	size_t finishedBatches;
+	bool quit;
+
+	// Whether a job is being run in parallel, to catch calls from inside a job.
+	std::atomic<bool> running;
+};
+
+//------------------------------------------------------------------------------
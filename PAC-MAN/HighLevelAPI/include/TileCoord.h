@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	TileCoord.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <functional>
+#include <iostream>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Forward References:
+//------------------------------------------------------------------------------
+
+class Vector2D;
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// Tile coordinate - The column and row of a tile. Unlike a Vector2D in tile space, two coordinates
+//   of the same tile always compare equal, so tiles can be used as keys in lookup tables.
+class TileCoord
+{
+public:
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Constructor - creates the coordinate of tile (0, 0).
+	TileCoord();
+
+	// Constructor
+	// Params:
+	//   x = The column of the tile.
+	//   y = The row of the tile.
+	TileCoord(int x, int y);
+
+	// Gets the tile containing a position in tile space.
+	// Params:
+	//   tileSpace = The position in tile space.
+	// Returns:
+	//   The tile whose column and row are the position rounded down.
+	static TileCoord Floor(const Vector2D& tileSpace);
+
+	// Converts the coordinate to a position in tile space.
+	Vector2D ToVector2D() const;
+
+	// Adds two coordinates.
+	TileCoord operator+(const TileCoord& other) const;
+
+	// Compares two coordinates.
+	bool operator==(const TileCoord& other) const;
+	bool operator!=(const TileCoord& other) const;
+
+	//------------------------------------------------------------------------------
+	// Public Variables:
+	//------------------------------------------------------------------------------
+
+	int x;
+	int y;
+};
+
+// Writes a coordinate in the same format as a Vector2D, "{ x, y }".
+std::ostream& operator<<(std::ostream& os, const TileCoord& tile);
+
+// Reads a coordinate written in the same format as a Vector2D, "{ x, y }".
+std::istream& operator>>(std::istream& is, TileCoord& tile);
+
+// Hashing, so coordinates can be used as keys in unordered containers.
+namespace std
+{
+	template <>
+	struct hash<TileCoord>
+	{
+		size_t operator()(const TileCoord& tile) const;
+	};
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,119 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	TileOccupancyMap.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <unordered_map>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Forward References:
+//------------------------------------------------------------------------------
+
+class GameObject;
+class SpriteTilemap;
+class Vector2D;
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// Tile occupancy map - Tracks which objects are standing on each tile of a space's grid,
+//   so objects on a tile can be found without scanning the object list.
+class TileOccupancyMap
+{
+public:
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Constructor
+	TileOccupancyMap();
+
+	// Sets the sprite tilemap used to convert world positions into tiles.
+	// Params:
+	//   spriteTilemap = The sprite tilemap of the space's grid, or nullptr if there is none.
+	void SetSpriteTilemap(const SpriteTilemap* spriteTilemap);
+
+	// Gets the sprite tilemap used to convert world positions into tiles.
+	const SpriteTilemap* GetSpriteTilemap() const;
+
+	// Converts a world position to the nearest tile coordinate.
+	// Params:
+	//   worldPosition = The position in world space.
+	//   x = Receives the column of the tile.
+	//   y = Receives the row of the tile.
+	// Returns:
+	//   False if there is no sprite tilemap to convert with.
+	bool WorldToTile(const Vector2D& worldPosition, int& x, int& y) const;
+
+	// Places an object on a tile, moving it off of its previous tile if it had one.
+	// Params:
+	//   object = The object being placed.
+	//   x = The column of the tile.
+	//   y = The row of the tile.
+	void Place(GameObject& object, int x, int y);
+
+	// Removes an object from the tile it is on. Does nothing if the object has not been placed.
+	// Params:
+	//   object = The object being removed.
+	void Remove(GameObject& object);
+
+	// Gets the tile an object was placed on.
+	// Params:
+	//   object = The object to look up.
+	//   x = Receives the column of the tile.
+	//   y = Receives the row of the tile.
+	// Returns:
+	//   False if the object has not been placed.
+	bool GetTile(const GameObject& object, int& x, int& y) const;
+
+	// Fills out a vector with every object on a tile, skipping destroyed objects. Does NOT clear the vector beforehand.
+	// Params:
+	//   x = The column of the tile.
+	//   y = The row of the tile.
+	//   objectList = A reference to a vector of game object pointers which will be filled with the found game objects.
+	// Returns:
+	//   The number of game objects found.
+	size_t GetObjectsAt(int x, int y, std::vector<GameObject*>& objectList) const;
+
+	// Removes every object from the map.
+	void Clear();
+
+private:
+	//------------------------------------------------------------------------------
+	// Private Functions:
+	//------------------------------------------------------------------------------
+
+	// Packs a tile coordinate into a hash key.
+	static long long TileKey(int x, int y);
+
+	//------------------------------------------------------------------------------
+	// Private Variables:
+	//------------------------------------------------------------------------------
+
+	// Used for converting world positions to tiles.
+	const SpriteTilemap* spriteTilemap;
+
+	// The objects on each occupied tile.
+	std::unordered_map<long long, std::vector<GameObject*>> tiles;
+
+	// The tile each placed object is on.
+	std::unordered_map<const GameObject*, long long> objectTiles;
+};
+
+//------------------------------------------------------------------------------
@@ -16,6 +16,7 @@
 //------------------------------------------------------------------------------
 
 #include "Vector2D.h"
+#include <vector>
 
 //------------------------------------------------------------------------------
 
@@ -24,16 +25,41 @@
 //------------------------------------------------------------------------------
 
 class Matrix2D;
+class MappedFile;
+class TilemapStreamer;
+class Tilemap;
 
 //------------------------------------------------------------------------------
 // Public Structures:
 //------------------------------------------------------------------------------
 
+// Called when changed cells of a tilemap are flushed.
+// Params:
+//   context = The pointer that was passed to Subscribe.
+//   tilemap = The tilemap that changed.
+//   minColumn = The left edge of the rectangle containing every changed cell.
+//   minRow = The top edge of the rectangle.
+//   maxColumn = The right edge of the rectangle.
+//   maxRow = The bottom edge of the rectangle.
+typedef void(*TilemapChangeHandler)(void* context, const Tilemap& tilemap,
+	int minColumn, int minRow, int maxColumn, int maxRow);
+
 // You are free to change the contents of this structure as long as you do not
 //   change the public interface declared in the header.
 class Tilemap
 {
 public:
+	//------------------------------------------------------------------------------
+	// Public Enums:
+	//------------------------------------------------------------------------------
+
+	// How each cell is stored. The smallest format that fits every value in the map is used.
+	enum CellFormat
+	{
+		CELL_UINT8 = 0,
+		CELL_UINT16,
+	};
+
 	//------------------------------------------------------------------------------
 	// Public Functions:
 	//------------------------------------------------------------------------------
@@ -42,7 +68,8 @@ public:
 	// Params:
 	//   numColumns = The width of the map.
 	//   numRows = The height of the map.
-	//   data = The array containing the map data.
+	//   data = The array containing the map data, indexed by [column][row]. Values must be between 0 and 65535.
+	//     The tilemap copies the values into its own storage and deletes the array.
 	Tilemap(unsigned numColumns, unsigned numRows, int** data);
 
 	// Destructor.
@@ -63,16 +90,191 @@ public:
 	//   or a positive integer otherwise.
 	int GetCellValue(unsigned column, unsigned row) const;
 
-	// Create a tilemap from the given file.
+	// Sets the value of the cell in the map with the given indices, and adds it to the changed region.
+	//   Cells of a mapped binary file are copied into the tilemap's own storage first, and 8-bit cells
+	//   are widened if the value does not fit.
+	// Params:
+	//   column = The column of the cell.
+	//   row = The row of the cell.
+	//   value = The new value, between 0 and 65535.
+	// Returns:
+	//   False if the indices or the value are invalid, or the map is streamed.
+	bool SetCellValue(unsigned column, unsigned row, int value);
+
+	// Gets the rectangle containing every cell changed since the last flush.
+	// Params:
+	//   minColumn = Receives the left edge of the rectangle.
+	//   minRow = Receives the top edge of the rectangle.
+	//   maxColumn = Receives the right edge of the rectangle.
+	//   maxRow = Receives the bottom edge of the rectangle.
+	// Returns:
+	//   False if no cells have changed.
+	bool GetChangedRegion(int& minColumn, int& minRow, int& maxColumn, int& maxRow) const;
+
+	// Passes the changed region to every subscriber and clears it. Does nothing if no cells have
+	//   changed. Call once per frame, before the subscribers' caches are used.
+	void FlushChanges();
+
+	// Registers a function to call with the changed region whenever changes are flushed.
+	// Params:
+	//   handler = The function to call.
+	//   context = A pointer passed to the function, usually the subscriber.
+	void Subscribe(TilemapChangeHandler handler, void* context) const;
+
+	// Removes a function registered with Subscribe. Subscribers must unsubscribe before they are destroyed.
+	//   A subscriber may unsubscribe while it is called, and the other subscribers are still called.
+	// Params:
+	//   handler = The function that was registered.
+	//   context = The pointer it was registered with.
+	void Unsubscribe(TilemapChangeHandler handler, void* context) const;
+
+	// Gets how the cells of the map are stored.
+	CellFormat GetCellFormat() const;
+
+	// Gets the cells of a row of a map stored with 8-bit cells.
+	// Params:
+	//   row = The row to get.
+	// Returns:
+	//   A pointer to the first of GetWidth() cells, or nullptr if the row is invalid, the map uses
+	//   another format, or the map is streamed.
+	const unsigned char* GetRow8(unsigned row) const;
+
+	// Gets the cells of a row of a map stored with 16-bit cells.
+	// Params:
+	//   row = The row to get.
+	// Returns:
+	//   A pointer to the first of GetWidth() cells, or nullptr if the row is invalid, the map uses
+	//   another format, or the map is streamed.
+	const unsigned short* GetRow16(unsigned row) const;
+
+	// Copies the values of consecutive cells in a row, regardless of how the map is stored.
+	// Params:
+	//   column = The column of the first cell.
+	//   row = The row of the cells.
+	//   count = How many cells to copy.
+	//   values = The array to copy the values into. Must have room for count values.
+	// Returns:
+	//   The number of values copied, which is less than count if the span runs past the end of the row.
+	unsigned GetSpan(unsigned column, unsigned row, unsigned count, int* values) const;
+
+	// Create a tilemap from the given file. If a binary copy of the file (with the .tmb extension)
+	//   exists and is not older than the text file, it is loaded instead of the text file.
 	// Params:
 	//   filename = The name of the file containing the tilemap data.
 	static Tilemap* CreateTilemapFromFile(const std::string& filename);
 
+	// Create a tilemap from the given file like the function above, but stream it in chunks with
+	//   CreateStreamingTilemap if it has too many cells to keep in memory. Add the tilemap to its space
+	//   with Space::AddStreamingTilemap either way, which does nothing if it is not streamed.
+	// Params:
+	//   filename = The name of the file containing the tilemap data.
+	//   streamingCellCount = The number of cells from which the tilemap is streamed.
+	// Returns:
+	//   The tilemap, or nullptr if the file could not be loaded.
+	static Tilemap* CreateTilemapFromFile(const std::string& filename, size_t streamingCellCount);
+
+	// Create a tilemap from a binary tilemap file. The file is mapped into memory and its cells are used
+	//   in place, so the file stays open for as long as the tilemap exists.
+	// Params:
+	//   filename = The name of the binary tilemap file.
+	// Returns:
+	//   The tilemap, or nullptr if the file does not exist or is not a valid binary tilemap.
+	static Tilemap* CreateTilemapFromBinaryFile(const std::string& filename);
+
+	// Saves the tilemap as a binary tilemap file.
+	// Params:
+	//   filename = The name of the file to write.
+	// Returns:
+	//   True if the file was written, false if it could not be or the map is streamed.
+	bool WriteBinaryFile(const std::string& filename) const;
+
+	// Converts a text tilemap file to a binary one with the same name and the .tmb extension.
+	// Params:
+	//   filename = The name of the text tilemap file.
+	// Returns:
+	//   True if the binary file was written, false otherwise.
+	static bool ConvertToBinaryFile(const std::string& filename);
+
+	// Create a tilemap that streams its cells from the binary copy of a tilemap file (with the .tmb
+	//   extension) in chunks, for maps too large to keep in memory. The chunks near the camera and
+	//   moving objects are kept loaded; see TilemapStreamer. If the text file is newer than the binary
+	//   copy, the binary copy is converted again first. Add the tilemap to its space with
+	//   Space::AddStreamingTilemap, so its streamer is updated every frame.
+	// Params:
+	//   filename = The name of the file containing the tilemap data.
+	//   chunkSize = The width and height of each chunk, in tiles.
+	//   maxResidentChunks = How many chunks may stay in memory at once.
+	// Returns:
+	//   The tilemap, or nullptr if the binary file does not exist or is not valid.
+	static Tilemap* CreateStreamingTilemap(const std::string& filename, unsigned chunkSize = 32, size_t maxResidentChunks = 256);
+
+	// Gets the streamer that loads the cells of a streaming tilemap.
+	// Returns:
+	//   The streamer, or nullptr if the whole map is in memory.
+	TilemapStreamer* GetStreamer() const;
+
 private:
+	// The streamer reads binary tilemap headers.
+	friend class TilemapStreamer;
+
+	//------------------------------------------------------------------------------
+	// Private Structures:
+	//------------------------------------------------------------------------------
+
+	// The start of a binary tilemap file. All values are little-endian.
+	struct BinaryHeader
+	{
+		// Always "TMB" followed by 0x1A.
+		char magic[4];
+
+		// The version of the format, currently 1.
+		unsigned short version;
+
+		// The size of each cell in bytes, either 1 or 2.
+		unsigned short cellWidth;
+
+		// Dimensions of the map
+		unsigned width;
+		unsigned height;
+
+		// The number of entries in the layer table, which follows the header. If there is no
+		//   table, the cells of the only layer follow the header instead.
+		unsigned layerCount;
+
+		// Reserved for future versions, must be 0.
+		unsigned reserved;
+	};
+
+	// A function registered with Subscribe.
+	struct Subscriber
+	{
+		TilemapChangeHandler handler;
+		void* context;
+	};
+
+	// An entry in the layer table of a binary tilemap file. Each layer has width * height cells.
+	struct BinaryLayer
+	{
+		// The offset of the layer's cells from the start of the file. Must be a multiple of the cell width.
+		unsigned offset;
+
+		// An identifier for the layer, chosen by whoever wrote the file.
+		unsigned id;
+	};
+
+	// Disable copy constructor and assignment operator
+	Tilemap(const Tilemap&) = delete;
+	Tilemap& operator=(const Tilemap&) = delete;
+
 	//------------------------------------------------------------------------------
 	// Private Functions:
 	//------------------------------------------------------------------------------
 
+	// Create a tilemap from a text tilemap file.
+	// Params:
+	//   filename = The name of the file containing the tilemap data.
+	static Tilemap* CreateTilemapFromTextFile(const std::string& filename);
+
 	// Helper function for reading in values of integers.
 	// Params:
 	//   file = The file stream to read from.
@@ -88,10 +290,74 @@ private:
 	//   name = The text to look for before reading the array.
 	//   columns = The number of columns in the array.
 	//   rows = The number of rows in the array.
+	//   values = The vector to fill with the values, in row-major order.
 	// Returns:
-	//   A pointer to the dynamically allocated array if the data is valid, nullptr otherwise.
-	static int** ReadArrayVariable(std::ifstream& file, const std::string& name, 
-		unsigned columns, unsigned rows);
+	//   True if the data is valid, false otherwise.
+	static bool ReadArrayVariable(std::ifstream& file, const std::string& name,
+		unsigned columns, unsigned rows, std::vector<int>& values);
+
+	// Create a tilemap from values in row-major order.
+	// Params:
+	//   numColumns = The width of the map.
+	//   numRows = The height of the map.
+	//   values = The values of the cells. Values must be between 0 and 65535.
+	Tilemap(unsigned numColumns, unsigned numRows, const std::vector<int>& values);
+
+	// Stores the values of the cells in the smallest format that fits them.
+	// Params:
+	//   values = The values of the cells in row-major order.
+	void SetCells(const std::vector<int>& values);
+
+	// Checks whether a subscriber unsubscribed during a flush.
+	static bool IsUnsubscribed(const Subscriber& subscriber);
+
+	// Reads and verifies the header of a binary tilemap file.
+	// Params:
+	//   data = The start of the file.
+	//   dataSize = How many bytes of the file are in data.
+	//   fileSize = The size of the whole file in bytes.
+	//   header = Receives the header.
+	//   cellOffset = Receives the offset of the first layer's cells from the start of the file.
+	// Returns:
+	//   True if the header is valid and every cell of the first layer is inside the file, false otherwise.
+	static bool ReadBinaryHeader(const unsigned char* data, size_t dataSize, size_t fileSize, BinaryHeader& header, size_t& cellOffset);
+
+	// Gets the name of the binary copy of a tilemap file.
+	// Params:
+	//   filename = The name of the tilemap file.
+	// Returns:
+	//   The name with its extension replaced by .tmb.
+	static std::string GetBinaryFilename(const std::string& filename);
+
+	// Checks whether the binary copy of a tilemap file exists and is at least as new as the text file.
+	// Params:
+	//   filename = The name of the text tilemap file.
+	// Returns:
+	//   True if the binary copy exists, and the text file does not exist or was not modified after it.
+	static bool IsBinaryFileCurrent(const std::string& filename);
+
+	// Reads the size of a tilemap without loading its cells, from the binary copy if it is current.
+	// Params:
+	//   filename = The name of the text tilemap file.
+	//   width = Receives the number of columns.
+	//   height = Receives the number of rows.
+	// Returns:
+	//   True if the size was read, false if neither file has a valid header.
+	static bool ReadFileSize(const std::string& filename, unsigned& width, unsigned& height);
+
+	// Create a tilemap whose cells are stored in a mapped file.
+	// Params:
+	//   numColumns = The width of the map.
+	//   numRows = The height of the map.
+	//   cellFormat = How the cells are stored.
+	//   cells = The first cell in the mapped file.
+	//   mappedFile = The mapped file. The tilemap takes ownership of it.
+	Tilemap(unsigned numColumns, unsigned numRows, CellFormat cellFormat, const unsigned char* cells, MappedFile* mappedFile);
+
+	// Create a tilemap whose cells are loaded by a streamer.
+	// Params:
+	//   streamer = The opened streamer. The tilemap takes ownership of it.
+	Tilemap(TilemapStreamer* streamer);
 
 	//------------------------------------------------------------------------------
 	// Private Variables:
@@ -101,11 +367,35 @@ private:
 	unsigned numColumns;
 	unsigned numRows;
 
-	// The map data (a 2D array)
-	int** data;
+	// The map data, in row-major order, either in the tilemap's own storage or in a mapped file.
+	CellFormat cellFormat;
+	const unsigned char* cells;
+	std::vector<unsigned char> ownedCells;
+	MappedFile* mappedFile;
+
+	// Loads the cells of a streaming tilemap, in which case cells is nullptr.
+	TilemapStreamer* streamer;
+
+	// The rectangle containing every cell changed since the last flush.
+	bool hasChanges;
+	int changedMinColumn;
+	int changedMinRow;
+	int changedMaxColumn;
+	int changedMaxRow;
+
+	// Subscribing does not change the map, so const users of the map may subscribe.
+	mutable std::vector<Subscriber> subscribers;
+
+	// Whether subscribers are being called. Subscribers that unsubscribe meanwhile have their handler
+	//   cleared instead of being erased, and are removed once every subscriber has been called.
+	mutable bool flushing;
 
 	// Relative path for tilemaps
 	static std::string mapPath;
+
+	// Identifies binary tilemap files and the version of the format this code reads and writes.
+	static const char binaryMagic[4];
+	static const unsigned short binaryVersion = 1;
 };
 
 //------------------------------------------------------------------------------
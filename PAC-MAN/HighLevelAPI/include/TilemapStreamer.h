@@ -0,0 +1,196 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	TilemapStreamer.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// Tilemap streamer - Keeps only part of a binary tilemap file in memory, split into square chunks.
+//   Chunks near the focus points (the camera and moving objects) are loaded on a background thread
+//   ahead of time, and the least recently used chunks are evicted once there are too many.
+//   A chunk that is needed before it has been streamed in is read immediately.
+// Every function except the loader thread's must be called from the main thread.
+class TilemapStreamer
+{
+public:
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Constructor
+	// Params:
+	//   chunkSize = The width and height of each chunk, in tiles.
+	//   maxResidentChunks = How many chunks may stay in memory before the least recently used are evicted.
+	TilemapStreamer(unsigned chunkSize, size_t maxResidentChunks);
+
+	// Destructor - stops the loader thread and frees every chunk.
+	~TilemapStreamer();
+
+	// Opens a binary tilemap file and starts the loader thread.
+	// Params:
+	//   filename = The name of the binary tilemap file.
+	// Returns:
+	//   True if the file is a valid binary tilemap, false otherwise.
+	bool Open(const std::string& filename);
+
+	// Gets the width of the map (in tiles).
+	unsigned GetWidth() const;
+
+	// Gets the height of the map (in tiles).
+	unsigned GetHeight() const;
+
+	// Gets the size of each cell in bytes, either 1 or 2.
+	unsigned GetCellWidth() const;
+
+	// Gets the value of a cell, reading its chunk from the file if it is not in memory.
+	// Params:
+	//   column = The column of the cell. Must be less than the width.
+	//   row = The row of the cell. Must be less than the height.
+	int GetCellValue(unsigned column, unsigned row);
+
+	// Copies the values of consecutive cells in a row.
+	// Params:
+	//   column = The column of the first cell.
+	//   row = The row of the cells. Must be less than the height.
+	//   count = How many cells to copy. The span must not run past the end of the row.
+	//   values = The array to copy the values into.
+	void GetSpan(unsigned column, unsigned row, unsigned count, int* values);
+
+	// Requests every chunk overlapping a rectangle of tiles for the next update. Focus is cleared after each update.
+	// Params:
+	//   minColumn = The left edge of the rectangle.
+	//   minRow = The top edge of the rectangle.
+	//   maxColumn = The right edge of the rectangle.
+	//   maxRow = The bottom edge of the rectangle.
+	void AddFocus(int minColumn, int minRow, int maxColumn, int maxRow);
+
+	// Keeps chunks in the focus loaded, starts streaming any that are missing, takes in the chunks
+	//   the loader thread has finished, and evicts chunks until the budget is met. Call once per frame,
+	//   usually by adding the tilemap to its space with Space::AddStreamingTilemap.
+	void Update();
+
+	// Gets how many chunks are in memory.
+	size_t GetResidentChunkCount() const;
+
+	// Gets how many chunks had to be read immediately because they were needed before being streamed in.
+	unsigned GetMissCount() const;
+
+private:
+	//------------------------------------------------------------------------------
+	// Private Structures:
+	//------------------------------------------------------------------------------
+
+	// The cells of one chunk, row-major with a stride of the chunk size.
+	struct Chunk
+	{
+		std::vector<unsigned char> cells;
+
+		// The last frame the chunk was used or in focus.
+		unsigned lastUsed;
+	};
+
+	// Where a chunk is.
+	enum ChunkState
+	{
+		CHUNK_ABSENT = 0,
+		CHUNK_REQUESTED,
+		CHUNK_RESIDENT,
+	};
+
+	// Disable copy constructor and assignment operator
+	TilemapStreamer(const TilemapStreamer&) = delete;
+	TilemapStreamer& operator=(const TilemapStreamer&) = delete;
+
+	//------------------------------------------------------------------------------
+	// Private Functions:
+	//------------------------------------------------------------------------------
+
+	// Reads a chunk from the file.
+	// Params:
+	//   file = The file to read from. The main thread and the loader thread each use their own.
+	//   chunkIndex = The index of the chunk.
+	// Returns:
+	//   The new chunk.
+	Chunk* ReadChunk(std::ifstream& file, unsigned chunkIndex) const;
+
+	// Gets a chunk, reading it from the file if it is not in memory.
+	// Params:
+	//   chunkIndex = The index of the chunk.
+	Chunk* GetChunk(unsigned chunkIndex);
+
+	// Stores a chunk that is now in memory.
+	// Params:
+	//   chunkIndex = The index of the chunk.
+	//   chunk = The chunk.
+	void AddChunk(unsigned chunkIndex, Chunk* chunk);
+
+	// Reads requested chunks until the streamer is destroyed.
+	void LoaderThread();
+
+	//------------------------------------------------------------------------------
+	// Private Variables:
+	//------------------------------------------------------------------------------
+
+	// Layout of the map in the file
+	std::string filename;
+	unsigned width;
+	unsigned height;
+	unsigned cellWidth;
+	size_t cellOffset;
+
+	// Chunks, indexed by (chunk row * chunk columns + chunk column)
+	const unsigned chunkSize;
+	unsigned chunkColumns;
+	unsigned chunkRows;
+	std::vector<Chunk*> chunks;
+	std::vector<unsigned char> chunkStates;
+	std::vector<unsigned> residentChunks;
+
+	// Scratch list of (last used frame, chunk index), reused for each eviction pass
+	std::vector<std::pair<unsigned, unsigned>> evictionOrder;
+
+	// Budget and statistics
+	const size_t maxResidentChunks;
+	unsigned frame;
+	unsigned missCount;
+
+	// Chunks in focus since the last update
+	std::vector<unsigned> focusChunks;
+
+	// The file used for chunks that are needed immediately
+	std::ifstream file;
+
+	// Communication with the loader thread, protected by the mutex
+	std::thread loader;
+	std::mutex mutex;
+	std::condition_variable condition;
+	std::deque<unsigned> requests;
+	std::vector<std::pair<unsigned, Chunk*>> loadedChunks;
+	bool stopping;
+};
+
+//------------------------------------------------------------------------------
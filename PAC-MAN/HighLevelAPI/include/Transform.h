@@ -21,6 +21,14 @@
 
 //------------------------------------------------------------------------------
 
+//------------------------------------------------------------------------------
+// Forward References:
+//------------------------------------------------------------------------------
+
+class PhysicsStorage;
+
+//------------------------------------------------------------------------------
+
 //------------------------------------------------------------------------------
 // Public Structures:
 //------------------------------------------------------------------------------
@@ -48,9 +56,27 @@ public:
 	//   rotation	 = Rotation of the object about the z-axis.
 	Transform(Vector2D translation = Vector2D(), Vector2D scale = Vector2D(1,1), float rotation = 0);
 
+	// Copy constructor - the copy is never bound to physics storage.
+	// Params:
+	//   other = The transform being copied.
+	Transform(const Transform& other);
+
+	// Destructor
+	~Transform();
+
 	// Clone the transform, returning a dynamically allocated copy.
 	Component* Clone() const override;
 
+	// Reset the transform to match the archetype's, so a pooled object can be reused.
+	// Params:
+	//   archetype = The matching component of the object's archetype.
+	// Returns:
+	//   True, as the transform can always be reset.
+	bool Reset(const Component& archetype) override;
+
+	// Moves the transform's state into its space's physics storage, if the space uses one.
+	void Initialize() override;
+
 	// Loads object data from a file.
 	// Params:
 	//   parser = The parser for the file.
@@ -71,6 +97,12 @@ public:
 	//	 A reference to the component's inverse matrix.
 	const CS230::Matrix2D& GetInverseMatrix();
 
+	// Gets a number that changes whenever the transform matrix is recalculated, so geometry
+	//   built from the matrix can be cached until the transform changes.
+	// Returns:
+	//	 The version of the current matrix.
+	unsigned GetMatrixVersion();
+
 	// Set the translation of a transform component.
 	// Params:
 	//	 translation = Reference to a translation vector.
@@ -102,6 +134,9 @@ public:
 	const Vector2D& GetScale() const;
 
 private:
+	// The physics storage moves the transform's state in and out of its arrays.
+	friend class PhysicsStorage;
+
 	//------------------------------------------------------------------------------
 	// Private Functions:
 	//------------------------------------------------------------------------------
@@ -130,6 +165,14 @@ private:
 
 	// True if the transformation matrix needs to be recalculated.
 	bool	isDirty;
+
+	// Incremented each time the transformation matrix is recalculated.
+	unsigned	matrixVersion;
+
+	// The physics storage holding the transform's state while its object is active, or nullptr
+	//   if the state is stored in the variables above.
+	PhysicsStorage*	storage;
+	unsigned	slot;
 };
 
 //------------------------------------------------------------------------------
@@ -50,6 +50,28 @@ Component* Animation::Clone() const
 	return new Animation(*this);
 }
 
+// Reset the animation to match the archetype's, so a pooled object can be reused.
+// Params:
+//   archetype = The matching component of the object's archetype.
+// Returns:
+//   True, as the animation can always be reset.
+bool Animation::Reset(const Component& archetype)
+{
+	const Animation& other = static_cast<const Animation&>(archetype);
+
+	// The sprite is found again when the object is initialized.
+	frameIndex = other.frameIndex;
+	frameCount = other.frameCount;
+	frameStart = other.frameStart;
+	frameDelay = other.frameDelay;
+	frameDuration = other.frameDuration;
+	isRunning = other.isRunning;
+	isLooping = other.isLooping;
+	isDone = other.isDone;
+
+	return true;
+}
+
 // Initialize components.
 void Animation::Initialize()
 {
@@ -0,0 +1,82 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	Broadphase.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "Broadphase.h"
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// Constructor
+// Params:
+//   collider = The collider this proxy represents.
+BroadphaseProxy::BroadphaseProxy(Collider* collider) : collider(collider), bounded(false)
+{
+}
+
+// Constructor
+// Params:
+//   first = The index of the first proxy.
+//   second = The index of the second proxy (always greater than first).
+BroadphasePair::BroadphasePair(unsigned first, unsigned second) : first(first), second(second)
+{
+}
+
+// Orders pairs the same way a nested loop over the proxy list would visit them.
+bool BroadphasePair::operator<(const BroadphasePair& other) const
+{
+	if (first != other.first)
+		return first < other.first;
+
+	return second < other.second;
+}
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// Destructor
+Broadphase::~Broadphase()
+{
+}
+
+// Forgets a collider that is leaving the simulation. Broadphases that keep state
+//   between steps must drop it here, as the collider's memory may be reused.
+// Params:
+//   collider = The collider being removed.
+void Broadphase::RemoveCollider(const Collider& collider)
+{
+	UNREFERENCED_PARAMETER(collider);
+}
+
+// Checks whether the bounds of two proxies overlap.
+// Params:
+//   a = The first proxy.
+//   b = The second proxy.
+// Returns:
+//   True if either proxy is unbounded or their bounds overlap.
+bool Broadphase::BoundsOverlap(const BroadphaseProxy& a, const BroadphaseProxy& b)
+{
+	if (!a.bounded || !b.bounded)
+		return true;
+
+	return a.min.x <= b.max.x && b.min.x <= a.max.x && a.min.y <= b.max.y && b.min.y <= a.max.y;
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,194 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	BroadphaseGrid.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "BroadphaseGrid.h"
+
+// Systems
+#include <algorithm>
+#include <cmath>
+
+// Components
+#include "Collider.h"
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// Constructor
+// Params:
+//   cellSize = The width and height of each grid cell in world units.
+//   maxCellsPerProxy = Colliders covering more cells than this are treated as unbounded.
+BroadphaseGrid::BroadphaseGrid(float cellSize, unsigned maxCellsPerProxy) : cellSize(cellSize), maxCellsPerProxy(maxCellsPerProxy)
+{
+}
+
+// Finds every pair of proxies that might be colliding.
+// Params:
+//   proxies = The colliders taking part in this collision step, in object list order.
+//   pairs = The list that will be filled with candidate pairs, sorted by (first, second).
+void BroadphaseGrid::FindPairs(const std::vector<BroadphaseProxy>& proxies, std::vector<BroadphasePair>& pairs)
+{
+	// Empty the buckets used last step without releasing their memory.
+	for (auto it = usedCells.begin(); it != usedCells.end(); ++it)
+		it->second->clear();
+
+	// Drop stale buckets if the objects have moved far away from them.
+	if (cells.size() > 4 * usedCells.size() + 256)
+	{
+		for (auto it = cells.begin(); it != cells.end();)
+		{
+			if (it->second.empty())
+				it = cells.erase(it);
+			else
+				++it;
+		}
+	}
+
+	usedCells.clear();
+	unboundedProxies.clear();
+	ranges.resize(proxies.size());
+
+	// Insert every proxy into the cells its bounds cover.
+	for (unsigned i = 0; i < proxies.size(); ++i)
+	{
+		const BroadphaseProxy& proxy = proxies[i];
+		CellRange& range = ranges[i];
+
+		if (proxy.bounded)
+		{
+			range.minX = ToCell(proxy.min.x);
+			range.minY = ToCell(proxy.min.y);
+			range.maxX = ToCell(proxy.max.x);
+			range.maxY = ToCell(proxy.max.y);
+		}
+
+		// Huge and unbounded colliders are tested against everything instead.
+		if (!proxy.bounded || static_cast<long long>(range.maxX - range.minX + 1) * (range.maxY - range.minY + 1) > maxCellsPerProxy)
+		{
+			range.minX = 1;
+			range.maxX = 0;
+			unboundedProxies.push_back(i);
+			continue;
+		}
+
+		for (int y = range.minY; y <= range.maxY; ++y)
+		{
+			for (int x = range.minX; x <= range.maxX; ++x)
+			{
+				const long long key = CellKey(x, y);
+				std::vector<unsigned>& cell = cells[key];
+				if (cell.empty())
+					usedCells.push_back(std::make_pair(key, &cell));
+				cell.push_back(i);
+			}
+		}
+	}
+
+	// Pair proxies that share a cell.
+	for (auto it = usedCells.begin(); it != usedCells.end(); ++it)
+	{
+		const long long key = it->first;
+		const std::vector<unsigned>& cell = *it->second;
+
+		for (size_t a = 0; a < cell.size(); ++a)
+		{
+			const unsigned i = cell[a];
+			const CellRange& rangeA = ranges[i];
+
+			for (size_t b = a + 1; b < cell.size(); ++b)
+			{
+				const unsigned j = cell[b];
+				const CellRange& rangeB = ranges[j];
+
+				// Proxies that share several cells are only reported from the first cell they share.
+				if (CellKey(max(rangeA.minX, rangeB.minX), max(rangeA.minY, rangeB.minY)) != key)
+					continue;
+
+				// Check collision groups before the more expensive bounds test.
+				if (!proxies[i].collider->CanCollideWith(*proxies[j].collider))
+					continue;
+
+				if (BoundsOverlap(proxies[i], proxies[j]))
+					pairs.push_back(BroadphasePair(i, j));
+			}
+		}
+	}
+
+	// Pair unbounded proxies with everything else.
+	for (auto it = unboundedProxies.begin(); it != unboundedProxies.end(); ++it)
+	{
+		const unsigned i = *it;
+
+		for (unsigned j = 0; j < proxies.size(); ++j)
+		{
+			// Pairs of two unbounded proxies are only reported once.
+			if (j == i || (ranges[j].minX > ranges[j].maxX && j < i))
+				continue;
+
+			if (!proxies[i].collider->CanCollideWith(*proxies[j].collider))
+				continue;
+
+			pairs.push_back(BroadphasePair(min(i, j), max(i, j)));
+		}
+	}
+
+	// Dispatch pairs in the same order as a nested loop over the object list.
+	std::sort(pairs.begin(), pairs.end());
+}
+
+// Sets the size of the grid cells.
+// Params:
+//   cellSize = The width and height of each grid cell in world units.
+void BroadphaseGrid::SetCellSize(float cellSize_)
+{
+	cellSize = cellSize_;
+	cells.clear();
+	usedCells.clear();
+}
+
+// Gets the size of the grid cells.
+float BroadphaseGrid::GetCellSize() const
+{
+	return cellSize;
+}
+
+//------------------------------------------------------------------------------
+// Private Functions:
+//------------------------------------------------------------------------------
+
+// Converts a world coordinate to a cell coordinate.
+int BroadphaseGrid::ToCell(float coordinate) const
+{
+	// Clamp so that far away objects cannot overflow the cell coordinates.
+	float cell = floor(coordinate / cellSize);
+	cell = max(-1.0e9f, min(cell, 1.0e9f));
+	return static_cast<int>(cell);
+}
+
+// Packs a pair of cell coordinates into a hash key.
+long long BroadphaseGrid::CellKey(int x, int y)
+{
+	return static_cast<long long>((static_cast<unsigned long long>(static_cast<unsigned>(x)) << 32) | static_cast<unsigned>(y));
+}
+
+//------------------------------------------------------------------------------
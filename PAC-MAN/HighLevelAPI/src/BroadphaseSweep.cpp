@@ -0,0 +1,239 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	BroadphaseSweep.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "BroadphaseSweep.h"
+
+// Systems
+#include <cfloat>
+
+// Components
+#include "Collider.h"
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// Constructor
+BroadphaseSweep::BroadphaseSweep() : hasRemovedProxies(false), currentStep(0)
+{
+}
+
+// Finds every pair of proxies that might be colliding.
+// Params:
+//   proxies = The colliders taking part in this collision step, in object list order.
+//   pairs = The list that will be filled with candidate pairs, sorted by (first, second).
+void BroadphaseSweep::FindPairs(const std::vector<BroadphaseProxy>& proxies, std::vector<BroadphasePair>& pairs)
+{
+	++currentStep;
+
+	if (hasRemovedProxies)
+		RemoveDeadProxies();
+
+	// Match this step's proxies with the ones tracked from previous steps.
+	newEndpoints.clear();
+	for (unsigned i = 0; i < proxies.size(); ++i)
+	{
+		const Collider* collider = proxies[i].collider;
+		auto found = proxyLookup.find(collider);
+
+		unsigned slot;
+		if (found != proxyLookup.end())
+		{
+			slot = found->second;
+		}
+		else
+		{
+			// Start tracking a new collider.
+			if (freeProxies.empty())
+			{
+				slot = static_cast<unsigned>(sweepProxies.size());
+				sweepProxies.push_back(SweepProxy());
+			}
+			else
+			{
+				slot = freeProxies.back();
+				freeProxies.pop_back();
+			}
+
+			proxyLookup[collider] = slot;
+			sweepProxies[slot].collider = collider;
+			sweepProxies[slot].removed = false;
+
+			// New endpoints are merged into the sorted list once the existing ones have been repaired.
+			Endpoint endpoint = { GetEndpointValue(proxies[i], true), slot, true };
+			newEndpoints.push_back(endpoint);
+			endpoint.value = GetEndpointValue(proxies[i], false);
+			endpoint.isMin = false;
+			newEndpoints.push_back(endpoint);
+		}
+
+		sweepProxies[slot].index = i;
+		sweepProxies[slot].step = currentStep;
+	}
+
+	// Refresh the endpoint values. Proxies that were not seen this step keep their old values.
+	for (auto it = endpoints.begin(); it != endpoints.end(); ++it)
+	{
+		const SweepProxy& sweepProxy = sweepProxies[it->proxy];
+		if (sweepProxy.step != currentStep)
+			continue;
+
+		it->value = GetEndpointValue(proxies[sweepProxy.index], it->isMin);
+	}
+
+	// Repair the sort order. The endpoints were sorted last step, so very few need to move.
+	for (size_t i = 1; i < endpoints.size(); ++i)
+	{
+		Endpoint endpoint = endpoints[i];
+		size_t j = i;
+		while (j > 0 && EndpointLess(endpoint, endpoints[j - 1]))
+		{
+			endpoints[j] = endpoints[j - 1];
+			--j;
+		}
+		endpoints[j] = endpoint;
+	}
+
+	// Sort the endpoints of new proxies on their own and merge them in, instead of moving each one
+	//   across the whole list, so the first step and mass spawns stay O(n log n).
+	if (!newEndpoints.empty())
+	{
+		std::sort(newEndpoints.begin(), newEndpoints.end(), EndpointLess);
+		const size_t oldCount = endpoints.size();
+		endpoints.insert(endpoints.end(), newEndpoints.begin(), newEndpoints.end());
+		std::inplace_merge(endpoints.begin(), endpoints.begin() + oldCount, endpoints.end(), EndpointLess);
+	}
+
+	// Sweep along the x-axis, pairing each proxy with every interval that is open when it starts.
+	activeProxies.clear();
+	for (auto it = endpoints.begin(); it != endpoints.end(); ++it)
+	{
+		const SweepProxy& sweepProxy = sweepProxies[it->proxy];
+		if (sweepProxy.step != currentStep)
+			continue;
+
+		if (it->isMin)
+		{
+			const BroadphaseProxy& proxy = proxies[sweepProxy.index];
+
+			for (auto active = activeProxies.begin(); active != activeProxies.end(); ++active)
+			{
+				const unsigned otherIndex = sweepProxies[*active].index;
+				const BroadphaseProxy& other = proxies[otherIndex];
+
+				// Check collision groups before the bounds test on the other axis.
+				if (!proxy.collider->CanCollideWith(*other.collider))
+					continue;
+
+				if (BoundsOverlap(proxy, other))
+					pairs.push_back(BroadphasePair(min(sweepProxy.index, otherIndex), max(sweepProxy.index, otherIndex)));
+			}
+
+			activeProxies.push_back(it->proxy);
+		}
+		else
+		{
+			// Close this proxy's interval.
+			for (auto active = activeProxies.begin(); active != activeProxies.end(); ++active)
+			{
+				if (*active == it->proxy)
+				{
+					*active = activeProxies.back();
+					activeProxies.pop_back();
+					break;
+				}
+			}
+		}
+	}
+
+	// Dispatch pairs in the same order as a nested loop over the object list.
+	std::sort(pairs.begin(), pairs.end());
+}
+
+// Forgets a collider that is leaving the simulation.
+// Params:
+//   collider = The collider being removed.
+void BroadphaseSweep::RemoveCollider(const Collider& collider)
+{
+	auto found = proxyLookup.find(&collider);
+	if (found == proxyLookup.end())
+		return;
+
+	// The endpoints are discarded in one pass at the start of the next step.
+	sweepProxies[found->second].removed = true;
+	proxyLookup.erase(found);
+	hasRemovedProxies = true;
+}
+
+//------------------------------------------------------------------------------
+// Private Functions:
+//------------------------------------------------------------------------------
+
+// Discards the endpoints of removed proxies and recycles their slots.
+void BroadphaseSweep::RemoveDeadProxies()
+{
+	size_t count = 0;
+	for (size_t i = 0; i < endpoints.size(); ++i)
+	{
+		if (!sweepProxies[endpoints[i].proxy].removed)
+			endpoints[count++] = endpoints[i];
+	}
+	endpoints.resize(count);
+
+	for (unsigned i = 0; i < sweepProxies.size(); ++i)
+	{
+		if (sweepProxies[i].removed)
+		{
+			sweepProxies[i].removed = false;
+			sweepProxies[i].collider = nullptr;
+			sweepProxies[i].step = 0;
+			freeProxies.push_back(i);
+		}
+	}
+
+	hasRemovedProxies = false;
+}
+
+// Gets the position of one end of a proxy's interval on the x-axis.
+// Params:
+//   proxy = The proxy.
+//   isMin = Whether to get the start of the interval instead of the end.
+float BroadphaseSweep::GetEndpointValue(const BroadphaseProxy& proxy, bool isMin)
+{
+	if (proxy.bounded)
+		return isMin ? proxy.min.x : proxy.max.x;
+
+	return isMin ? -FLT_MAX : FLT_MAX;
+}
+
+// Checks whether one endpoint must be sorted before another.
+bool BroadphaseSweep::EndpointLess(const Endpoint& a, const Endpoint& b)
+{
+	// Intervals that only touch are still considered overlapping, so starts come before ends.
+	if (a.value != b.value)
+		return a.value < b.value;
+
+	return a.isMin && !b.isMin;
+}
+
+//------------------------------------------------------------------------------
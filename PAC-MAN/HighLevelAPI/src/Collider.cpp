@@ -53,7 +53,8 @@ MapCollision::MapCollision(bool bottom, bool top, bool left, bool right) : botto
 // Params:
 //   owner = Reference to the object that owns this component.
 Collider::Collider(ColliderType type) : Component("Collider"), transform(nullptr), physics(nullptr),
-	group(0), mask(DEFAULT_MASK), type(type), handler(nullptr)
+	group(0), mask(DEFAULT_MASK), type(type), handler(nullptr), enterHandler(nullptr), stayHandler(nullptr),
+	exitHandler(nullptr), mapHandler(nullptr)
 {
 }
 
@@ -86,21 +87,86 @@ void Collider::Serialize(Parser& parser) const
 // Check if two objects are colliding and send collision events.
 // Params:
 //	 other = Reference to the second collider component.
-void Collider::CheckCollision(const Collider& other)
+//   wasColliding = Whether the two colliders were touching during the previous step.
+// Returns:
+//   Whether the two colliders are touching.
+bool Collider::CheckCollision(const Collider& other, bool wasColliding)
 {
 	// Check collision groups
-	if (!((1ull << group) & other.mask) || !((1ull << other.group) & mask))
-		return;
+	if (!CanCollideWith(other))
+		return false;
 
 	// Check if the two colliders are colliding.
-	if (IsCollidingWith(other))
-	{
-		// Run collision event handlers if they exist.
-		if (handler != nullptr)
-			handler(*GetOwner(), *other.GetOwner());
-		if (other.handler != nullptr)
-			other.handler(*other.GetOwner(), *GetOwner());
-	}
+	if (!IsCollidingWith(other))
+		return false;
+
+	SendCollisionEvents(other, wasColliding);
+
+	return true;
+}
+
+// Send collision events to two colliders that are touching.
+// Params:
+//	 other = Reference to the second collider component.
+//   wasColliding = Whether the two colliders were touching during the previous step.
+void Collider::SendCollisionEvents(const Collider& other, bool wasColliding) const
+{
+	// Run collision event handlers if they exist.
+	if (handler != nullptr)
+		handler(*GetOwner(), *other.GetOwner());
+	if (other.handler != nullptr)
+		other.handler(*other.GetOwner(), *GetOwner());
+
+	// Run enter handlers on the first step of contact and stay handlers afterwards.
+	CollisionEventHandler stateHandler = wasColliding ? stayHandler : enterHandler;
+	CollisionEventHandler otherStateHandler = wasColliding ? other.stayHandler : other.enterHandler;
+	if (stateHandler != nullptr)
+		stateHandler(*GetOwner(), *other.GetOwner());
+	if (otherStateHandler != nullptr)
+		otherStateHandler(*other.GetOwner(), *GetOwner());
+}
+
+// Send collision exit events to two colliders that have stopped touching.
+// Params:
+//	 other = Reference to the second collider component.
+void Collider::EndCollision(const Collider& other) const
+{
+	if (exitHandler != nullptr)
+		exitHandler(*GetOwner(), *other.GetOwner());
+	if (other.exitHandler != nullptr)
+		other.exitHandler(*other.GetOwner(), *GetOwner());
+}
+
+// Check whether the collision groups and masks of two colliders allow them to collide.
+// Params:
+//	 other = Reference to the second collider component.
+// Returns:
+//   True if each collider's group is included in the other's mask.
+bool Collider::CanCollideWith(const Collider& other) const
+{
+	return ((1ull << group) & other.mask) && ((1ull << other.group) & mask);
+}
+
+// Compute a world-space axis-aligned box that contains this collider, used by the broadphase.
+// Params:
+//   min = Receives the bottom-left corner of the box.
+//   max = Receives the top-right corner of the box.
+// Returns:
+//   False if the collider has no finite bounds and must be tested against every other collider.
+bool Collider::GetBounds(Vector2D& min, Vector2D& max) const
+{
+	UNREFERENCED_PARAMETER(min);
+	UNREFERENCED_PARAMETER(max);
+	return false;
+}
+
+// Whether IsCollidingWith can change either object (for example by resolving the collision),
+//   so it must be run on the main thread in dispatch order instead of on a worker thread.
+// Returns:
+//   False, as most colliders only read state while testing.
+bool Collider::HasCollisionSideEffects() const
+{
+	return false;
 }
 
 // Get the type of this component.
@@ -117,6 +183,30 @@ void Collider::SetCollisionHandler(CollisionEventHandler handler_)
 	handler = handler_;
 }
 
+// Sets the function called on the first step this collider touches another collider.
+// Params:
+//   handler = A pointer to the collision handler function.
+void Collider::SetCollisionEnterHandler(CollisionEventHandler handler_)
+{
+	enterHandler = handler_;
+}
+
+// Sets the function called on every following step the colliders keep touching.
+// Params:
+//   handler = A pointer to the collision handler function.
+void Collider::SetCollisionStayHandler(CollisionEventHandler handler_)
+{
+	stayHandler = handler_;
+}
+
+// Sets the function called on the first step the colliders are no longer touching.
+// Params:
+//   handler = A pointer to the collision handler function.
+void Collider::SetCollisionExitHandler(CollisionEventHandler handler_)
+{
+	exitHandler = handler_;
+}
+
 // Sets the map collision handler function for the collider.
 // Params:
 //   handler = A pointer to the collision handler function.
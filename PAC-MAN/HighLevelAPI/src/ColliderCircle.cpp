@@ -26,6 +26,7 @@
 
 // Components
 #include "Transform.h"
+#include "Physics.h"
 #include "ColliderRectangle.h"
 
 //------------------------------------------------------------------------------
@@ -105,7 +106,7 @@ void ColliderCircle::SetRadius(float radius_)
 bool ColliderCircle::IsCollidingWith(const Collider& other) const
 {
 	// The translation of the other collider.
-	Vector2D otherTranslation = other.GetOwner()->GetComponent<Transform>()->GetTranslation();
+	Vector2D otherTranslation = other.transform->GetTranslation();
 
 	// The Circle for this collider.
 	Circle circle = Circle(transform->GetTranslation(), radius);
@@ -130,4 +131,30 @@ bool ColliderCircle::IsCollidingWith(const Collider& other) const
 	return other.IsCollidingWith(*this);
 }
 
+// Compute a world-space axis-aligned box that contains this collider, used by the broadphase.
+// Params:
+//   min = Receives the bottom-left corner of the box.
+//   max = Receives the top-right corner of the box.
+// Returns:
+//   True, as this collider always has finite bounds.
+bool ColliderCircle::GetBounds(Vector2D& min, Vector2D& max) const
+{
+	const Vector2D& translation = transform->GetTranslation();
+	min = translation;
+	max = translation;
+
+	// Line colliders test the path the center moved along, so include the old position.
+	if (physics != nullptr)
+	{
+		const Vector2D& oldTranslation = physics->GetOldTranslation();
+		min = Vector2D(fminf(min.x, oldTranslation.x), fminf(min.y, oldTranslation.y));
+		max = Vector2D(fmaxf(max.x, oldTranslation.x), fmaxf(max.y, oldTranslation.y));
+	}
+
+	min -= Vector2D(radius, radius);
+	max += Vector2D(radius, radius);
+
+	return true;
+}
+
 //------------------------------------------------------------------------------
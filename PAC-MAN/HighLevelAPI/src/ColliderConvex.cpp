@@ -21,6 +21,7 @@
 #include <Vector2D.h>					// Vector2D
 #include <Parser.h>						// Parser
 #include <GameObject.h>					// Game Object
+#include <cassert>						// Assert
 
 #include <DebugDraw.h>					// Debug Draw
 #include <Graphics.h>					// Graphics
@@ -32,13 +33,13 @@
 // Public Class Member Functions
 //------------------------------------------------------------------------------
 ColliderConvex::ColliderConvex()
-	: Collider(ColliderType::ColliderTypeConvex)
+	: Collider(ColliderType::ColliderTypeConvex), worldPolygonTransform(nullptr), worldPolygonVersion(0)
 {
 
 }
 
 ColliderConvex::ColliderConvex(const std::vector<LineSegment>& localLines_)
-	: Collider(ColliderType::ColliderTypeConvex), localLines()
+	: Collider(ColliderType::ColliderTypeConvex), localLines(), worldPolygonTransform(nullptr), worldPolygonVersion(0)
 {
 	// Save the vertices of the collider
 	localLines.reserve(localLines_.size());
@@ -49,7 +50,7 @@ ColliderConvex::ColliderConvex(const std::vector<LineSegment>& localLines_)
 }
 
 ColliderConvex::ColliderConvex(const LineSegment* localPoints_, size_t size)
-	: Collider(ColliderType::ColliderTypeConvex), localLines()
+	: Collider(ColliderType::ColliderTypeConvex), localLines(), worldPolygonTransform(nullptr), worldPolygonVersion(0)
 {
 	// Save the vertices of the collider
 	localLines.reserve(size);
@@ -61,7 +62,10 @@ ColliderConvex::ColliderConvex(const LineSegment* localPoints_, size_t size)
 
 Component* ColliderConvex::Clone() const
 {
-	return new ColliderConvex(*this);
+	ColliderConvex* clone = new ColliderConvex(*this);
+	// The clone will be given its own transform
+	clone->worldPolygonTransform = nullptr;
+	return clone;
 }
 
 void ColliderConvex::Serialize(Parser& parser) const
@@ -87,6 +91,9 @@ void ColliderConvex::Deserialize(Parser& parser)
 	// Read the amont of lines we've got
 	size_t lineCount;
 	parser.ReadVariable("lineCount", lineCount);
+	// The world-space polygon has room for a limited number of sides
+	if (lineCount > ConvexPolygon::maxVertices)
+		throw ParseException(GetOwner()->GetName(), "A convex collider cannot have more than " + std::to_string(ConvexPolygon::maxVertices) + " sides.");
 	// Skip over the lines variable
 	parser.ReadSkip("lines");
 	parser.ReadSkip(':');
@@ -102,6 +109,7 @@ void ColliderConvex::Deserialize(Parser& parser)
 	}
 	// Skip over the ending scope
 	parser.ReadSkip('}');
+	worldPolygonTransform = nullptr;
 }
 
 void ColliderConvex::Draw()
@@ -133,35 +141,38 @@ bool ColliderConvex::IsCollidingWith(const Collider& other) const
 	case ColliderType::ColliderTypeConvex:
 	{
 		const ColliderConvex& convex = static_cast<const ColliderConvex&>(other);
-		return ConvexHullIntersection(GetLineSegments(), convex.GetLineSegments());
+		return ConvexHullIntersection(GetWorldPolygon(), convex.GetWorldPolygon());
 	}
 	case ColliderType::ColliderTypeRectangle:
 	{
 		const ColliderRectangle& rectangle = static_cast<const ColliderRectangle&>(other);
-		Transform* rectTransform = other.GetOwner()->GetComponent<Transform>();
-		return ConvexHullToOBBIntersection(GetLineSegments(), rectangle.GetExtents(), *rectTransform);
+		return ConvexHullToOBBIntersection(GetWorldPolygon(), rectangle.GetWorldShape());
 	}
 	case ColliderType::ColliderTypeCircle:
 	{
 		const ColliderCircle& circle = static_cast<const ColliderCircle&>(other);
-		const Transform* convexTransform = GetOwner()->GetComponent<Transform>();
-		const Transform* circleTransform = other.GetOwner()->GetComponent<Transform>();
-		return ConvexHullToCircleInteresction(GetLineSegments(), *convexTransform, 
-			Circle(circleTransform->GetTranslation(), circle.GetRadius()));
+		return ConvexHullToCircleInteresction(GetWorldPolygon(), *transform, 
+			Circle(other.transform->GetTranslation(), circle.GetRadius()));
 	}
 	case ColliderType::ColliderTypePoint:
 	{
-		Transform* point = other.GetOwner()->GetComponent<Transform>();
-		return ConvexHullToPointIntersection(GetLineSegments(), point->GetTranslation());
+		return ConvexHullToPointIntersection(GetWorldPolygon(), other.transform->GetTranslation());
 	}
 	default:
 		return false;
 	}
 }
 
-void ColliderConvex::AddSide(const LineSegment& segment)
+bool ColliderConvex::AddSide(const LineSegment& segment)
 {
+	// The world-space polygon has room for a limited number of sides
+	assert(localLines.size() < ConvexPolygon::maxVertices && "A convex collider cannot have more than ConvexPolygon::maxVertices sides.");
+	if (localLines.size() >= ConvexPolygon::maxVertices)
+		return false;
+
 	localLines.push_back(LineSegment(segment));
+	worldPolygonTransform = nullptr;
+	return true;
 }
 
 const std::vector<LineSegment>& ColliderConvex::GetLocalLineSegments() const
@@ -181,4 +192,55 @@ std::vector<LineSegment> ColliderConvex::GetLineSegments() const
 	}
 
 	return transformed;
+}
+
+// Computes a world-space axis-aligned box containing the polygon, used by the broadphase
+// Params:
+//	min: Receives the bottom-left corner of the box
+//	max: Receives the top-right corner of the box
+// Returns:
+//	Whether the collider has any sides to bound
+bool ColliderConvex::GetBounds(Vector2D& min, Vector2D& max) const
+{
+	const ConvexPolygon& polygon = GetWorldPolygon();
+	if (polygon.count == 0)
+		return false;
+
+	// Every vertex is the end of one side, so only the end points need to be checked
+	min = polygon.vertices[0];
+	max = min;
+	for (unsigned i = 1; i < polygon.count; ++i)
+	{
+		const Vector2D& point = polygon.vertices[i];
+		min = Vector2D(fminf(min.x, point.x), fminf(min.y, point.y));
+		max = Vector2D(fmaxf(max.x, point.x), fmaxf(max.y, point.y));
+	}
+
+	return true;
+}
+
+// Gets the vertices and normals of the collider in world space. They are only recalculated
+// after the transform or sides change
+// Returns:
+//	The world-space polygon
+const ConvexPolygon& ColliderConvex::GetWorldPolygon() const
+{
+	const unsigned version = transform->GetMatrixVersion();
+	if (worldPolygonTransform == transform && worldPolygonVersion == version)
+		return worldPolygon;
+
+	const CS230::Matrix2D& matrix = transform->GetMatrix();
+	worldPolygon.count = static_cast<unsigned>(localLines.size());
+	for (unsigned i = 0; i < worldPolygon.count; ++i)
+	{
+		// Construct the segment in world space so its normal accounts for rotation and scale
+		LineSegment transformedSegment(matrix * localLines[i].start, matrix * localLines[i].end);
+		worldPolygon.vertices[i] = transformedSegment.end;
+		worldPolygon.normals[i] = transformedSegment.normal;
+	}
+
+	worldPolygonTransform = transform;
+	worldPolygonVersion = version;
+
+	return worldPolygon;
 }
\ No newline at end of file
@@ -27,6 +27,15 @@
 // Components
 #include "Transform.h"
 #include "Physics.h"
+#include "ColliderCircle.h"
+
+//------------------------------------------------------------------------------
+
+// The most segments a leaf of the bounding volume hierarchy holds.
+const unsigned LineLeafSize = 4;
+
+// The deepest the hierarchy can be. Halving the segments at each level keeps it far shallower.
+const unsigned LineStackSize = 64;
 
 //------------------------------------------------------------------------------
 
@@ -41,7 +50,8 @@
 // Create a new (line) collider component.
 // Params:
 //   reflection = Whether points should be reflected off this collider.
-ColliderLine::ColliderLine(bool reflection) : maxResolutions(4), Collider(ColliderTypeLines), reflection(reflection)
+ColliderLine::ColliderLine(bool reflection) : maxResolutions(4), Collider(ColliderTypeLines), reflection(reflection),
+	worldTransform(nullptr), worldVersion(0)
 {
 }
 
@@ -50,7 +60,12 @@ ColliderLine::ColliderLine(bool reflection) : maxResolutions(4), Collider(Collid
 //   A pointer to a collider.
 Component* ColliderLine::Clone() const
 {
-	return new ColliderLine(*this);
+	ColliderLine* clone = new ColliderLine(*this);
+
+	// The clone will be given its own transform.
+	clone->worldTransform = nullptr;
+
+	return clone;
 }
 
 // Debug drawing for colliders.
@@ -79,38 +94,12 @@ void ColliderLine::Draw()
 void ColliderLine::AddLineSegment(const Vector2D& p0, const Vector2D& p1)
 {
 	lineSegments.push_back(LineSegment(p0, p1));
+	worldTransform = nullptr;
 }
 
-namespace
-{
-	// Helper struct for containing intersection data.
-	struct IntersectionData
-	{
-		// Constructor
-		// Params:
-		//   index = The index of the line segment this intersection data is for.
-		//   intersection = The actual intersection point.
-		//   t = How far into the moving point's movement the collision occured.
-		//   intersected = Whether an intersection occurred.
-		IntersectionData(unsigned index = 0, Vector2D intersection = Vector2D(), float t = 0.0f, bool intersected = false) : index(index), intersection(intersection), t(t), intersected(intersected)
-		{
-		}
-
-		// The index of the line segment this intersection data is for.
-		int index;
-
-		// The actual intersection point.
-		Vector2D intersection;
-
-		// How far into the moving point's movement the collision occured.
-		float t;
-
-		// Whether an intersection occurred.
-		bool intersected;
-	};
-}
-
-// Check for collision between a line collider and another arbitrary collider.
+// Check for collision between a line collider and a point or circle collider. The other object
+//   is swept from its old translation to its new one, and bounced off of the first line it hits
+//   until it stops hitting lines or the resolution limit is reached.
 // Params:
 //	 other = Reference to the other collider component.
 // Returns:
@@ -124,16 +113,18 @@ bool ColliderLine::IsCollidingWith(const Collider& other) const
 	case ColliderTypeCircle:
 	{
 		// If the line collider has no lines, nothing can collide with it.
-		if (lineSegments.size() == 0)
+		// Only moving objects are swept, so objects without physics cannot hit the lines.
+		if (lineSegments.size() == 0 || other.physics == nullptr)
 			return false;
 
-		int resolutionCount = 0;
+		// Points are swept as circles with no radius.
+		float radius = 0.0f;
+		if (other.GetType() == ColliderTypeCircle)
+			radius = static_cast<const ColliderCircle&>(other).GetRadius();
 
-		IntersectionData* intersections = nullptr;
+		UpdateWorldSegments();
 
-		// If we have reflections, we're gonna need a list of intersections.
-		if (reflection)
-			intersections = new IntersectionData[lineSegments.size()];
+		int resolutionCount = 0;
 
 		// This is in a loop to handle multiple collisions & resolutions in a single update.
 		do
@@ -141,52 +132,22 @@ bool ColliderLine::IsCollidingWith(const Collider& other) const
 			// Create the current moving point's line segment.
 			LineSegment movingPoint(other.physics->GetOldTranslation(), other.transform->GetTranslation());
 
-			// Iterate over every line segment and check collisions on each.
-			for (unsigned i = 0; i < lineSegments.size(); i++)
-			{
-				Vector2D intersection;
-				float t;
-
-				// Clear the current intersection data for this line segment.
-				if (reflection)
-					intersections[i] = { i, Vector2D(), 0.0f, false };
-
-				// If the lines are not intersecting, skip this line segment.
-				if (!MovingPointLineIntersection(GetLineWithTransform(i), movingPoint, intersection, t))
-					continue;
-
-				if (reflection)
-					// Save the current intersction data for this line segment
-					intersections[i] = { i, intersection, t, true };
-				else
-					// If reflection is not enabled, we do not need to handle any resolutions, the event was enough.
-					return true;
-			}
-
-			// Find the first intersection, the one with the lowest t.
-			// Defaults to the first element, though if `intersected` is false it'll just ignore it.
-			IntersectionData& firstIntersection = intersections[0];
-			for (unsigned i = 0; i < lineSegments.size(); i++)
-			{
-				if (intersections[i].intersected && (intersections[i].t < firstIntersection.t || !firstIntersection.intersected))
-					firstIntersection = intersections[i];
-			}
-
-			// Handle reflection with the first intersection, if there was one.
-			if (firstIntersection.intersected)
-			{
-				MovingPointLineReflection(*other.transform, *other.physics, GetLineWithTransform(firstIntersection.index), movingPoint, firstIntersection.intersection);
-				++resolutionCount;
-			}
-			else
+			Vector2D intersection;
+			LineSegment contactLine;
+			if (!FindFirstIntersection(movingPoint, radius, intersection, contactLine))
 			{
 				// There were no intersections, so there's no point doing another loop.
 				break;
 			}
-		} while (resolutionCount < maxResolutions); // Limit the number of resolutions for performance reasons.
 
-		// Delete the dynamically allocated intersections.
-		delete[] intersections;
+			// If reflection is not enabled, we do not need to handle any resolutions, the event was enough.
+			if (!reflection)
+				return true;
+
+			// Handle reflection with the first intersection.
+			MovingPointLineReflection(*other.transform, *other.physics, contactLine, movingPoint, intersection);
+			++resolutionCount;
+		} while (resolutionCount < maxResolutions); // Limit the number of resolutions for performance reasons.
 
 		return resolutionCount > 0;
 	}
@@ -234,6 +195,8 @@ void ColliderLine::Deserialize(Parser & parser)
 		lineSegments.push_back(lineSegment);
 	}
 	parser.ReadSkip("}");
+
+	worldTransform = nullptr;
 }
 
 // Gets a line segment that incorporates the transform of the object
@@ -249,4 +212,181 @@ LineSegment ColliderLine::GetLineWithTransform(unsigned index) const
 
 // sage was here :)
 
+// Compute a world-space axis-aligned box that contains this collider, used by the broadphase.
+// Params:
+//   min = Receives the bottom-left corner of the box.
+//   max = Receives the top-right corner of the box.
+// Returns:
+//   True, as this collider always has finite bounds.
+bool ColliderLine::GetBounds(Vector2D& min, Vector2D& max) const
+{
+	if (lineSegments.empty())
+	{
+		min = transform->GetTranslation();
+		max = min;
+		return true;
+	}
+
+	// The root of the hierarchy contains every segment. This also brings the hierarchy up to date before the narrowphase reads it.
+	UpdateWorldSegments();
+	min = nodes[0].min;
+	max = nodes[0].max;
+
+	return true;
+}
+
+// Whether IsCollidingWith can change either object.
+// Returns:
+//   True if reflection is enabled, as reflected objects are moved and their velocity changed.
+bool ColliderLine::HasCollisionSideEffects() const
+{
+	return reflection;
+}
+
+//------------------------------------------------------------------------------
+// Private Functions:
+//------------------------------------------------------------------------------
+
+// Transforms the segments into world space and rebuilds the hierarchy, if the transform or
+//   segments have changed since the last time.
+void ColliderLine::UpdateWorldSegments() const
+{
+	const unsigned version = transform->GetMatrixVersion();
+	if (worldTransform == transform && worldVersion == version)
+		return;
+
+	// Construct the segments in world space so their normals account for rotation and scale.
+	const CS230::Matrix2D& matrix = transform->GetMatrix();
+	worldSegments.clear();
+	worldSegments.reserve(lineSegments.size());
+	for (auto it = lineSegments.begin(); it != lineSegments.end(); ++it)
+		worldSegments.push_back(LineSegment(matrix * it->start, matrix * it->end));
+
+	nodes.clear();
+	if (!worldSegments.empty())
+	{
+		nodes.push_back(BVHNode());
+		BuildNode(0, 0, static_cast<unsigned>(worldSegments.size()));
+	}
+
+	worldTransform = transform;
+	worldVersion = version;
+}
+
+// Builds the node for a range of world segments, splitting it in half along its longest axis until it is small enough.
+// Params:
+//   node = The index of the node to build.
+//   first = The first world segment in the range.
+//   count = How many world segments are in the range.
+void ColliderLine::BuildNode(unsigned node, unsigned first, unsigned count) const
+{
+	// Grow the box to contain both end points of every segment.
+	Vector2D boxMin = worldSegments[first].start;
+	Vector2D boxMax = boxMin;
+	for (unsigned i = first; i < first + count; ++i)
+	{
+		const LineSegment& segment = worldSegments[i];
+		boxMin = Vector2D(fminf(boxMin.x, fminf(segment.start.x, segment.end.x)), fminf(boxMin.y, fminf(segment.start.y, segment.end.y)));
+		boxMax = Vector2D(fmaxf(boxMax.x, fmaxf(segment.start.x, segment.end.x)), fmaxf(boxMax.y, fmaxf(segment.start.y, segment.end.y)));
+	}
+
+	nodes[node].min = boxMin;
+	nodes[node].max = boxMax;
+
+	if (count <= LineLeafSize)
+	{
+		nodes[node].first = first;
+		nodes[node].count = count;
+		return;
+	}
+
+	// Put the half of the segments with the lower midpoints on the left.
+	const unsigned half = count / 2;
+	auto begin = worldSegments.begin() + first;
+	std::nth_element(begin, begin + half, begin + count, boxMax.x - boxMin.x >= boxMax.y - boxMin.y ? MidpointLessX : MidpointLessY);
+
+	// Adding the children may move the nodes, so only refer to them by index.
+	const unsigned left = static_cast<unsigned>(nodes.size());
+	nodes.push_back(BVHNode());
+	nodes.push_back(BVHNode());
+	nodes[node].first = left;
+	nodes[node].count = 0;
+
+	BuildNode(left, first, half);
+	BuildNode(left + 1, first + half, count - half);
+}
+
+// Finds the first segment a moving point or circle hits.
+// Params:
+//   path = The start and end positions of the center.
+//   radius = The radius of the circle, or 0 for a point.
+//   intersection = Receives the center at the moment of contact.
+//   contactLine = Receives the line the center is reflected over.
+// Returns:
+//   True if any segment was hit.
+bool ColliderLine::FindFirstIntersection(const LineSegment& path, float radius, Vector2D& intersection, LineSegment& contactLine) const
+{
+	if (nodes.empty())
+		return false;
+
+	// The box swept by the circle.
+	Vector2D pathMin(fminf(path.start.x, path.end.x) - radius, fminf(path.start.y, path.end.y) - radius);
+	Vector2D pathMax(fmaxf(path.start.x, path.end.x) + radius, fmaxf(path.start.y, path.end.y) + radius);
+
+	bool intersected = false;
+	float firstT = 0.0f;
+
+	unsigned stack[LineStackSize];
+	unsigned stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		const BVHNode& node = nodes[stack[--stackSize]];
+
+		// Skip every segment below nodes the circle does not pass through.
+		if (node.max.x < pathMin.x || node.min.x > pathMax.x || node.max.y < pathMin.y || node.min.y > pathMax.y)
+			continue;
+
+		if (node.count == 0)
+		{
+			stack[stackSize++] = node.first;
+			stack[stackSize++] = node.first + 1;
+			continue;
+		}
+
+		// Keep the intersection with the lowest t.
+		for (unsigned i = node.first; i < node.first + node.count; ++i)
+		{
+			Vector2D segmentIntersection;
+			float t;
+			LineSegment segmentContactLine;
+			if (!MovingCircleLineIntersection(worldSegments[i], path, radius, segmentIntersection, t, segmentContactLine))
+				continue;
+
+			if (!intersected || t < firstT)
+			{
+				intersection = segmentIntersection;
+				contactLine = segmentContactLine;
+				firstT = t;
+				intersected = true;
+			}
+		}
+	}
+
+	return intersected;
+}
+
+// Orders segments by the x-coordinate of their midpoints.
+bool ColliderLine::MidpointLessX(const LineSegment& a, const LineSegment& b)
+{
+	return a.start.x + a.end.x < b.start.x + b.end.x;
+}
+
+// Orders segments by the y-coordinate of their midpoints.
+bool ColliderLine::MidpointLessY(const LineSegment& a, const LineSegment& b)
+{
+	return a.start.y + a.end.y < b.start.y + b.end.y;
+}
+
 //------------------------------------------------------------------------------
@@ -25,6 +25,7 @@
 
 // Components
 #include "Transform.h"
+#include "Physics.h"
 #include "ColliderCircle.h"
 #include "ColliderRectangle.h"
 
@@ -67,7 +68,7 @@ void ColliderPoint::Draw()
 bool ColliderPoint::IsCollidingWith(const Collider& other) const
 {
 	// The translation of the other collider.
-	Vector2D otherTranslation = static_cast<Transform*>(other.GetOwner()->GetComponent<Transform>())->GetTranslation();
+	Vector2D otherTranslation = other.transform->GetTranslation();
 
 	switch (other.GetType())
 	{
@@ -89,4 +90,26 @@ bool ColliderPoint::IsCollidingWith(const Collider& other) const
 	return other.IsCollidingWith(*this);
 }
 
+// Compute a world-space axis-aligned box that contains this collider, used by the broadphase.
+// Params:
+//   min = Receives the bottom-left corner of the box.
+//   max = Receives the top-right corner of the box.
+// Returns:
+//   True, as this collider always has finite bounds.
+bool ColliderPoint::GetBounds(Vector2D& min, Vector2D& max) const
+{
+	min = transform->GetTranslation();
+	max = min;
+
+	// Line colliders test the path the point moved along, so include the old position.
+	if (physics != nullptr)
+	{
+		const Vector2D& oldTranslation = physics->GetOldTranslation();
+		min = Vector2D(fminf(min.x, oldTranslation.x), fminf(min.y, oldTranslation.y));
+		max = Vector2D(fmaxf(max.x, oldTranslation.x), fmaxf(max.y, oldTranslation.y));
+	}
+
+	return true;
+}
+
 //------------------------------------------------------------------------------
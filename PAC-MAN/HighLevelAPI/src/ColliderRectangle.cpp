@@ -56,7 +56,8 @@ namespace
 // Constructor for rectangle collider.
 // Params:
 //   extents = The rectangle's extents (half-width, half-height).
-ColliderRectangle::ColliderRectangle(const Vector2D& extents) : Collider(ColliderTypeRectangle), extents(extents)
+ColliderRectangle::ColliderRectangle(const Vector2D& extents) : Collider(ColliderTypeRectangle), extents(extents),
+	worldShapeTransform(nullptr), worldShapeVersion(0)
 {
 }
 
@@ -65,7 +66,12 @@ ColliderRectangle::ColliderRectangle(const Vector2D& extents) : Collider(Collide
 //   A pointer to a collider.
 Component* ColliderRectangle::Clone() const
 {
-	return new ColliderRectangle(*this);
+	ColliderRectangle* clone = new ColliderRectangle(*this);
+
+	// The clone will be given its own transform.
+	clone->worldShapeTransform = nullptr;
+
+	return clone;
 }
 
 // Loads object data from a file.
@@ -76,6 +82,7 @@ void ColliderRectangle::Deserialize(Parser& parser)
 	Collider::Deserialize(parser);
 
 	parser.ReadVariable("extents", extents);
+	worldShapeTransform = nullptr;
 }
 
 // Saves object data to a file.
@@ -137,6 +144,7 @@ const Vector2D& ColliderRectangle::GetExtents() const
 void ColliderRectangle::SetExtents(const Vector2D& extents_)
 {
 	extents = extents_;
+	worldShapeTransform = nullptr;
 }
 
 // Check for collision between a rectangle and another arbitrary collider.
@@ -147,7 +155,7 @@ void ColliderRectangle::SetExtents(const Vector2D& extents_)
 bool ColliderRectangle::IsCollidingWith(const Collider& other) const
 {
 	// The translation of the other collider.
-	Vector2D otherTranslation = static_cast<Transform*>(other.GetOwner()->GetComponent<Transform>())->GetTranslation();
+	Vector2D otherTranslation = other.transform->GetTranslation();
 
 	// The BoundingRectangle for this collider.
 	BoundingRectangle rectangle = BoundingRectangle(transform->GetTranslation(), extents);
@@ -242,4 +250,52 @@ bool ColliderRectangle::IsCollidingWith(const Collider& other) const
 	return other.IsCollidingWith(*this);
 }
 
+// Compute a world-space axis-aligned box that contains this collider, used by the broadphase.
+// Params:
+//   min = Receives the bottom-left corner of the box.
+//   max = Receives the top-right corner of the box.
+// Returns:
+//   True, as this collider always has finite bounds.
+bool ColliderRectangle::GetBounds(Vector2D& min, Vector2D& max) const
+{
+	// Bound the world-space corners. This also brings the cached shape up to date before the narrowphase reads it.
+	const OBBShape& obb = GetWorldShape();
+
+	min = obb.corners[0];
+	max = obb.corners[0];
+	for (unsigned i = 1; i < 4; i++)
+	{
+		min = Vector2D(fminf(min.x, obb.corners[i].x), fminf(min.y, obb.corners[i].y));
+		max = Vector2D(fmaxf(max.x, obb.corners[i].x), fmaxf(max.y, obb.corners[i].y));
+	}
+
+	return true;
+}
+
+// Get the world-space corners and axes of the rectangle. They are only recalculated
+//   after the transform or extents change.
+// Returns:
+//	 The oriented bounding box of the rectangle.
+const OBBShape& ColliderRectangle::GetWorldShape() const
+{
+	const unsigned version = transform->GetMatrixVersion();
+	if (worldShapeTransform == transform && worldShapeVersion == version)
+		return worldShape;
+
+	float angle = transform->GetRotation();
+
+	// Calculate the axes along the sides.
+	worldShape.axes[0] = Vector2D(cos(angle), sin(angle));
+	worldShape.axes[1] = Vector2D(-worldShape.axes[0].y, worldShape.axes[0].x);
+
+	// Calculate the corners and move them into world space.
+	GetOBBCorners(*this, worldShape.corners);
+	ApplyTransformToPoints(transform->GetMatrix(), worldShape.corners, 4);
+
+	worldShapeTransform = transform;
+	worldShapeVersion = version;
+
+	return worldShape;
+}
+
 //------------------------------------------------------------------------------
@@ -24,27 +24,48 @@
 #include <Interpolation.h>
 
 // Components
+#include "ColliderCircle.h"
 #include "ColliderRectangle.h"
 #include "Transform.h"
 #include "Physics.h"
 
 //------------------------------------------------------------------------------
 
+// How far inside a cell an edge must be to count as overlapping it, in cells. Edges that only
+//   touch a cell do not overlap it.
+const float CellTolerance = 0.001f;
+
+//------------------------------------------------------------------------------
+
 //------------------------------------------------------------------------------
 // Public Functions:
 //------------------------------------------------------------------------------
 
 // Constructor for Tilemap collider.
-ColliderTilemap::ColliderTilemap() : Collider(ColliderType::ColliderTypeTilemap), map(nullptr)
+ColliderTilemap::ColliderTilemap() : Collider(ColliderType::ColliderTypeTilemap), map(nullptr),
+	columns(0), rows(0), wordsPerRow(0)
 {
 }
 
+// Destructor for Tilemap collider.
+ColliderTilemap::~ColliderTilemap()
+{
+	if (map != nullptr)
+		map->Unsubscribe(OnTilemapChanged, this);
+}
+
 // Clone an collider and return a pointer to the cloned object.
 // Returns:
 //   A pointer to a collider.
 Component* ColliderTilemap::Clone() const
 {
-	return new ColliderTilemap(*this);
+	ColliderTilemap* clone = new ColliderTilemap(*this);
+
+	// The clone keeps its own copy of the solid bits, so it must follow edits too.
+	if (map != nullptr)
+		map->Subscribe(OnTilemapChanged, clone);
+
+	return clone;
 }
 
 // Debug drawing for colliders.
@@ -52,77 +73,130 @@ void ColliderTilemap::Draw()
 {
 }
 
-// Check for collision between a tilemap and another arbitrary collider.
+// Check for collision between a tilemap and a point, circle, or rectangle collider.
+//   Objects with physics are swept from their old translation to their new one, and stopped
+//   at the first solid tile crossed on each axis.
 // Params:
 //	 other = Reference to the second collider component.
 // Returns:
 //	 Return the results of the collision check.
 bool ColliderTilemap::IsCollidingWith(const Collider& other) const
 {
-	// Only collision with rectangle colliders is handled.
-	if (other.GetType() != ColliderType::ColliderTypeRectangle)
+	if (map == nullptr)
+		return false;
+
+	// Half the width and height of the box containing the other collider.
+	Vector2D otherExtents = Vector2D(0.0f, 0.0f);
+
+	switch (other.GetType())
+	{
+	case ColliderType::ColliderTypePoint:
+		break;
+	case ColliderType::ColliderTypeCircle:
+	{
+		const float radius = static_cast<const ColliderCircle&>(other).GetRadius();
+		otherExtents = Vector2D(radius, radius);
+		break;
+	}
+	case ColliderType::ColliderTypeRectangle:
+		otherExtents = static_cast<const ColliderRectangle&>(other).GetExtents();
+		break;
+	default:
+		// Only collision with point, circle and rectangle colliders is handled.
 		return false;
+	}
 
 	// The physics of the other object.
 	Physics* otherPhysics = static_cast<Physics*>(other.GetOwner()->GetComponent<Physics>());
 
-	bool shouldResolve = otherPhysics != nullptr;
-
 	// The transform of the other object.
 	Transform* otherTransform = static_cast<Transform*>(other.GetOwner()->GetComponent<Transform>());
 
 	// The translation of the other collider.
 	Vector2D otherTranslation = otherTransform->GetTranslation();
 
-	// The other collider as a ColliderRectangle.
-	const ColliderRectangle& otherRectangle = static_cast<const ColliderRectangle&>(other);
-
-	// The bounding box of the other collider.
-	BoundingRectangle otherBounding = BoundingRectangle(otherTranslation, otherRectangle.GetExtents());
-
 	// Which sides are currently colliding.
-	MapCollision mapCollision = MapCollision(
-		IsSideColliding(otherBounding, RectangleSide::SideBottom),
-		IsSideColliding(otherBounding, RectangleSide::SideTop),
-		IsSideColliding(otherBounding, RectangleSide::SideLeft),
-		IsSideColliding(otherBounding, RectangleSide::SideRight)
-	);
-
-	// If resolution is not possible, simply check if anything is colliding and return.
-	if (!shouldResolve)
+	MapCollision mapCollision = MapCollision(false, false, false, false);
+
+	if (otherPhysics != nullptr)
 	{
-		if (mapCollision.bottom || mapCollision.top || mapCollision.left || mapCollision.right)
+		// Sweep the box from where the object was last step to where it is now, so fast objects
+		//   cannot pass through walls between the two.
+		Vector2D boxMin;
+		Vector2D boxMax;
+		Vector2D newMin;
+		Vector2D newMax;
+		WorldToCellBox(otherPhysics->GetOldTranslation(), otherExtents, boxMin, boxMax);
+		WorldToCellBox(otherTranslation, otherExtents, newMin, newMax);
+
+		if (SweepBox(boxMin, boxMax, newMin - boxMin, mapCollision))
 		{
-			// Call the map collision event handler if it exists.
-			MapCollisionEventHandler collisionEventHandler = other.GetMapCollisionHandler();
-			if (collisionEventHandler != nullptr)
-				collisionEventHandler(*other.GetOwner(), mapCollision);
+			// Move the object to where its box stopped, and stop it on the blocked axes.
+			Vector2D stoppedTranslation = CellToWorld((boxMin + boxMax) * 0.5f);
+			Vector2D otherVelocity = otherPhysics->GetVelocity();
+
+			if (mapCollision.left || mapCollision.right)
+			{
+				otherTranslation.x = stoppedTranslation.x;
+				otherVelocity.x = 0.0f;
+			}
+
+			if (mapCollision.bottom || mapCollision.top)
+			{
+				otherTranslation.y = stoppedTranslation.y;
+				otherVelocity.y = 0.0f;
+			}
+
+			otherTransform->SetTranslation(otherTranslation);
+			otherPhysics->SetVelocity(otherVelocity);
+		}
 
-			return true;
+		// Objects that were already inside solid tiles are pushed out by the tiles under their sides.
+		BoundingRectangle otherBounding = BoundingRectangle(otherTranslation, otherExtents);
+		MapCollision sideCollision = MapCollision(
+			IsSideColliding(otherBounding, RectangleSide::SideBottom),
+			IsSideColliding(otherBounding, RectangleSide::SideTop),
+			IsSideColliding(otherBounding, RectangleSide::SideLeft),
+			IsSideColliding(otherBounding, RectangleSide::SideRight)
+		);
+
+		if (sideCollision.bottom || sideCollision.top || sideCollision.left || sideCollision.right)
+		{
+			ResolveCollisions(otherBounding, otherTransform, otherPhysics, sideCollision);
+
+			mapCollision.bottom |= sideCollision.bottom;
+			mapCollision.top |= sideCollision.top;
+			mapCollision.left |= sideCollision.left;
+			mapCollision.right |= sideCollision.right;
 		}
-		else
+	}
+	else
+	{
+		// Without physics, only check whether the collider overlaps solid tiles.
+		bool isOverlapping = true;
+		if (other.GetType() == ColliderType::ColliderTypePoint)
+			isOverlapping = IsCollidingAtPosition(otherTranslation.x, otherTranslation.y);
+		else if (other.GetType() == ColliderType::ColliderTypeCircle)
+			isOverlapping = IsCircleColliding(otherTranslation, otherExtents.x);
+
+		if (isOverlapping)
 		{
-			return false;
+			// The bounding box of the other collider.
+			BoundingRectangle otherBounding = BoundingRectangle(otherTranslation, otherExtents);
+
+			mapCollision = MapCollision(
+				IsSideColliding(otherBounding, RectangleSide::SideBottom),
+				IsSideColliding(otherBounding, RectangleSide::SideTop),
+				IsSideColliding(otherBounding, RectangleSide::SideLeft),
+				IsSideColliding(otherBounding, RectangleSide::SideRight)
+			);
 		}
 	}
 
-	// The old translation of the other collider.
-	Vector2D otherOldTranslation = otherPhysics->GetOldTranslation();
-
-	Vector2D otherNewTranslation = otherTranslation;
-
-	// The velocity of the other object.
-	Vector2D otherVelocity = otherPhysics->GetVelocity();
-
-	Vector2D otherNewVelocity = otherVelocity;
-
 	// If nothing is colliding, return false.
 	if (!(mapCollision.bottom || mapCollision.top || mapCollision.left || mapCollision.right))
 		return false;
 
-	// Resolve collisions.
-	ResolveCollisions(otherBounding, otherTransform, otherPhysics, mapCollision);
-
 	// Call the map collision event handler if it exists.
 	MapCollisionEventHandler collisionEventHandler = other.GetMapCollisionHandler();
 	if (collisionEventHandler != nullptr)
@@ -131,12 +205,75 @@ bool ColliderTilemap::IsCollidingWith(const Collider& other) const
 	return true;
 }
 
+// Whether IsCollidingWith can change either object.
+// Returns:
+//   True, as colliding objects are moved out of solid tiles and sent map collision events.
+bool ColliderTilemap::HasCollisionSideEffects() const
+{
+	return true;
+}
+
 // Sets the tilemap to use for this collider.
 // Params:
 //   map = A pointer to the tilemap resource.
 void ColliderTilemap::SetTilemap(const Tilemap* map_)
 {
+	if (map != nullptr)
+		map->Unsubscribe(OnTilemapChanged, this);
+
 	map = map_;
+	columns = map != nullptr ? static_cast<int>(map->GetWidth()) : 0;
+	rows = map != nullptr ? static_cast<int>(map->GetHeight()) : 0;
+	wordsPerRow = (static_cast<unsigned>(columns) + 63) / 64;
+	solidBits.assign(static_cast<size_t>(wordsPerRow) * rows, 0);
+
+	if (map != nullptr)
+	{
+		BuildSolidBits(0, 0, columns - 1, rows - 1);
+		map->Subscribe(OnTilemapChanged, this);
+	}
+}
+
+// Checks whether any cell in a rectangle of the tilemap is solid. Cells outside the map are not solid.
+// Params:
+//   minColumn = The left edge of the rectangle.
+//   minRow = The top edge of the rectangle.
+//   maxColumn = The right edge of the rectangle.
+//   maxRow = The bottom edge of the rectangle.
+bool ColliderTilemap::IsAreaSolid(int minColumn, int minRow, int maxColumn, int maxRow) const
+{
+	minColumn = max(minColumn, 0);
+	minRow = max(minRow, 0);
+	maxColumn = min(maxColumn, columns - 1);
+	maxRow = min(maxRow, rows - 1);
+	if (minColumn > maxColumn || minRow > maxRow)
+		return false;
+
+	const unsigned firstWord = static_cast<unsigned>(minColumn) / 64;
+	const unsigned lastWord = static_cast<unsigned>(maxColumn) / 64;
+
+	// Masks of the columns in the first and last words of each row.
+	const unsigned long long firstMask = ~0ULL << (minColumn % 64);
+	const unsigned long long lastMask = ~0ULL >> (63 - maxColumn % 64);
+
+	for (int row = minRow; row <= maxRow; ++row)
+	{
+		const unsigned long long* rowBits = &solidBits[static_cast<size_t>(row) * wordsPerRow];
+
+		for (unsigned word = firstWord; word <= lastWord; ++word)
+		{
+			unsigned long long mask = ~0ULL;
+			if (word == firstWord)
+				mask &= firstMask;
+			if (word == lastWord)
+				mask &= lastMask;
+
+			if ((rowBits[word] & mask) != 0)
+				return true;
+		}
+	}
+
+	return false;
 }
 
 //------------------------------------------------------------------------------
@@ -155,40 +292,41 @@ bool ColliderTilemap::IsSideColliding(const BoundingRectangle& rectangle, Rectan
 	static const float pointScale = 0.6f;
 	// The number of units the collider's size is decreased by.
 	static const float shrinkAmount = 0.01f;
-	// The number of hotspots.
-	static const unsigned hotspotsCount = 2;
 
-	Vector2D hotspots[hotspotsCount];
+	// The hotspots at either end of the side.
+	Vector2D hotspot0;
+	Vector2D hotspot1;
 
 	// Calculate hotpoint positions.
 	switch (side)
 	{
 	case RectangleSide::SideBottom:
-		hotspots[0] = Vector2D(rectangle.center.x - rectangle.extents.x * pointScale, rectangle.bottom + shrinkAmount);
-		hotspots[1] = Vector2D(rectangle.center.x + rectangle.extents.x * pointScale, rectangle.bottom + shrinkAmount);
+		hotspot0 = Vector2D(rectangle.center.x - rectangle.extents.x * pointScale, rectangle.bottom + shrinkAmount);
+		hotspot1 = Vector2D(rectangle.center.x + rectangle.extents.x * pointScale, rectangle.bottom + shrinkAmount);
 		break;
 	case RectangleSide::SideTop:
-		hotspots[0] = Vector2D(rectangle.center.x - rectangle.extents.x * pointScale, rectangle.top - shrinkAmount);
-		hotspots[1] = Vector2D(rectangle.center.x + rectangle.extents.x * pointScale, rectangle.top - shrinkAmount);
+		hotspot0 = Vector2D(rectangle.center.x - rectangle.extents.x * pointScale, rectangle.top - shrinkAmount);
+		hotspot1 = Vector2D(rectangle.center.x + rectangle.extents.x * pointScale, rectangle.top - shrinkAmount);
 		break;
 	case RectangleSide::SideLeft:
-		hotspots[0] = Vector2D(rectangle.left + shrinkAmount, rectangle.center.y - rectangle.extents.y * pointScale);
-		hotspots[1] = Vector2D(rectangle.left + shrinkAmount, rectangle.center.y + rectangle.extents.y * pointScale);
+		hotspot0 = Vector2D(rectangle.left + shrinkAmount, rectangle.center.y - rectangle.extents.y * pointScale);
+		hotspot1 = Vector2D(rectangle.left + shrinkAmount, rectangle.center.y + rectangle.extents.y * pointScale);
 		break;
 	case RectangleSide::SideRight:
-		hotspots[0] = Vector2D(rectangle.right - shrinkAmount, rectangle.center.y - rectangle.extents.y * pointScale);
-		hotspots[1] = Vector2D(rectangle.right - shrinkAmount, rectangle.center.y + rectangle.extents.y * pointScale);
+		hotspot0 = Vector2D(rectangle.right - shrinkAmount, rectangle.center.y - rectangle.extents.y * pointScale);
+		hotspot1 = Vector2D(rectangle.right - shrinkAmount, rectangle.center.y + rectangle.extents.y * pointScale);
 		break;
 	}
 
-	// Check if the hotspots are colliding.
-	for (unsigned i = 0; i < hotspotsCount; i++)
-	{
-		if (IsCollidingAtPosition(hotspots[i].x, hotspots[i].y))
-			return true;
-	}
+	// Test every cell between the hotspots in one span query.
+	Vector2D cell0 = WorldToCell(hotspot0);
+	Vector2D cell1 = WorldToCell(hotspot1);
+	const int column0 = static_cast<int>(floor(cell0.x));
+	const int row0 = static_cast<int>(floor(cell0.y));
+	const int column1 = static_cast<int>(floor(cell1.x));
+	const int row1 = static_cast<int>(floor(cell1.y));
 
-	return false;
+	return IsAreaSolid(min(column0, column1), min(row0, row1), max(column0, column1), max(row0, row1));
 }
 
 // Determines whether a point is within a collidable cell in the tilemap.
@@ -196,17 +334,244 @@ bool ColliderTilemap::IsSideColliding(const BoundingRectangle& rectangle, Rectan
 //   x = The x component of the point, in world coordinates.
 //   y = The y component of the point, in world coordinates.
 // Returns:
-//   -1 if the point is outside the map, 0 if the map is empty at that position, 
-//   or a positive integer if there is a tile at that position.
+//   False if the point is outside the map or the map is empty at that position, 
+//   or true if there is a tile at that position.
 bool ColliderTilemap::IsCollidingAtPosition(float x, float y) const
 {
-	// Convert the point from world space to tile space.
-	Vector2D tileSpaceCoordinate = transform->GetInverseMatrix() * Vector2D(x, y);
-	unsigned col = static_cast<unsigned>(floor(tileSpaceCoordinate.x + 0.5f));
-	unsigned row = static_cast<unsigned>(floor(-tileSpaceCoordinate.y + 0.5f));
+	// Convert the point from world space to cell space.
+	Vector2D cell = WorldToCell(Vector2D(x, y));
 
 	// Check if the tile is solid.
-	return map->GetCellValue(col, row) > 0;
+	return IsCellSolid(static_cast<int>(floor(cell.x)), static_cast<int>(floor(cell.y)));
+}
+
+// Determines whether a circle overlaps a collidable cell in the tilemap.
+// Params:
+//   center = The center of the circle, in world coordinates.
+//   radius = The radius of the circle, in world units.
+bool ColliderTilemap::IsCircleColliding(const Vector2D& center, float radius) const
+{
+	// The box containing the circle, in cell space.
+	Vector2D boxMin;
+	Vector2D boxMax;
+	WorldToCellBox(center, Vector2D(radius, radius), boxMin, boxMax);
+
+	const int minColumn = static_cast<int>(floor(boxMin.x + CellTolerance));
+	const int minRow = static_cast<int>(floor(boxMin.y + CellTolerance));
+	const int maxColumn = max(minColumn, static_cast<int>(ceil(boxMax.x - CellTolerance)) - 1);
+	const int maxRow = max(minRow, static_cast<int>(ceil(boxMax.y - CellTolerance)) - 1);
+
+	// Most circles are far from any solid cell, so test the whole box first.
+	if (!IsAreaSolid(minColumn, minRow, maxColumn, maxRow))
+		return false;
+
+	// The circle is an ellipse in cell space if the tilemap is scaled unevenly.
+	const Vector2D cellCenter = (boxMin + boxMax) * 0.5f;
+	const Vector2D cellRadii = (boxMax - boxMin) * 0.5f;
+	if (cellRadii.x <= 0.0f || cellRadii.y <= 0.0f)
+		return IsCellSolid(static_cast<int>(floor(cellCenter.x)), static_cast<int>(floor(cellCenter.y)));
+
+	for (int row = minRow; row <= maxRow; ++row)
+	{
+		for (int column = minColumn; column <= maxColumn; ++column)
+		{
+			if (!IsCellSolid(column, row))
+				continue;
+
+			// Find the point of the cell closest to the center of the circle.
+			const float closestX = max(static_cast<float>(column), min(cellCenter.x, static_cast<float>(column + 1)));
+			const float closestY = max(static_cast<float>(row), min(cellCenter.y, static_cast<float>(row + 1)));
+			const float distanceX = (closestX - cellCenter.x) / cellRadii.x;
+			const float distanceY = (closestY - cellCenter.y) / cellRadii.y;
+
+			if (distanceX * distanceX + distanceY * distanceY < 1.0f)
+				return true;
+		}
+	}
+
+	return false;
+}
+
+// Moves a box through cell space one axis at a time, stopping it at the first solid cell its
+//   leading edge crosses. Cells the box already overlaps do not stop it.
+// Params:
+//   boxMin = The top-left corner of the box in cell space. Receives the corner where the box stops.
+//   boxMax = The bottom-right corner of the box in cell space. Receives the corner where the box stops.
+//   movement = How far to move the box, in cell space.
+//   collisions = Receives which sides of the box were stopped, in world space.
+// Returns:
+//   True if the box was stopped on either axis.
+bool ColliderTilemap::SweepBox(Vector2D& boxMin, Vector2D& boxMax, const Vector2D& movement, MapCollision& collisions) const
+{
+	// Sweep along the x-axis, testing the rows the box covers in each column its leading edge enters.
+	const int minRow = static_cast<int>(floor(boxMin.y + CellTolerance));
+	const int maxRow = max(minRow, static_cast<int>(ceil(boxMax.y - CellTolerance)) - 1);
+	float moveX = movement.x;
+
+	if (movement.x > 0.0f)
+	{
+		const int firstColumn = max(static_cast<int>(ceil(boxMax.x - CellTolerance)), 0);
+		const int lastColumn = min(static_cast<int>(ceil(boxMax.x + movement.x - CellTolerance)) - 1, columns - 1);
+		for (int column = firstColumn; column <= lastColumn; ++column)
+		{
+			if (IsAreaSolid(column, minRow, column, maxRow))
+			{
+				moveX = column - boxMax.x;
+				collisions.right = true;
+				break;
+			}
+		}
+	}
+	else if (movement.x < 0.0f)
+	{
+		const int firstColumn = min(static_cast<int>(floor(boxMin.x + CellTolerance)) - 1, columns - 1);
+		const int lastColumn = max(static_cast<int>(floor(boxMin.x + movement.x + CellTolerance)), 0);
+		for (int column = firstColumn; column >= lastColumn; --column)
+		{
+			if (IsAreaSolid(column, minRow, column, maxRow))
+			{
+				moveX = column + 1 - boxMin.x;
+				collisions.left = true;
+				break;
+			}
+		}
+	}
+
+	boxMin.x += moveX;
+	boxMax.x += moveX;
+
+	// Sweep along the y-axis from where the box stopped on the x-axis. Rows increase downward.
+	const int minColumn = static_cast<int>(floor(boxMin.x + CellTolerance));
+	const int maxColumn = max(minColumn, static_cast<int>(ceil(boxMax.x - CellTolerance)) - 1);
+	float moveY = movement.y;
+
+	if (movement.y > 0.0f)
+	{
+		const int firstRow = max(static_cast<int>(ceil(boxMax.y - CellTolerance)), 0);
+		const int lastRow = min(static_cast<int>(ceil(boxMax.y + movement.y - CellTolerance)) - 1, rows - 1);
+		for (int row = firstRow; row <= lastRow; ++row)
+		{
+			if (IsAreaSolid(minColumn, row, maxColumn, row))
+			{
+				moveY = row - boxMax.y;
+				collisions.bottom = true;
+				break;
+			}
+		}
+	}
+	else if (movement.y < 0.0f)
+	{
+		const int firstRow = min(static_cast<int>(floor(boxMin.y + CellTolerance)) - 1, rows - 1);
+		const int lastRow = max(static_cast<int>(floor(boxMin.y + movement.y + CellTolerance)), 0);
+		for (int row = firstRow; row >= lastRow; --row)
+		{
+			if (IsAreaSolid(minColumn, row, maxColumn, row))
+			{
+				moveY = row + 1 - boxMin.y;
+				collisions.top = true;
+				break;
+			}
+		}
+	}
+
+	boxMin.y += moveY;
+	boxMax.y += moveY;
+
+	return collisions.left || collisions.right || collisions.bottom || collisions.top;
+}
+
+// Converts a point from world space to cell space, where cell (column, row) covers the unit
+//   square from (column, row) to (column + 1, row + 1).
+// Params:
+//   point = The point in world space.
+Vector2D ColliderTilemap::WorldToCell(const Vector2D& point) const
+{
+	// Tile centers are at whole numbers in tile space, and rows run down the negative y-axis.
+	Vector2D tileSpacePoint = transform->GetInverseMatrix() * point;
+	return Vector2D(tileSpacePoint.x + 0.5f, -tileSpacePoint.y + 0.5f);
+}
+
+// Converts a point from cell space to world space.
+// Params:
+//   point = The point in cell space.
+Vector2D ColliderTilemap::CellToWorld(const Vector2D& point) const
+{
+	return transform->GetMatrix() * Vector2D(point.x - 0.5f, -(point.y - 0.5f));
+}
+
+// Converts a world-space box to the box that contains it in cell space.
+// Params:
+//   center = The center of the box, in world coordinates.
+//   extents = Half the width and height of the box, in world units.
+//   boxMin = Receives the top-left corner of the box in cell space.
+//   boxMax = Receives the bottom-right corner of the box in cell space.
+void ColliderTilemap::WorldToCellBox(const Vector2D& center, const Vector2D& extents, Vector2D& boxMin, Vector2D& boxMax) const
+{
+	Vector2D corner0 = WorldToCell(center - extents);
+	Vector2D corner1 = WorldToCell(center + extents);
+
+	boxMin = Vector2D(min(corner0.x, corner1.x), min(corner0.y, corner1.y));
+	boxMax = Vector2D(max(corner0.x, corner1.x), max(corner0.y, corner1.y));
+}
+
+// Checks whether a cell of the tilemap is solid. Cells outside the map are not solid.
+// Params:
+//   column = The column of the cell.
+//   row = The row of the cell.
+bool ColliderTilemap::IsCellSolid(int column, int row) const
+{
+	if (column < 0 || row < 0 || column >= columns || row >= rows)
+		return false;
+
+	const unsigned long long word = solidBits[static_cast<size_t>(row) * wordsPerRow + column / 64];
+	return ((word >> (column % 64)) & 1) != 0;
+}
+
+// Reads the cells in a rectangle of the tilemap into the solid bits.
+// Params:
+//   minColumn = The left edge of the rectangle.
+//   minRow = The top edge of the rectangle.
+//   maxColumn = The right edge of the rectangle.
+//   maxRow = The bottom edge of the rectangle.
+void ColliderTilemap::BuildSolidBits(int minColumn, int minRow, int maxColumn, int maxRow)
+{
+	minColumn = max(minColumn, 0);
+	minRow = max(minRow, 0);
+	maxColumn = min(maxColumn, columns - 1);
+	maxRow = min(maxRow, rows - 1);
+	if (minColumn > maxColumn || minRow > maxRow)
+		return;
+
+	std::vector<int> values(static_cast<size_t>(maxColumn - minColumn + 1));
+
+	for (int row = minRow; row <= maxRow; ++row)
+	{
+		map->GetSpan(static_cast<unsigned>(minColumn), static_cast<unsigned>(row), static_cast<unsigned>(values.size()), values.data());
+
+		unsigned long long* rowBits = &solidBits[static_cast<size_t>(row) * wordsPerRow];
+		for (int column = minColumn; column <= maxColumn; ++column)
+		{
+			const unsigned long long bit = 1ULL << (column % 64);
+			if (values[column - minColumn] > 0)
+				rowBits[column / 64] |= bit;
+			else
+				rowBits[column / 64] &= ~bit;
+		}
+	}
+}
+
+// Reads the changed cells of the tilemap into the solid bits.
+// Params:
+//   context = The tilemap collider that subscribed.
+//   tilemap = The tilemap that changed.
+//   minColumn = The left edge of the changed rectangle.
+//   minRow = The top edge of the changed rectangle.
+//   maxColumn = The right edge of the changed rectangle.
+//   maxRow = The bottom edge of the changed rectangle.
+void ColliderTilemap::OnTilemapChanged(void* context, const Tilemap& tilemap, int minColumn, int minRow, int maxColumn, int maxRow)
+{
+	UNREFERENCED_PARAMETER(tilemap);
+	static_cast<ColliderTilemap*>(context)->BuildSolidBits(minColumn, minRow, maxColumn, maxRow);
 }
 
 // Moves an object and sets its velocity based on where it collided with the tilemap.
@@ -35,6 +35,18 @@ Component::Component(const std::string& name) : BetaObject(name)
 {
 }
 
+// Resets the component to match a component of the same type from the object's archetype,
+//   so a pooled object can be reused without cloning its components again.
+// Params:
+//   archetype = The matching component of the object's archetype.
+// Returns:
+//   False if the component cannot be reset in place and must be cloned again.
+bool Component::Reset(const Component& archetype)
+{
+	UNREFERENCED_PARAMETER(archetype);
+	return false;
+}
+
 // Retrieve component's owner object (if any).
 GameObject* Component::GetOwner() const
 {
@@ -0,0 +1,345 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	FlowFieldMap.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "FlowFieldMap.h"
+
+// Systems
+#include "Tilemap.h"
+#include <Vector2D.h>
+#include <climits>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// Constructor
+FlowFieldMap::FlowFieldMap() : tilemap(nullptr), wrapsAround(false), width(0), height(0), mode(MODE_FLOW_FIELD), maxFields(32), useCounter(0), buildCount(0)
+{
+}
+
+// Destructor
+FlowFieldMap::~FlowFieldMap()
+{
+	Invalidate();
+
+	for (auto it = freeFields.begin(); it != freeFields.end(); ++it)
+		delete *it;
+}
+
+// Sets the tilemap the fields are built over, discarding every field.
+// Params:
+//   tilemap = The tilemap of the space's grid, or nullptr if there is none.
+//   wrapsAround = Whether moving off one edge of the map leads onto the opposite edge.
+void FlowFieldMap::SetTilemap(const Tilemap* tilemap_, bool wrapsAround_)
+{
+	Invalidate();
+
+	if (tilemap != nullptr)
+		tilemap->Unsubscribe(OnTilemapChanged, this);
+
+	tilemap = tilemap_;
+	wrapsAround = wrapsAround_;
+	width = tilemap != nullptr ? static_cast<int>(tilemap->GetWidth()) : 0;
+	height = tilemap != nullptr ? static_cast<int>(tilemap->GetHeight()) : 0;
+
+	// Any edited cell may change the distances of every tile, so edits discard every field.
+	if (tilemap != nullptr)
+		tilemap->Subscribe(OnTilemapChanged, this);
+}
+
+// Sets how costs are measured.
+void FlowFieldMap::SetMode(Mode mode_)
+{
+	mode = mode_;
+}
+
+// Gets how costs are measured.
+FlowFieldMap::Mode FlowFieldMap::GetMode() const
+{
+	return mode;
+}
+
+// Gets the cost of moving from a tile to a target. Lower costs are closer.
+//   Tiles that cannot reach the target cost more than every tile that can.
+// Params:
+//   target = The target, in tile space. In flow field mode the nearest walkable tile is used.
+//   tile = The tile to move from.
+//   doorValue = A cell value that is walkable in addition to empty cells, or -1 for none.
+float FlowFieldMap::GetCost(const Vector2D& target, const TileCoord& tile, int doorValue)
+{
+	const float straightDistance = tile.ToVector2D().Distance(target);
+	if (mode == MODE_GREEDY || tilemap == nullptr)
+		return straightDistance;
+
+	const unsigned distance = GetDistance(TileCoord::Floor(target + Vector2D(0.5f, 0.5f)), tile, doorValue);
+
+	// Order unreachable tiles by the greedy rule, behind every reachable tile.
+	if (distance == unreachable)
+		return static_cast<float>(unreachable) + straightDistance;
+
+	return static_cast<float>(distance);
+}
+
+// Gets the number of steps from a tile to a target through the map.
+// Params:
+//   target = The target tile. If it is not walkable, the nearest walkable tile is used.
+//   tile = The tile to move from.
+//   doorValue = A cell value that is walkable in addition to empty cells, or -1 for none.
+// Returns:
+//   The number of steps, or unreachable if the tile cannot reach the target.
+unsigned FlowFieldMap::GetDistance(const TileCoord& target, const TileCoord& tile, int doorValue)
+{
+	unsigned index;
+	if (tilemap == nullptr || !GetIndex(tile, index))
+		return unreachable;
+
+	return GetField(target, doorValue).distances[index];
+}
+
+// Sets how many fields are kept (32 by default). Each field takes two bytes per tile of the map.
+//   Once there are more, the least recently used are discarded.
+// Params:
+//   maxFields = The number of fields to keep, at least 1.
+void FlowFieldMap::SetMaxFields(size_t maxFields_)
+{
+	maxFields = max(maxFields_, static_cast<size_t>(1));
+
+	// Discard the least recently used fields until the new limit is met.
+	while (fields.size() > maxFields)
+	{
+		auto leastRecent = fields.begin();
+		for (auto it = fields.begin(); it != fields.end(); ++it)
+		{
+			if ((*it)->lastUsed < (*leastRecent)->lastUsed)
+				leastRecent = it;
+		}
+
+		freeFields.push_back(*leastRecent);
+		fields.erase(leastRecent);
+	}
+}
+
+// Gets how many fields are kept before the least recently used are discarded.
+size_t FlowFieldMap::GetMaxFields() const
+{
+	return maxFields;
+}
+
+// Discards every field. Call after changing cells of the tilemap.
+void FlowFieldMap::Invalidate()
+{
+	freeFields.insert(freeFields.end(), fields.begin(), fields.end());
+	fields.clear();
+}
+
+// Forgets the tilemap and discards every field. Call before the tilemap is destroyed.
+void FlowFieldMap::Clear()
+{
+	SetTilemap(nullptr, false);
+}
+
+// Gets how many fields are kept.
+size_t FlowFieldMap::GetFieldCount() const
+{
+	return fields.size();
+}
+
+// Gets how many fields have been built.
+unsigned FlowFieldMap::GetBuildCount() const
+{
+	return buildCount;
+}
+
+//------------------------------------------------------------------------------
+// Private Functions:
+//------------------------------------------------------------------------------
+
+// Gets the field for a target, building it if there is none.
+// Params:
+//   target = The target tile.
+//   doorValue = A cell value that is walkable in addition to empty cells, or -1 for none.
+const FlowFieldMap::Field& FlowFieldMap::GetField(const TileCoord& target, int doorValue)
+{
+	++useCounter;
+
+	// Only a handful of targets are in use at once, so a linear search is enough.
+	auto leastRecent = fields.begin();
+	for (auto it = fields.begin(); it != fields.end(); ++it)
+	{
+		if ((*it)->target == target && (*it)->doorValue == doorValue)
+		{
+			(*it)->lastUsed = useCounter;
+			return **it;
+		}
+
+		if ((*it)->lastUsed < (*leastRecent)->lastUsed)
+			leastRecent = it;
+	}
+
+	// Rebuild the least recently used field once there are as many as may be kept.
+	Field* field;
+	if (fields.size() >= maxFields)
+	{
+		field = *leastRecent;
+	}
+	else
+	{
+		if (freeFields.empty())
+		{
+			field = new Field();
+		}
+		else
+		{
+			field = freeFields.back();
+			freeFields.pop_back();
+		}
+
+		fields.push_back(field);
+	}
+
+	field->target = target;
+	field->doorValue = doorValue;
+	field->lastUsed = useCounter;
+	BuildField(*field);
+
+	return *field;
+}
+
+// Fills out the distances of a field with a breadth-first search from its target.
+// Params:
+//   field = The field to build.
+void FlowFieldMap::BuildField(Field& field)
+{
+	++buildCount;
+
+	const unsigned cellCount = static_cast<unsigned>(width * height);
+	field.distances.assign(cellCount, static_cast<unsigned short>(unreachable));
+
+	// Start from the target, or from the nearest walkable tile if the target is a wall or off the map.
+	unsigned start = cellCount;
+	if (field.target.x >= 0 && field.target.y >= 0 && field.target.x < width && field.target.y < height
+		&& IsWalkable(static_cast<unsigned>(field.target.y * width + field.target.x), field.doorValue))
+	{
+		start = static_cast<unsigned>(field.target.y * width + field.target.x);
+	}
+	else
+	{
+		int closestDistance = INT_MAX;
+		for (unsigned i = 0; i < cellCount; ++i)
+		{
+			if (!IsWalkable(i, field.doorValue))
+				continue;
+
+			const int x = static_cast<int>(i % width) - field.target.x;
+			const int y = static_cast<int>(i / width) - field.target.y;
+			if (x * x + y * y < closestDistance)
+			{
+				closestDistance = x * x + y * y;
+				start = i;
+			}
+		}
+	}
+
+	// There is nowhere to walk.
+	if (start == cellCount)
+		return;
+
+	// Offsets to each neighbor.
+	static const TileCoord offsets[4] = { TileCoord(0, -1), TileCoord(-1, 0), TileCoord(0, 1), TileCoord(1, 0) };
+
+	queue.clear();
+	queue.push_back(start);
+	field.distances[start] = 0;
+
+	for (size_t head = 0; head < queue.size(); ++head)
+	{
+		const unsigned current = queue[head];
+		const TileCoord tile(static_cast<int>(current % width), static_cast<int>(current / width));
+		const unsigned short distance = static_cast<unsigned short>(min(field.distances[current] + 1u, unreachable - 1));
+
+		for (unsigned i = 0; i < 4; ++i)
+		{
+			unsigned neighbor;
+			if (!GetIndex(tile + offsets[i], neighbor))
+				continue;
+
+			if (field.distances[neighbor] != unreachable || !IsWalkable(neighbor, field.doorValue))
+				continue;
+
+			field.distances[neighbor] = distance;
+			queue.push_back(neighbor);
+		}
+	}
+}
+
+// Gets the tile a coordinate refers to, wrapping coordinates off the edge of the map if it wraps around.
+// Params:
+//   tile = The coordinate.
+//   index = Receives the row-major index of the tile.
+// Returns:
+//   False if the coordinate is off the edge of a map that does not wrap around.
+bool FlowFieldMap::GetIndex(TileCoord tile, unsigned& index) const
+{
+	if (tile.x < 0 || tile.y < 0 || tile.x >= width || tile.y >= height)
+	{
+		if (!wrapsAround || width == 0 || height == 0)
+			return false;
+
+		tile.x = (tile.x % width + width) % width;
+		tile.y = (tile.y % height + height) % height;
+	}
+
+	index = static_cast<unsigned>(tile.y * width + tile.x);
+	return true;
+}
+
+// Checks whether a cell may be walked through.
+// Params:
+//   index = The row-major index of the cell.
+//   doorValue = A cell value that is walkable in addition to empty cells, or -1 for none.
+bool FlowFieldMap::IsWalkable(unsigned index, int doorValue) const
+{
+	const int cellValue = tilemap->GetCellValue(index % width, index / width);
+	return cellValue == 0 || cellValue == doorValue;
+}
+
+// Discards every field when cells of the tilemap change.
+// Params:
+//   context = The flow field map that subscribed.
+//   tilemap = The tilemap that changed.
+//   minColumn = The left edge of the changed rectangle.
+//   minRow = The top edge of the changed rectangle.
+//   maxColumn = The right edge of the changed rectangle.
+//   maxRow = The bottom edge of the changed rectangle.
+void FlowFieldMap::OnTilemapChanged(void* context, const Tilemap& tilemap, int minColumn, int minRow, int maxColumn, int maxRow)
+{
+	UNREFERENCED_PARAMETER(tilemap);
+	UNREFERENCED_PARAMETER(minColumn);
+	UNREFERENCED_PARAMETER(minRow);
+	UNREFERENCED_PARAMETER(maxColumn);
+	UNREFERENCED_PARAMETER(maxRow);
+
+	static_cast<FlowFieldMap*>(context)->Invalidate();
+}
+
+//------------------------------------------------------------------------------
@@ -36,14 +36,16 @@
 // Create a new game object.
 // Params:
 //	 name = The name of the game object being created.
-GameObject::GameObject(const std::string& name) : BetaObject(name), isDestroyed(false)
+GameObject::GameObject(const std::string& name) : BetaObject(name), isDestroyed(false), tags(0), manager(nullptr), nameId(0),
+	handle(), archetype(nullptr)
 {
 }
 
 // Clone a game object from another game object.
 // Params:
 //	 other = A reference to the object being cloned.
-GameObject::GameObject(const GameObject& other) : BetaObject(other.GetName(), other.GetParent()), isDestroyed(false)
+GameObject::GameObject(const GameObject& other) : BetaObject(other.GetName(), other.GetParent()), isDestroyed(false),
+	tags(other.tags), manager(nullptr), nameId(0), handle(), archetype(nullptr)
 {
 	// Reserve how many components we need so there's only 1 allocation.
 	components.reserve(other.components.size());
@@ -187,6 +189,9 @@ void GameObject::AddComponent(Component* component)
 {
 	components.push_back(component);
 	component->SetParent(this);
+
+	// The new component may match types that were previously looked up.
+	componentCache.clear();
 }
 
 // Retrieves the component with the given name if it exists.
@@ -209,7 +214,14 @@ Component* GameObject::GetComponent(const std::string& name_)
 // Mark an object for destruction.
 void GameObject::Destroy()
 {
+	if (isDestroyed)
+		return;
+
 	isDestroyed = true;
+
+	// Let the object manager stop counting the object right away.
+	if (manager != nullptr)
+		manager->OnObjectDestroyed(*this);
 }
 
 // Whether the object has been marked for destruction.
@@ -226,4 +238,93 @@ Space* GameObject::GetSpace() const
 	return static_cast<Space*>(GetParent());
 }
 
+// Sets the tags of the object, a bitmask that lets groups of objects be found quickly.
+// Params:
+//   tags = The new tags.
+void GameObject::SetTags(unsigned tags_)
+{
+	if (tags == tags_)
+		return;
+
+	unsigned oldTags = tags;
+	tags = tags_;
+
+	if (manager != nullptr)
+		manager->OnTagsChanged(*this, oldTags);
+}
+
+// Gets the tags of the object.
+unsigned GameObject::GetTags() const
+{
+	return tags;
+}
+
+// Whether the object has every one of the given tags.
+// Params:
+//   tags = The tags to check for.
+bool GameObject::HasTags(unsigned tags_) const
+{
+	return (tags & tags_) == tags_;
+}
+
+// Gets a handle to the object that can be kept across frames, or a null handle if the object is not active.
+GameObjectHandle GameObject::GetHandle() const
+{
+	return handle;
+}
+
+//------------------------------------------------------------------------------
+// Private Functions:
+//------------------------------------------------------------------------------
+
+// Gets the next unused component type ID.
+unsigned GameObject::NextComponentTypeId()
+{
+	static unsigned nextTypeId = 0;
+	return nextTypeId++;
+}
+
+// Stores the result of looking up a component type.
+// Params:
+//   typeId = The ID of the component type.
+//   component = The component found for the type, or nullptr if there was none.
+void GameObject::CacheComponent(unsigned typeId, Component* component)
+{
+	if (typeId >= componentCache.size())
+	{
+		CachedComponent unresolved = { nullptr, false };
+		componentCache.resize(typeId + 1, unresolved);
+	}
+
+	componentCache[typeId].component = component;
+	componentCache[typeId].resolved = true;
+}
+
+// Resets a pooled object to match the archetype it was cloned from.
+// Params:
+//   archetype = The object's archetype.
+void GameObject::Reset(const GameObject& archetype_)
+{
+	isDestroyed = false;
+	tags = archetype_.tags;
+
+	bool replacedComponents = false;
+
+	// Pooled objects are clones of the archetype, so their components line up with the archetype's.
+	for (size_t i = 0; i < components.size(); ++i)
+	{
+		if (components[i]->Reset(*archetype_.components[i]))
+			continue;
+
+		// This component cannot be reset, so clone it again.
+		delete components[i];
+		components[i] = archetype_.components[i]->Clone();
+		components[i]->SetParent(this);
+		replacedComponents = true;
+	}
+
+	if (replacedComponents)
+		componentCache.clear();
+}
+
 //------------------------------------------------------------------------------
@@ -0,0 +1,78 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	GameObjectHandle.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "GameObjectHandle.h"
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// Constructor - creates a null handle, which never resolves to an object.
+GameObjectHandle::GameObjectHandle() : value(0)
+{
+}
+
+// Whether this is the null handle.
+bool GameObjectHandle::IsNull() const
+{
+	// Generations start at 1, so no valid handle is 0.
+	return value == 0;
+}
+
+// Compares two handles.
+bool GameObjectHandle::operator==(const GameObjectHandle& other) const
+{
+	return value == other.value;
+}
+
+bool GameObjectHandle::operator!=(const GameObjectHandle& other) const
+{
+	return value != other.value;
+}
+
+//------------------------------------------------------------------------------
+// Private Functions:
+//------------------------------------------------------------------------------
+
+// Constructor
+// Params:
+//   index = The index of the object manager's slot.
+//   generation = The generation of the slot. Must not be 0.
+GameObjectHandle::GameObjectHandle(unsigned index, unsigned generation)
+	: value(((generation & generationMask) << indexBits) | (index & indexMask))
+{
+}
+
+// Gets the index of the object manager's slot.
+unsigned GameObjectHandle::GetIndex() const
+{
+	return value & indexMask;
+}
+
+// Gets the generation of the slot.
+unsigned GameObjectHandle::GetGeneration() const
+{
+	return value >> indexBits;
+}
+
+//------------------------------------------------------------------------------
@@ -22,9 +22,20 @@
 // Systems
 #include "Space.h"
 #include <Vector2D.h>
+#include "BroadphaseGrid.h"
+#include "PhysicsStorage.h"
+#include "ThreadPool.h"
 
 // Components
 #include "Collider.h"
+#include "Transform.h"
+#include "Physics.h"
+#include <cassert>
+
+//------------------------------------------------------------------------------
+
+// How many candidate pairs each batch of the parallel narrowphase covers.
+const size_t NarrowphaseBatchSize = 64;
 
 //------------------------------------------------------------------------------
 
@@ -32,13 +43,19 @@
 // Public Structures:
 //------------------------------------------------------------------------------
 
+// Constructor
+GameObjectManager::ObjectPool::ObjectPool() : hits(0), misses(0)
+{
+}
+
 //------------------------------------------------------------------------------
 // Public Functions:
 //------------------------------------------------------------------------------
 
 // Constructor(s)
 GameObjectManager::GameObjectManager(Space* space) : BetaObject("GameObjectmanager", space),
-	fixedUpdateDt(1.0f / 60.0f), maxFixedUpdateTime(0.2f), timeAccumulator(0.0f)
+	isUpdating(false), orderedDestruction(true), reclaimBudget(0), fixedUpdateDt(1.0f / 60.0f), maxFixedUpdateTime(0.2f), timeAccumulator(0.0f),
+	physicsStorage(nullptr), broadphase(new BroadphaseGrid()), parallelNarrowphase(true)
 {
 }
 
@@ -47,6 +64,9 @@ GameObjectManager::~GameObjectManager()
 {
 	Shutdown();
 	Unload();
+
+	delete physicsStorage;
+	delete broadphase;
 }
 
 // Update all objects in the active game objects list.
@@ -57,11 +77,17 @@ void GameObjectManager::Update(float dt)
 	Space* space = static_cast<Space*>(GetParent());
 	if (!space->IsPaused())
 	{
+		// Objects spawned while updating wait until every object has updated.
+		isUpdating = true;
 		VariableUpdate(dt);
 		FixedUpdate(dt);
+		isUpdating = false;
+
+		FlushSpawnQueue();
 	}
 
 	DestroyObjects();
+	ReclaimObjects(reclaimBudget);
 
 	Draw();
 }
@@ -71,39 +97,102 @@ void GameObjectManager::Shutdown(void)
 {
 	for (auto it = gameObjectActiveList.begin(); it != gameObjectActiveList.end(); it++)
 	{
-		delete *it;
+		// Make sure the broadphase does not hold on to deleted colliders.
+		Collider* collider = (*it)->GetComponent<Collider>();
+		if (collider != nullptr)
+			broadphase->RemoveCollider(*collider);
+
+		UnbindPhysics(**it);
+		FreeHandle(**it);
+		(*it)->manager = nullptr;
+		ReleaseObject(*it);
 	}
 
 	gameObjectActiveList.clear();
+
+	// Objects that never joined the list are released as well.
+	for (auto it = spawnQueue.begin(); it != spawnQueue.end(); ++it)
+	{
+		FreeHandle(**it);
+		ReleaseObject(*it);
+	}
+
+	spawnQueue.clear();
+	contacts.clear();
+	contactKeys.clear();
+
+	// Delete any destroyed objects that have not been reclaimed yet.
+	ReclaimObjects(reclaimQueue.size());
+
+	// Empty the indices. Interned names are kept, as levels usually add the same names again.
+	for (auto it = nameBuckets.begin(); it != nameBuckets.end(); ++it)
+	{
+		it->objects.clear();
+		it->liveCount = 0;
+	}
+
+	for (unsigned i = 0; i < maxTags; ++i)
+		tagBuckets[i].clear();
 }
 
 // Unload the game object manager, destroying all object archetypes.
 void GameObjectManager::Unload(void)
 {
+	// Pooled objects are clones of the archetypes, so delete them first.
+	for (auto it = objectPools.begin(); it != objectPools.end(); ++it)
+	{
+		for (auto object = it->second.objects.begin(); object != it->second.objects.end(); ++object)
+			delete *object;
+	}
+
+	objectPools.clear();
+
 	for (auto it = gameObjectArchetypes.begin(); it != gameObjectArchetypes.end(); it++)
 	{
 		delete *it;
 	}
 
 	gameObjectArchetypes.clear();
+	archetypesByName.clear();
 }
 
-// Add a game object to the active game object list.
+// Add a game object to the active game object list. Objects added while the manager is updating
+//   are queued, and join the list (and are initialized) together once the objects have updated.
 // Params:
 //	 gameObject = Reference to the game object to be added to the list.
 void GameObjectManager::AddObject(GameObject& gameObject)
 {
-	gameObjectActiveList.push_back(&gameObject);
-	gameObject.SetParent(GetParent());
+	if (isUpdating)
+	{
+		// Hand out the handle right away so the spawner can keep it.
+		AllocateHandle(gameObject);
+		spawnQueue.push_back(&gameObject);
+		return;
+	}
+
+	AllocateHandle(gameObject);
+	ActivateObject(gameObject);
 	gameObject.Initialize();
 }
 
+// Reserves room for the given number of active objects, so adding them does not reallocate the object lists.
+// Params:
+//   objectCount = How many active objects to make room for.
+void GameObjectManager::Reserve(size_t objectCount)
+{
+	gameObjectActiveList.reserve(objectCount);
+	handleSlots.reserve(objectCount);
+}
+
 // Add a game object to the game object archetype list.
 // Params:
 //	 gameObject = Reference to the game object to be added to the list.
 void GameObjectManager::AddArchetype(GameObject& gameObject)
 {
 	gameObjectArchetypes.push_back(&gameObject);
+
+	// Only the first archetype with a given name can be found by name.
+	archetypesByName.insert(std::make_pair(gameObject.GetName(), &gameObject));
 }
 
 // Returns a pointer to the first active game object matching the specified name.
@@ -115,14 +204,30 @@ void GameObjectManager::AddArchetype(GameObject& gameObject)
 //	   else return nullptr.
 GameObject* GameObjectManager::GetObjectByName(const std::string& objectName) const
 {
-	// Loop through every game object and check if its name matches.
-	for (auto it = gameObjectActiveList.begin(); it != gameObjectActiveList.end(); it++)
-	{
-		if ((*it)->GetName() == objectName)
-			return *it;
-	}
+	const NameBucket* nameBucket = FindNameBucket(objectName);
+	if (nameBucket == nullptr || nameBucket->objects.empty())
+		return nullptr;
 
-	return nullptr;
+	return nameBucket->objects.front();
+}
+
+// Returns the object a handle refers to.
+// Params:
+//	 handle = The handle of the object.
+// Returns:
+//   The object, or nullptr if the handle is null, the object has left the active list, or it has been destroyed.
+GameObject* GameObjectManager::GetObjectByHandle(GameObjectHandle handle) const
+{
+	const unsigned index = handle.GetIndex();
+	if (handle.IsNull() || index >= handleSlots.size())
+		return nullptr;
+
+	// A stale handle still has the generation from before its slot was freed.
+	const HandleSlot& slot = handleSlots[index];
+	if (slot.generation != handle.GetGeneration() || slot.object == nullptr || slot.object->IsDestroyed())
+		return nullptr;
+
+	return slot.object;
 }
 
 // Fills out a vector of game object pointers with all game objects matching the specified name. Does NOT clear the vector beforehand.
@@ -133,12 +238,16 @@ GameObject* GameObjectManager::GetObjectByName(const std::string& objectName) co
 //   The number of game objects found.
 size_t GameObjectManager::GetAllObjectsByName(const std::string& objectName, std::vector<GameObject*>& objectList) const
 {
+	const NameBucket* nameBucket = FindNameBucket(objectName);
+	if (nameBucket == nullptr)
+		return 0;
+
 	size_t found = 0;
 
-	// Loop through every game object and check if its name matches.
-	for (auto it = gameObjectActiveList.begin(); it != gameObjectActiveList.end(); it++)
+	// Loop through every game object with the name and skip the ones that have been destroyed.
+	for (auto it = nameBucket->objects.begin(); it != nameBucket->objects.end(); it++)
 	{
-		if (!(*it)->IsDestroyed() && (*it)->GetName() == objectName)
+		if (!(*it)->IsDestroyed())
 		{
 			objectList.push_back(*it);
 			++found;
@@ -148,6 +257,76 @@ size_t GameObjectManager::GetAllObjectsByName(const std::string& objectName, std
 	return found;
 }
 
+// Creates a game object from the named archetype, reusing a destroyed object from the archetype's pool if there is one.
+//   The object still needs to be added with AddObject, and returns to the pool when it is destroyed.
+// Params:
+//   archetypeName = The name of the archetype to create the object from.
+// Returns:
+//   The new object, or nullptr if there is no archetype with the given name.
+GameObject* GameObjectManager::CreateObject(const std::string& archetypeName)
+{
+	GameObject* archetype = GetArchetypeByName(archetypeName);
+	if (archetype == nullptr)
+		return nullptr;
+
+	ObjectPool& objectPool = objectPools[archetype];
+
+	if (!objectPool.objects.empty())
+	{
+		++objectPool.hits;
+
+		GameObject* gameObject = objectPool.objects.back();
+		objectPool.objects.pop_back();
+		gameObject->Reset(*archetype);
+		return gameObject;
+	}
+
+	++objectPool.misses;
+
+	GameObject* gameObject = new GameObject(*archetype);
+	gameObject->archetype = archetype;
+	return gameObject;
+}
+
+// Clones objects into the named archetype's pool until it holds the given number of objects.
+// Params:
+//   archetypeName = The name of the archetype to fill the pool of.
+//   count = How many objects the pool should hold.
+void GameObjectManager::WarmPool(const std::string& archetypeName, size_t count)
+{
+	GameObject* archetype = GetArchetypeByName(archetypeName);
+	if (archetype == nullptr)
+		return;
+
+	ObjectPool& objectPool = objectPools[archetype];
+	objectPool.objects.reserve(count);
+
+	while (objectPool.objects.size() < count)
+	{
+		GameObject* gameObject = new GameObject(*archetype);
+		gameObject->archetype = archetype;
+		objectPool.objects.push_back(gameObject);
+	}
+}
+
+// Returns the statistics of the named archetype's pool.
+// Params:
+//   archetypeName = The name of the archetype.
+GameObjectManager::PoolStats GameObjectManager::GetPoolStats(const std::string& archetypeName) const
+{
+	PoolStats poolStats = { 0, 0, 0 };
+
+	auto found = objectPools.find(GetArchetypeByName(archetypeName));
+	if (found != objectPools.end())
+	{
+		poolStats.hits = found->second.hits;
+		poolStats.misses = found->second.misses;
+		poolStats.available = found->second.objects.size();
+	}
+
+	return poolStats;
+}
+
 // Returns a pointer to the first game object archetype matching the specified name.
 // Params:
 //	 objectName = The name of the archetype to be returned, if found.
@@ -157,14 +336,11 @@ size_t GameObjectManager::GetAllObjectsByName(const std::string& objectName, std
 //	   else return nullptr.
 GameObject* GameObjectManager::GetArchetypeByName(const std::string& objectName) const
 {
-	// Loop through every archetype and check if its name matches.
-	for (auto it = gameObjectArchetypes.begin(); it != gameObjectArchetypes.end(); it++)
-	{
-		if ((*it)->GetName() == objectName)
-			return *it;
-	}
+	auto found = archetypesByName.find(objectName);
+	if (found == archetypesByName.end())
+		return nullptr;
 
-	return nullptr;
+	return found->second;
 }
 
 // Returns the number of active objects with the given name.
@@ -172,16 +348,109 @@ GameObject* GameObjectManager::GetArchetypeByName(const std::string& objectName)
 //   objectName = The name of the objects that should be counted.
 unsigned GameObjectManager::GetObjectCount(const std::string& objectName) const
 {
-	unsigned count = 0;
+	const NameBucket* nameBucket = FindNameBucket(objectName);
+	if (nameBucket == nullptr)
+		return 0;
 
-	for (auto it = gameObjectActiveList.begin(); it != gameObjectActiveList.end(); it++)
+	return nameBucket->liveCount;
+}
+
+// Fills out a vector of game object pointers with all game objects that have every one of the specified tags. Does NOT clear the vector beforehand.
+// Params:
+//   tags = The tags the objects must have. Must not be 0.
+//   objectList = A reference to a vector of game object pointers which will be filled with the found game objects.
+// Returns:
+//   The number of game objects found.
+size_t GameObjectManager::GetAllObjectsWithTags(unsigned tags, std::vector<GameObject*>& objectList) const
+{
+	if (tags == 0)
+		return 0;
+
+	// Every match is in the bucket of the lowest tag, so only that bucket needs to be searched.
+	unsigned bit = 0;
+	while ((tags & (1u << bit)) == 0)
+		++bit;
+
+	size_t found = 0;
+
+	for (auto it = tagBuckets[bit].begin(); it != tagBuckets[bit].end(); ++it)
+	{
+		if (!(*it)->IsDestroyed() && (*it)->HasTags(tags))
+		{
+			objectList.push_back(*it);
+			++found;
+		}
+	}
+
+	return found;
+}
+
+// Replaces the broadphase used to find potentially colliding pairs.
+// Params:
+//   broadphase = The new broadphase. The object manager takes ownership of it.
+void GameObjectManager::SetBroadphase(Broadphase* broadphase_)
+{
+	if (broadphase == broadphase_)
+		return;
+
+	delete broadphase;
+	broadphase = broadphase_;
+}
+
+// Returns the broadphase used to find potentially colliding pairs.
+Broadphase* GameObjectManager::GetBroadphase() const
+{
+	return broadphase;
+}
+
+// Sets whether removing destroyed objects keeps the remaining objects in order.
+//   Unordered removal is cheaper, but changes the order objects are updated and drawn in.
+// Params:
+//   ordered = Whether destruction should keep objects in order (the default).
+void GameObjectManager::SetOrderedDestruction(bool ordered)
+{
+	orderedDestruction = ordered;
+}
+
+// Sets how many destroyed objects are deleted each frame. Destroyed objects are always
+//   removed from the active list right away, but deleting them can be spread across frames.
+// Params:
+//   objectsPerFrame = The maximum number of objects to delete per frame, or 0 to delete them immediately (the default).
+void GameObjectManager::SetReclaimBudget(unsigned objectsPerFrame)
+{
+	reclaimBudget = objectsPerFrame;
+}
+
+// Sets whether the transforms and physics components of active objects are kept in contiguous
+//   arrays and integrated in a single sweep. Must be called while there are no active objects.
+// Params:
+//   enabled = Whether to use physics storage (off by default).
+void GameObjectManager::SetPhysicsStorage(bool enabled)
+{
+	if (enabled && physicsStorage == nullptr)
+	{
+		physicsStorage = new PhysicsStorage();
+	}
+	else if (!enabled && physicsStorage != nullptr)
 	{
-		// If the object is not destroyed and its name matches the search, increment count.
-		if (!(*it)->IsDestroyed() && (*it)->GetName() == objectName)
-			++count;
+		delete physicsStorage;
+		physicsStorage = nullptr;
 	}
+}
 
-	return count;
+// Returns the physics storage of active objects, or nullptr if it is not in use.
+PhysicsStorage* GameObjectManager::GetPhysicsStorage() const
+{
+	return physicsStorage;
+}
+
+// Sets whether the narrowphase tests candidate pairs across the thread pool or on the main thread.
+//   Events are sent in pair order either way, so both give the same contacts and events.
+// Params:
+//   parallel = Whether to use the thread pool (the default).
+void GameObjectManager::SetParallelNarrowphase(bool parallel)
+{
+	parallelNarrowphase = parallel;
 }
 
 // Update object logic using variable timestep.
@@ -205,6 +474,10 @@ void GameObjectManager::FixedUpdate(float dt)
 	// Call the FixedUpdate functions the appropriate amount of times.
 	while (timeAccumulator >= fixedUpdateDt)
 	{
+		// Bodies in the physics storage are integrated together, before the other fixed updates.
+		if (physicsStorage != nullptr)
+			physicsStorage->Integrate(fixedUpdateDt);
+
 		for (size_t i = 0; i < gameObjectActiveList.size(); i++)
 		{
 			gameObjectActiveList[i]->FixedUpdate(fixedUpdateDt);
@@ -219,19 +492,110 @@ void GameObjectManager::FixedUpdate(float dt)
 // Destroy any objects marked for destruction.
 void GameObjectManager::DestroyObjects()
 {
-	for (auto it = gameObjectActiveList.begin(); it != gameObjectActiveList.end();)
+	// Take destroyed objects out of the active list in a single pass.
+	if (orderedDestruction)
 	{
-		// If the object is destroyed, delete it and erase it from the vector.
-		if ((*it)->IsDestroyed())
+		size_t count = 0;
+		for (size_t i = 0; i < gameObjectActiveList.size(); ++i)
 		{
-			delete *it;
-			it = gameObjectActiveList.erase(it);
+			if (gameObjectActiveList[i]->IsDestroyed())
+				destroyedObjects.push_back(gameObjectActiveList[i]);
+			else
+				gameObjectActiveList[count++] = gameObjectActiveList[i];
 		}
-		else
+		gameObjectActiveList.resize(count);
+	}
+	else
+	{
+		for (size_t i = 0; i < gameObjectActiveList.size();)
 		{
-			++it;
+			// Fill the hole with the last object, which still needs to be checked.
+			if (gameObjectActiveList[i]->IsDestroyed())
+			{
+				destroyedObjects.push_back(gameObjectActiveList[i]);
+				gameObjectActiveList[i] = gameObjectActiveList.back();
+				gameObjectActiveList.pop_back();
+			}
+			else
+			{
+				++i;
+			}
 		}
 	}
+
+	if (destroyedObjects.empty())
+		return;
+
+	std::vector<const Collider*> removedColliders;
+	std::vector<unsigned> removedNames;
+	unsigned removedTags = 0;
+
+	for (auto it = destroyedObjects.begin(); it != destroyedObjects.end(); ++it)
+	{
+		const Collider* collider = (*it)->GetComponent<Collider>();
+		if (collider != nullptr)
+			removedColliders.push_back(collider);
+
+		removedNames.push_back((*it)->nameId);
+		removedTags |= (*it)->tags;
+
+		UnbindPhysics(**it);
+		FreeHandle(**it);
+	}
+
+	// Stop tracking collisions for destroyed objects before they are deleted.
+	if (!removedColliders.empty())
+		RemoveColliders(removedColliders);
+
+	// Take the destroyed objects out of every index they are in.
+	std::sort(removedNames.begin(), removedNames.end());
+	removedNames.erase(std::unique(removedNames.begin(), removedNames.end()), removedNames.end());
+	for (auto it = removedNames.begin(); it != removedNames.end(); ++it)
+		RemoveDestroyedObjects(nameBuckets[*it].objects);
+
+	for (unsigned i = 0; i < maxTags; ++i)
+	{
+		if (removedTags & (1u << i))
+			RemoveDestroyedObjects(tagBuckets[i]);
+	}
+
+	// The objects no longer belong to the manager, so they can be deleted whenever is convenient.
+	for (auto it = destroyedObjects.begin(); it != destroyedObjects.end(); ++it)
+	{
+		(*it)->manager = nullptr;
+		reclaimQueue.push_back(*it);
+	}
+
+	destroyedObjects.clear();
+
+	if (reclaimBudget == 0)
+		ReclaimObjects(reclaimQueue.size());
+}
+
+// Delete destroyed objects that are waiting to be reclaimed.
+// Params:
+//   maxObjects = The maximum number of objects to delete.
+void GameObjectManager::ReclaimObjects(size_t maxObjects)
+{
+	for (size_t i = 0; i < maxObjects && !reclaimQueue.empty(); ++i)
+	{
+		ReleaseObject(reclaimQueue.back());
+		reclaimQueue.pop_back();
+	}
+}
+
+// Returns an object to its archetype's pool, or deletes it if it does not belong to one.
+// Params:
+//   gameObject = The object being released. It must not be in the active list.
+void GameObjectManager::ReleaseObject(GameObject* gameObject)
+{
+	if (gameObject->archetype == nullptr)
+	{
+		delete gameObject;
+		return;
+	}
+
+	objectPools[gameObject->archetype].objects.push_back(gameObject);
 }
 
 // Draw all game objects in the active game object list.
@@ -246,7 +610,10 @@ void GameObjectManager::Draw(void)
 // Check for collisions between each pair of objects.
 void GameObjectManager::CheckCollisions()
 {
-	// Iterate over every object.
+	collisionProxies.clear();
+	collisionPairs.clear();
+
+	// Gather the collider of every object once per step.
 	for (size_t i = 0; i < gameObjectActiveList.size(); i++)
 	{
 		// If the current object is marked for destruction, skip it.
@@ -260,24 +627,328 @@ void GameObjectManager::CheckCollisions()
 		if (collider == nullptr)
 			continue;
 
-		// Iterate over all remaining objects.
-		for (size_t j = i + 1; j < gameObjectActiveList.size(); j++)
+		// Computing the bounds also brings the transform's matrix and the collider's cached
+		//   world-space shape up to date, so the narrowphase below only reads them.
+		BroadphaseProxy proxy(collider);
+		proxy.bounded = collider->GetBounds(proxy.min, proxy.max);
+		collisionProxies.push_back(proxy);
+	}
+
+	// Let the broadphase cull pairs that cannot possibly be touching.
+	broadphase->FindPairs(collisionProxies, collisionPairs);
+
+	// Run the shape tests across the thread pool. Each pair has its own result slot, so the
+	//   results are already in pair order once every batch is done.
+	pairResults.resize(collisionPairs.size());
+	if (parallelNarrowphase)
+		ThreadPool::GetInstance().ParallelFor(collisionPairs.size(), NarrowphaseBatchSize, NarrowphaseBatch, this);
+	else
+		NarrowphaseBatch(this, 0, collisionPairs.size());
+
+	newContacts.clear();
+
+	// Send events on the main thread in pair order, which keeps gameplay deterministic.
+	for (size_t i = 0; i < collisionPairs.size(); ++i)
+	{
+		Collider* collider = collisionProxies[collisionPairs[i].first].collider;
+		Collider* collider2 = collisionProxies[collisionPairs[i].second].collider;
+
+		// Earlier collision handlers may have destroyed either object.
+		if (collider->GetOwner()->IsDestroyed() || collider2->GetOwner()->IsDestroyed())
+			continue;
+
+		bool wasColliding = std::binary_search(contactKeys.begin(), contactKeys.end(), GetContactKey(collider, collider2));
+
+		if (pairResults[i] == PAIR_DEFERRED)
+		{
+			// Check for collisions between the two objects now that earlier pairs have been resolved.
+			if (collider->CheckCollision(*collider2, wasColliding))
+				newContacts.push_back(CollisionContact(collider, collider2));
+		}
+		else if (pairResults[i] == PAIR_TOUCHING)
+		{
+			collider->SendCollisionEvents(*collider2, wasColliding);
+			newContacts.push_back(CollisionContact(collider, collider2));
+		}
+	}
+
+	newContactKeys.clear();
+	for (auto it = newContacts.begin(); it != newContacts.end(); ++it)
+		newContactKeys.push_back(GetContactKey(it->first, it->second));
+	std::sort(newContactKeys.begin(), newContactKeys.end());
+
+	// Send exit events for contacts from the last step that did not happen again.
+	for (auto it = contacts.begin(); it != contacts.end(); ++it)
+	{
+		if (it->first->GetOwner()->IsDestroyed() || it->second->GetOwner()->IsDestroyed())
+			continue;
+
+		if (!std::binary_search(newContactKeys.begin(), newContactKeys.end(), GetContactKey(it->first, it->second)))
+			it->first->EndCollision(*it->second);
+	}
+
+	contacts.swap(newContacts);
+	contactKeys.swap(newContactKeys);
+}
+
+// Tests one batch of candidate pairs, writing each pair's result to its own slot. Called by the thread pool.
+// Params:
+//   context = The object manager.
+//   begin = The first pair in the batch.
+//   end = One past the last pair in the batch.
+void GameObjectManager::NarrowphaseBatch(void* context, size_t begin, size_t end)
+{
+	GameObjectManager* manager = static_cast<GameObjectManager*>(context);
+	for (size_t i = begin; i < end; ++i)
+	{
+		const Collider* collider = manager->collisionProxies[manager->collisionPairs[i].first].collider;
+		const Collider* collider2 = manager->collisionProxies[manager->collisionPairs[i].second].collider;
+
+		if (collider->HasCollisionSideEffects() || collider2->HasCollisionSideEffects())
+			manager->pairResults[i] = PAIR_DEFERRED;
+		else if (collider->CanCollideWith(*collider2) && collider->IsCollidingWith(*collider2))
+			manager->pairResults[i] = PAIR_TOUCHING;
+		else
+			manager->pairResults[i] = PAIR_SEPARATE;
+	}
+}
+
+// Stop tracking collisions for colliders whose objects are about to be deleted.
+// Params:
+//   colliders = The colliders being removed.
+void GameObjectManager::RemoveColliders(std::vector<const Collider*>& colliders)
+{
+	for (auto it = colliders.begin(); it != colliders.end(); ++it)
+		broadphase->RemoveCollider(**it);
+
+	std::sort(colliders.begin(), colliders.end());
+
+	// Forget any contacts involving the removed colliders.
+	size_t count = 0;
+	for (size_t i = 0; i < contacts.size(); ++i)
+	{
+		if (!std::binary_search(colliders.begin(), colliders.end(), contacts[i].first)
+			&& !std::binary_search(colliders.begin(), colliders.end(), contacts[i].second))
+		{
+			contacts[count++] = contacts[i];
+		}
+	}
+	contacts.resize(count);
+
+	contactKeys.clear();
+	for (auto it = contacts.begin(); it != contacts.end(); ++it)
+		contactKeys.push_back(GetContactKey(it->first, it->second));
+	std::sort(contactKeys.begin(), contactKeys.end());
+}
+
+// Make a key that identifies a contact regardless of the order of its colliders.
+std::pair<const Collider*, const Collider*> GameObjectManager::GetContactKey(const Collider* first, const Collider* second)
+{
+	if (std::less<const Collider*>()(second, first))
+		std::swap(first, second);
+
+	return std::make_pair(first, second);
+}
+
+// Returns the ID of a name, assigning a new one if the name has not been seen before.
+// Params:
+//   objectName = The name to intern.
+unsigned GameObjectManager::InternName(const std::string& objectName)
+{
+	auto found = nameIds.find(objectName);
+	if (found != nameIds.end())
+		return found->second;
+
+	unsigned nameId = static_cast<unsigned>(nameBuckets.size());
+	nameIds.insert(std::make_pair(objectName, nameId));
+
+	NameBucket nameBucket;
+	nameBucket.liveCount = 0;
+	nameBuckets.push_back(nameBucket);
+
+	return nameId;
+}
+
+// Returns the bucket of objects with the given name, or nullptr if the name has never been added.
+// Params:
+//   objectName = The name to look up.
+const GameObjectManager::NameBucket* GameObjectManager::FindNameBucket(const std::string& objectName) const
+{
+	auto found = nameIds.find(objectName);
+	if (found == nameIds.end())
+		return nullptr;
+
+	return &nameBuckets[found->second];
+}
+
+// Adds an object to the active list and its indices, without initializing it.
+// Params:
+//   gameObject = The object being added.
+void GameObjectManager::ActivateObject(GameObject& gameObject)
+{
+	gameObjectActiveList.push_back(&gameObject);
+	gameObject.SetParent(GetParent());
+
+	// Index the object before initializing it, as its components may look it up, destroy it, or change its tags.
+	gameObject.manager = this;
+	gameObject.nameId = InternName(gameObject.GetName());
+
+	NameBucket& nameBucket = nameBuckets[gameObject.nameId];
+	nameBucket.objects.push_back(&gameObject);
+	if (!gameObject.IsDestroyed())
+		++nameBucket.liveCount;
+
+	for (unsigned i = 0; i < maxTags; ++i)
+	{
+		if (gameObject.tags & (1u << i))
+			tagBuckets[i].push_back(&gameObject);
+	}
+}
+
+// Adds every queued object to the active list, then initializes them grouped by name, so
+//   objects cloned from the same archetype are initialized together.
+void GameObjectManager::FlushSpawnQueue()
+{
+	if (spawnQueue.empty())
+		return;
+
+	// Take the queue first, as objects may spawn more objects while they are initialized.
+	spawnBatch.swap(spawnQueue);
+
+	// Objects join the list in the order they were added, so they still update and draw in that order.
+	gameObjectActiveList.reserve(gameObjectActiveList.size() + spawnBatch.size());
+	for (auto it = spawnBatch.begin(); it != spawnBatch.end(); ++it)
+		ActivateObject(**it);
+
+	std::stable_sort(spawnBatch.begin(), spawnBatch.end(), NameIdLess);
+
+	for (auto it = spawnBatch.begin(); it != spawnBatch.end(); ++it)
+		(*it)->Initialize();
+
+	spawnBatch.clear();
+}
+
+// Checks whether one object's name was interned before another's.
+bool GameObjectManager::NameIdLess(const GameObject* a, const GameObject* b)
+{
+	return a->nameId < b->nameId;
+}
+
+// Assigns a handle to an object entering the active list. Once every slot index is in use,
+//   the object is given the null handle instead.
+// Params:
+//   gameObject = The object being added.
+void GameObjectManager::AllocateHandle(GameObject& gameObject)
+{
+	unsigned index;
+	if (freeHandleSlots.empty())
+	{
+		// Handles only have room for so many slot indices. Objects past the limit keep the null handle,
+		//   so they still work, but can never be found through a handle.
+		if (handleSlots.size() > GameObjectHandle::indexMask)
 		{
-			// If the current object is marked for destruction, skip it.
-			if (gameObjectActiveList[j]->IsDestroyed())
-				continue;
+			assert(!"Too many active objects for the index bits of a game object handle.");
+			gameObject.handle = GameObjectHandle();
+			return;
+		}
+
+		index = static_cast<unsigned>(handleSlots.size());
+
+		HandleSlot slot = { nullptr, 1 };
+		handleSlots.push_back(slot);
+	}
+	else
+	{
+		index = freeHandleSlots.back();
+		freeHandleSlots.pop_back();
+	}
+
+	handleSlots[index].object = &gameObject;
+	gameObject.handle = GameObjectHandle(index, handleSlots[index].generation);
+}
+
+// Invalidates the handle of an object leaving the active list.
+// Params:
+//   gameObject = The object being removed.
+void GameObjectManager::FreeHandle(GameObject& gameObject)
+{
+	if (gameObject.handle.IsNull())
+		return;
+
+	const unsigned index = gameObject.handle.GetIndex();
+	HandleSlot& slot = handleSlots[index];
+	slot.object = nullptr;
 
-			// Get the current object's collider.
-			Collider* collider2 = gameObjectActiveList[j]->GetComponent<Collider>();
+	// Generations wrap around within the handle's bits, skipping 0 so no handle is ever null by accident.
+	slot.generation = (slot.generation + 1) & GameObjectHandle::generationMask;
+	if (slot.generation == 0)
+		slot.generation = 1;
 
-			// If the current object does not have a collider, skip it.
-			if (collider2 == nullptr)
-				continue;
+	freeHandleSlots.push_back(index);
+	gameObject.handle = GameObjectHandle();
+}
+
+// Called by a game object in the active list when it is marked for destruction.
+// Params:
+//   gameObject = The object that was destroyed.
+void GameObjectManager::OnObjectDestroyed(GameObject& gameObject)
+{
+	--nameBuckets[gameObject.nameId].liveCount;
+}
 
-			// Check for collisions between the two objects.
-			collider->CheckCollision(*collider2);
+// Called by a game object in the active list when its tags change.
+// Params:
+//   gameObject = The object whose tags changed.
+//   oldTags = The object's tags before the change.
+void GameObjectManager::OnTagsChanged(GameObject& gameObject, unsigned oldTags)
+{
+	for (unsigned i = 0; i < maxTags; ++i)
+	{
+		const unsigned tag = 1u << i;
+		if ((oldTags & tag) == (gameObject.tags & tag))
+			continue;
+
+		std::vector<GameObject*>& tagBucket = tagBuckets[i];
+		if (gameObject.tags & tag)
+		{
+			tagBucket.push_back(&gameObject);
+		}
+		else
+		{
+			tagBucket.erase(std::find(tagBucket.begin(), tagBucket.end(), &gameObject));
 		}
 	}
 }
 
+// Removes destroyed objects from a list, keeping the rest in order.
+// Params:
+//   objects = The list to remove destroyed objects from.
+void GameObjectManager::RemoveDestroyedObjects(std::vector<GameObject*>& objects)
+{
+	size_t count = 0;
+	for (size_t i = 0; i < objects.size(); ++i)
+	{
+		if (!objects[i]->IsDestroyed())
+			objects[count++] = objects[i];
+	}
+	objects.resize(count);
+}
+
+// Moves an object's transform and physics state out of the physics storage, if it is in use.
+// Params:
+//   gameObject = The object that is leaving the active list.
+void GameObjectManager::UnbindPhysics(GameObject& gameObject)
+{
+	if (physicsStorage == nullptr)
+		return;
+
+	Physics* physics = gameObject.GetComponent<Physics>();
+	if (physics != nullptr)
+		physicsStorage->RemovePhysics(*physics);
+
+	Transform* transform = gameObject.GetComponent<Transform>();
+	if (transform != nullptr)
+		physicsStorage->RemoveTransform(*transform);
+}
+
 //------------------------------------------------------------------------------
@@ -195,30 +195,23 @@ void ApplyTransformToPoints(const CS230::Matrix2D& matrix, Vector2D* points, uns
 //   True if intersection, false otherwise.
 bool OBBOBBIntersection(const ColliderRectangle& rect1, const ColliderRectangle& rect2)
 {
-	float angle1 = rect1.transform->GetRotation();
-	float angle2 = rect2.transform->GetRotation();
-
-	Vector2D axes[4];
+	// The corners and axes are cached by the colliders until their transforms change.
+	return OBBOBBIntersection(rect1.GetWorldShape(), rect2.GetWorldShape());
+}
 
+// Check whether two oriented bounding boxes intersect.
+// Params:
+//  obb1 = The corners and axes of the first box.
+//	obb2 = The corners and axes of the second box.
+// Returns:
+//   True if intersection, false otherwise.
+bool OBBOBBIntersection(const OBBShape& obb1, const OBBShape& obb2)
+{
 	// Calculate all the axes we need to check for gaps along.
-	axes[0] = Vector2D(cos(angle1), sin(angle1));
-	axes[1] = Vector2D(-axes[0].y, axes[0].x);
-	axes[2] = Vector2D(cos(angle2), sin(angle2));
-	axes[3] = Vector2D(-axes[2].y, axes[2].x);
-
-	Vector2D points1[4];
-	Vector2D points2[4];
-
-	// Gather the points for both rectangles.
-	GetOBBCorners(rect1, points1);
-	GetOBBCorners(rect2, points2);
-
-	// Apply the transformation matrices to the rectangles' points.
-	ApplyTransformToPoints(rect1.transform->GetMatrix(), points1, 4);
-	ApplyTransformToPoints(rect2.transform->GetMatrix(), points2, 4);
+	Vector2D axes[4] = { obb1.axes[0], obb1.axes[1], obb2.axes[0], obb2.axes[1] };
 
 	// Perform the intersection test.
-	return SATIntersection(axes, 4, points1, 4, points2, 4);
+	return SATIntersection(axes, 4, obb1.corners, 4, obb2.corners, 4);
 }
 
 // Check whether an oriented bounding box and a point intersect.
@@ -229,25 +222,17 @@ bool OBBOBBIntersection(const ColliderRectangle& rect1, const ColliderRectangle&
 //   True if intersection, false otherwise.
 bool OBBPointIntersection(const ColliderRectangle& rect, const Vector2D& point)
 {
-	float angle1 = rect.transform->GetRotation();
+	const OBBShape& obb = rect.GetWorldShape();
 
 	Vector2D axes[3];
 
 	// Calculate all the axes we need to check for gaps along.
-	axes[0] = Vector2D(cos(angle1), sin(angle1));
-	axes[1] = Vector2D(-axes[0].y, axes[0].x);
+	axes[0] = obb.axes[0];
+	axes[1] = obb.axes[1];
 	axes[2] = (point - rect.transform->GetTranslation()).Normalized(); // Direction from the rectangle to the point
 
-	Vector2D points[4];
-
-	// Gather the points for the rectangle.
-	GetOBBCorners(rect, points);
-
-	// Apply the transformation matrix to the rectangle's points.
-	ApplyTransformToPoints(rect.transform->GetMatrix(), points, 4);
-
 	// Perform the intersection test.
-	return SATIntersection(axes, 3, points, 4, &point, 1);
+	return SATIntersection(axes, 3, obb.corners, 4, &point, 1);
 }
 
 // Check whether an oriented bounding box and a circle intersect.
@@ -258,25 +243,17 @@ bool OBBPointIntersection(const ColliderRectangle& rect, const Vector2D& point)
 //   True if intersection, false otherwise.
 bool OBBCircleIntersection(const ColliderRectangle& rect, const Circle& circle)
 {
-	float angle1 = rect.transform->GetRotation();
+	const OBBShape& obb = rect.GetWorldShape();
 
 	Vector2D axes[3];
 
 	// Calculate all the axes we need to check for gaps along.
-	axes[0] = Vector2D(cos(angle1), sin(angle1));
-	axes[1] = Vector2D(-axes[0].y, axes[0].x);
+	axes[0] = obb.axes[0];
+	axes[1] = obb.axes[1];
 	axes[2] = (circle.center - rect.transform->GetTranslation()).Normalized(); // Direction from the rectangle to the circle
 
-	Vector2D points[4];
-
-	// Gather the points for the rectangle.
-	GetOBBCorners(rect, points);
-	
-	// Apply the transformation matrix to the rectangle's points.
-	ApplyTransformToPoints(rect.transform->GetMatrix(), points, 4);
-
 	// Perform the intersection test.
-	return SATIntersection(axes, 3, points, 4, &circle.center, 1, circle.radius);
+	return SATIntersection(axes, 3, obb.corners, 4, &circle.center, 1, circle.radius);
 }
 
 // Projects a polygon into a normal
@@ -303,136 +280,78 @@ void ProjectPolygon(const Vector2D& normal, const std::vector<Vector2D>& vertice
 
 // Check whether two convex polygons interact
 // Params:
-//	lineSegments1: The first convex polygon
-//	lineSegments2: The second convex polygon
+//	polygon1: The world-space vertices and normals of the first convex polygon
+//	polygon2: The world-space vertices and normals of the second convex polygon
 // Returns:
 //	True if intersection, false otherwise
-bool ConvexHullIntersection(const std::vector<LineSegment>& lineSegments1, const std::vector<LineSegment>& lineSegments2)
+bool ConvexHullIntersection(const ConvexPolygon& polygon1, const ConvexPolygon& polygon2)
 {
-	// Save the vertices and normals of both line segments
-	std::vector<Vector2D> vertexSet1;
-	std::vector<Vector2D> vertexSet2;
-	std::vector<Vector2D> normalSet;
-	size_t totalSize = lineSegments1.size() + lineSegments2.size();
-	vertexSet1.reserve(totalSize);
-	vertexSet2.reserve(totalSize);
-	normalSet.reserve(totalSize);
-
-	for (unsigned i = 0; i < totalSize; ++i)
-	{
-		if (i < lineSegments1.size())
-		{
-			vertexSet1.push_back(lineSegments1[i].end);
-			for (unsigned j = 0; j < i; ++j)
-			{
-				if (lineSegments1[i].normal.DotProduct(normalSet[j]) == 0)
-					continue;
-			}
-			normalSet.push_back(lineSegments1[i].normal);
-		}
-		else
-		{
-			vertexSet2.push_back(lineSegments2[i - lineSegments1.size()].end);
-			for (size_t j = i - lineSegments1.size(); j < normalSet.size(); ++j)
-			{
-				if (lineSegments2[i - lineSegments1.size()].normal.DotProduct(normalSet[j]) == 0)
-					continue;
-			}
-			normalSet.push_back(lineSegments2[i - lineSegments1.size()].normal);
-		}
-	}
-
-	return SATIntersection(normalSet.data(), normalSet.size(), vertexSet1.data(), vertexSet1.size(), vertexSet2.data(), vertexSet2.size());
+	// Check for gaps along the normals of both polygons
+	Vector2D normalSet[2 * ConvexPolygon::maxVertices];
+	unsigned normalCount = 0;
+	for (unsigned i = 0; i < polygon1.count; ++i)
+		normalSet[normalCount++] = polygon1.normals[i];
+	for (unsigned i = 0; i < polygon2.count; ++i)
+		normalSet[normalCount++] = polygon2.normals[i];
+
+	return SATIntersection(normalSet, normalCount, polygon1.vertices, polygon1.count, polygon2.vertices, polygon2.count);
 }
 
-// Check whether a convex polygon interacts with a rectangle collider
+// Check whether a convex polygon interacts with an oriented bounding box
 //	Params:
-//	convexSegments: The line segments of the convex polygon
-//	extents: The extents of the rectangle
-bool ConvexHullToOBBIntersection(const std::vector<LineSegment>& convexSegments, const Vector2D& extents, Transform& rectTransform)
+//	polygon: The world-space vertices and normals of the convex polygon
+//	obb: The corners and axes of the box
+// Returns:
+//	True if interesction, false otherwise
+bool ConvexHullToOBBIntersection(const ConvexPolygon& polygon, const OBBShape& obb)
 {
-	// Create the line segments so that they are rotated but not scaled
-	// The horizontal end is the same as the vertical side's start
-	Vector2D topLeft(-extents.x, extents.y);
-	Vector2D topRight(extents);
-	Vector2D bottomRight(extents.x, -extents.y);
-	Vector2D bottomLeft(-extents);
-
-	// Transform the vertices by the rotation but also scale them back
-	Vector2D translation = rectTransform.GetTranslation();
-	CS230::Matrix2D matrix = CS230::Matrix2D::RotationMatrixRadians(rectTransform.GetRotation()) * CS230::Matrix2D::TranslationMatrix(translation.x, translation.y);
-	topLeft = matrix * topLeft;
-	topRight = matrix * topRight;
-	bottomRight = matrix * bottomRight;
-	bottomLeft = matrix * bottomLeft;
-
-	// Construct a convex hull out of the extents of the circle
-	std::vector<LineSegment> extentSegments;
-	// Because a rectangle has two pairs of parallel sides, then we only need to check for those two sides, lol.
-	extentSegments.reserve(4);
-	extentSegments.push_back(LineSegment(topLeft, topRight));
-	extentSegments.push_back(LineSegment(topRight, bottomRight));
-	extentSegments.push_back(LineSegment(bottomRight, bottomLeft));
-	extentSegments.push_back(LineSegment(bottomLeft, topLeft));
-	// Finally create the 
-	// Then, just use the convex hull collision detection algorithm already written
-	return ConvexHullIntersection(convexSegments, extentSegments);
+	// Because a rectangle has two pairs of parallel sides, then we only need to check its two axes, lol.
+	Vector2D normalSet[ConvexPolygon::maxVertices + 2];
+	unsigned normalCount = 0;
+	for (unsigned i = 0; i < polygon.count; ++i)
+		normalSet[normalCount++] = polygon.normals[i];
+	normalSet[normalCount++] = obb.axes[0];
+	normalSet[normalCount++] = obb.axes[1];
+
+	return SATIntersection(normalSet, normalCount, polygon.vertices, polygon.count, obb.corners, 4);
 }
 
 // Check whether a circle is colliding with the convex collider
 //	Params:
-//	convexSegments: The line segments of the convex polygon
+//	polygon: The world-space vertices and normals of the convex polygon
 //	convexTransform: The transform of the convex figure
 //	circle: The circle we are testing against
 // Returns:
 //	True if intersection, false otherwise
-bool ConvexHullToCircleInteresction(const std::vector<LineSegment>& convexSegments, const Transform& convexTransform, const Circle& circle)
+bool ConvexHullToCircleInteresction(const ConvexPolygon& polygon, const Transform& convexTransform, const Circle& circle)
 {
-	// Separate our segments into vertices and normals
-	std::vector<Vector2D> vertexSet;
-	std::vector<Vector2D> normalSet;
-	vertexSet.reserve(convexSegments.size());
-	normalSet.reserve(convexSegments.size() + 3);
-	for (auto begin = convexSegments.cbegin(); begin < convexSegments.cend(); ++begin)
-	{
-		vertexSet.push_back(begin->end);
-		normalSet.push_back(begin->normal);
-	}
+	Vector2D normalSet[ConvexPolygon::maxVertices + 3];
+	unsigned normalCount = 0;
+	for (unsigned i = 0; i < polygon.count; ++i)
+		normalSet[normalCount++] = polygon.normals[i];
 
 	// Add the three normals that come from the circle
 	// One from the rotation of the convex shape
 	Vector2D circleTangent(cosf(convexTransform.GetRotation()), sinf(convexTransform.GetRotation()));
-	normalSet.push_back(circleTangent);
+	normalSet[normalCount++] = circleTangent;
 	// One that is perpendicular to the tangent
-	normalSet.push_back(Vector2D(-circleTangent.y, circleTangent.x));
+	normalSet[normalCount++] = Vector2D(-circleTangent.y, circleTangent.x);
 	// One that goes from the middle of the circle to the middle of the convex
-	normalSet.push_back((convexTransform.GetTranslation() - circle.center).Normalized());
+	normalSet[normalCount++] = (convexTransform.GetTranslation() - circle.center).Normalized();
 
 	// Test the collisions
-	return SATIntersection(normalSet.data(), normalSet.size(), vertexSet.data(), vertexSet.size(), &circle.center, 1, circle.radius);
+	return SATIntersection(normalSet, normalCount, polygon.vertices, polygon.count, &circle.center, 1, circle.radius);
 }
 
 // Checks whether a point is inside a convex shape
 // Params:
 //	point: The point we are testing
-//	convexSegments: The line segments of the convex polygon
+//	polygon: The world-space vertices and normals of the convex polygon
 // Returns:
 //	True if intersection, false otherwise
-bool ConvexHullToPointIntersection(const std::vector<LineSegment>& convexSegments, const Vector2D& point)
+bool ConvexHullToPointIntersection(const ConvexPolygon& polygon, const Vector2D& point)
 {
-	// Separate our segments into vertices and normals
-	std::vector<Vector2D> vertexSet;
-	std::vector<Vector2D> normalSet;
-	vertexSet.reserve(convexSegments.size());
-	normalSet.reserve(convexSegments.size());
-	for (auto begin = convexSegments.cbegin(); begin < convexSegments.cend(); ++begin)
-	{
-		vertexSet.push_back(begin->end);
-		normalSet.push_back(begin->normal);
-	}
-
-	// Then test for intersection
-	return SATIntersection(normalSet.data(), normalSet.size(), vertexSet.data(), vertexSet.size(), &point, 1);
+	return SATIntersection(polygon.normals, polygon.count, polygon.vertices, polygon.count, &point, 1);
 }
 
 // Check whether a moving point and line intersect.
@@ -475,6 +394,88 @@ bool MovingPointLineIntersection(const LineSegment& staticLine, const LineSegmen
 	return true;
 }
 
+// Check whether a moving circle and line intersect, including the rounded ends of the line.
+// Params:
+//  staticLine   = Start and end of the line segment.
+//  movingCircle = Start and end positions of the circle's center.
+//  radius = The radius of the circle. A radius of zero gives the same result as MovingPointLineIntersection.
+//  intersection = The circle's center at the moment of contact, if any.
+//  t = The t value for the intersection.
+//  contactLine = A line through the intersection, parallel to the surface that was hit. Reflecting
+//    the circle's center over it bounces the circle off of the line.
+// Returns:
+//   True if intersection, false otherwise.
+bool MovingCircleLineIntersection(const LineSegment& staticLine, const LineSegment& movingCircle, float radius, Vector2D& intersection, float& t, LineSegment& contactLine)
+{
+	// Points are swept against the line itself.
+	if (radius <= 0.0f)
+	{
+		if (!MovingPointLineIntersection(staticLine, movingCircle, intersection, t))
+			return false;
+
+		contactLine = staticLine;
+		return true;
+	}
+
+	Vector2D velocity = movingCircle.end - movingCircle.start;
+	float a = velocity.MagnitudeSquared();
+	if (AlmostEqual(a, 0.0f))
+		return false;
+
+	bool intersected = false;
+
+	// The center touches the flat side when it crosses the line pushed out by the radius, toward the side the circle starts on.
+	//   A circle that starts closer to the line than its radius (after bouncing off an end, for example) is already past
+	//   the pushed out line, so it is stopped when its center reaches the line itself instead.
+	float side = staticLine.normal.DotProduct(movingCircle.start - staticLine.start);
+	Vector2D offset = staticLine.normal * (side < 0.0f ? -radius : radius);
+	LineSegment sideLine = fabsf(side) < radius ? staticLine : LineSegment(staticLine.start + offset, staticLine.end + offset);
+
+	// Only circles moving toward the line can hit its side.
+	Vector2D sideIntersection;
+	float sideT;
+	if (velocity.DotProduct(offset) < 0.0f && MovingPointLineIntersection(sideLine, movingCircle, sideIntersection, sideT))
+	{
+		intersection = sideIntersection;
+		t = sideT;
+		contactLine = sideLine;
+		intersected = true;
+	}
+
+	// The center touches an end of the line when it enters the circle of the same radius around that end.
+
+	const Vector2D* ends[2] = { &staticLine.start, &staticLine.end };
+	for (unsigned i = 0; i < 2; ++i)
+	{
+		Vector2D relativeStart = movingCircle.start - *ends[i];
+		float c = relativeStart.MagnitudeSquared() - radius * radius;
+
+		// Circles that already overlap the end are left alone, so they can move away from it.
+		if (c < 0.0f)
+			continue;
+
+		float b = 2.0f * relativeStart.DotProduct(velocity);
+		float discriminant = b * b - 4.0f * a * c;
+		if (discriminant < 0.0f)
+			continue;
+
+		float endT = (-b - sqrtf(discriminant)) / (2.0f * a);
+		if (endT < 0.0f || endT > 1.0f || (intersected && endT >= t))
+			continue;
+
+		// The surface at the contact is perpendicular to the direction from the end to the center.
+		Vector2D center = movingCircle.start + velocity * endT;
+		Vector2D normal = (center - *ends[i]).Normalized();
+
+		intersection = center;
+		t = endT;
+		contactLine = LineSegment(center, center + Vector2D(-normal.y, normal.x));
+		intersected = true;
+	}
+
+	return intersected;
+}
+
 // Checks whether a point is between two parallel lines.
 // Params:
 //   point = The point in question.
@@ -0,0 +1,515 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	IntersectionBatch2D.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "IntersectionBatch2D.h"
+
+// Systems
+#include "Intersection2D.h"
+#include <cfloat>
+#include <intrin.h>
+
+// Components
+#include "ColliderRectangle.h"
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Private Variables:
+//------------------------------------------------------------------------------
+
+IntersectionBatch::InstructionSet IntersectionBatch::instructionSet = IntersectionBatch::GetSupportedInstructionSet();
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// Gets the instructions the batch tests are run with. Defaults to the widest set the processor supports.
+IntersectionBatch::InstructionSet IntersectionBatch::GetInstructionSet()
+{
+	return instructionSet;
+}
+
+// Sets the instructions the batch tests are run with, such as to compare them against each other.
+// Params:
+//   instructionSet = The instructions to use. Sets the processor does not support fall back to the widest one it does.
+void IntersectionBatch::SetInstructionSet(InstructionSet instructionSet_)
+{
+	instructionSet = min(instructionSet_, GetSupportedInstructionSet());
+}
+
+// Gets the widest instruction set the processor supports.
+IntersectionBatch::InstructionSet IntersectionBatch::GetSupportedInstructionSet()
+{
+	static const InstructionSet supported = DetectInstructionSet();
+	return supported;
+}
+
+// Check whether a circle intersects each of an array of circles.
+// Params:
+//   circle = The circle to test.
+//   circles = The circles to test against.
+//   results = Receives 1 for each circle that intersects, or 0. Must have room for circles.count values.
+// Returns:
+//   How many circles intersect.
+size_t IntersectionBatch::CircleCircleIntersection(const Circle& circle, const CircleArrays& circles, unsigned char* results)
+{
+	size_t count = 0;
+	size_t tested = 0;
+
+	if (instructionSet == INSTRUCTIONS_AVX2)
+	{
+		tested = circles.count - circles.count % 8;
+		count += CircleCircleAVX2(circle, circles, 0, tested, results);
+	}
+	else if (instructionSet == INSTRUCTIONS_SSE2)
+	{
+		tested = circles.count - circles.count % 4;
+		count += CircleCircleSSE2(circle, circles, 0, tested, results);
+	}
+
+	// Test the circles left over at the end one at a time.
+	return count + CircleCircleScalar(circle, circles, tested, circles.count, results);
+}
+
+// Check whether a rectangle intersects each of an array of rectangles.
+// Params:
+//   rect = The rectangle to test.
+//   rects = The rectangles to test against.
+//   results = Receives 1 for each rectangle that intersects, or 0. Must have room for rects.count values.
+// Returns:
+//   How many rectangles intersect.
+size_t IntersectionBatch::RectangleRectangleIntersection(const BoundingRectangle& rect, const RectangleArrays& rects, unsigned char* results)
+{
+	size_t count = 0;
+	size_t tested = 0;
+
+	if (instructionSet == INSTRUCTIONS_AVX2)
+	{
+		tested = rects.count - rects.count % 8;
+		count += RectangleRectangleAVX2(rect, rects, 0, tested, results);
+	}
+	else if (instructionSet == INSTRUCTIONS_SSE2)
+	{
+		tested = rects.count - rects.count % 4;
+		count += RectangleRectangleSSE2(rect, rects, 0, tested, results);
+	}
+
+	// Test the rectangles left over at the end one at a time.
+	return count + RectangleRectangleScalar(rect, rects, tested, rects.count, results);
+}
+
+// Check whether an oriented bounding box intersects each of an array of oriented bounding boxes.
+// Params:
+//   obb = The box to test.
+//   obbs = The boxes to test against.
+//   results = Receives 1 for each box that intersects, or 0. Must have room for obbs.count values.
+// Returns:
+//   How many boxes intersect.
+size_t IntersectionBatch::OBBOBBIntersection(const OBBShape& obb, const OBBArrays& obbs, unsigned char* results)
+{
+	size_t count = 0;
+	size_t tested = 0;
+
+	if (instructionSet == INSTRUCTIONS_AVX2)
+	{
+		tested = obbs.count - obbs.count % 8;
+		count += OBBOBBAVX2(obb, obbs, 0, tested, results);
+	}
+	else if (instructionSet == INSTRUCTIONS_SSE2)
+	{
+		tested = obbs.count - obbs.count % 4;
+		count += OBBOBBSSE2(obb, obbs, 0, tested, results);
+	}
+
+	// Test the boxes left over at the end one at a time.
+	return count + OBBOBBScalar(obb, obbs, tested, obbs.count, results);
+}
+
+// Calculates the world-space corners and axes of a rectangle collider, the same way OBBOBBIntersection does.
+// Params:
+//   rect = The rectangle collider.
+//   obb = Receives the corners and axes.
+void IntersectionBatch::GetOBBShape(const ColliderRectangle& rect, OBBShape& obb)
+{
+	obb = rect.GetWorldShape();
+}
+
+//------------------------------------------------------------------------------
+// Private Functions:
+//------------------------------------------------------------------------------
+
+// Tests the circles in [begin, end) one at a time, returning how many intersect.
+size_t IntersectionBatch::CircleCircleScalar(const Circle& circle, const CircleArrays& circles, size_t begin, size_t end, unsigned char* results)
+{
+	size_t count = 0;
+	for (size_t i = begin; i < end; ++i)
+	{
+		results[i] = ::CircleCircleIntersection(circle, Circle(Vector2D(circles.centerX[i], circles.centerY[i]), circles.radius[i])) ? 1 : 0;
+		count += results[i];
+	}
+
+	return count;
+}
+
+// Tests the circles in [begin, end) four at a time, returning how many intersect. The range must be a multiple of four long.
+size_t IntersectionBatch::CircleCircleSSE2(const Circle& circle, const CircleArrays& circles, size_t begin, size_t end, unsigned char* results)
+{
+	const __m128 centerX = _mm_set1_ps(circle.center.x);
+	const __m128 centerY = _mm_set1_ps(circle.center.y);
+	const __m128 radius = _mm_set1_ps(circle.radius);
+
+	size_t count = 0;
+	for (size_t i = begin; i < end; i += 4)
+	{
+		// Use the same operations in the same order as CircleCircleIntersection, so the results match exactly.
+		const __m128 radiusSum = _mm_add_ps(radius, _mm_loadu_ps(circles.radius + i));
+		const __m128 distanceX = _mm_sub_ps(centerX, _mm_loadu_ps(circles.centerX + i));
+		const __m128 distanceY = _mm_sub_ps(centerY, _mm_loadu_ps(circles.centerY + i));
+		const __m128 distanceSquared = _mm_add_ps(_mm_mul_ps(distanceX, distanceX), _mm_mul_ps(distanceY, distanceY));
+
+		const int mask = _mm_movemask_ps(_mm_cmple_ps(distanceSquared, _mm_mul_ps(radiusSum, radiusSum)));
+		for (unsigned lane = 0; lane < 4; ++lane)
+		{
+			results[i + lane] = static_cast<unsigned char>((mask >> lane) & 1);
+			count += results[i + lane];
+		}
+	}
+
+	return count;
+}
+
+// Tests the circles in [begin, end) eight at a time, returning how many intersect. The range must be a multiple of eight long.
+size_t IntersectionBatch::CircleCircleAVX2(const Circle& circle, const CircleArrays& circles, size_t begin, size_t end, unsigned char* results)
+{
+	const __m256 centerX = _mm256_set1_ps(circle.center.x);
+	const __m256 centerY = _mm256_set1_ps(circle.center.y);
+	const __m256 radius = _mm256_set1_ps(circle.radius);
+
+	size_t count = 0;
+	for (size_t i = begin; i < end; i += 8)
+	{
+		// Multiplies and adds are kept separate, since fused instructions round differently from the scalar test.
+		const __m256 radiusSum = _mm256_add_ps(radius, _mm256_loadu_ps(circles.radius + i));
+		const __m256 distanceX = _mm256_sub_ps(centerX, _mm256_loadu_ps(circles.centerX + i));
+		const __m256 distanceY = _mm256_sub_ps(centerY, _mm256_loadu_ps(circles.centerY + i));
+		const __m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(distanceX, distanceX), _mm256_mul_ps(distanceY, distanceY));
+
+		const int mask = _mm256_movemask_ps(_mm256_cmp_ps(distanceSquared, _mm256_mul_ps(radiusSum, radiusSum), _CMP_LE_OQ));
+		for (unsigned lane = 0; lane < 8; ++lane)
+		{
+			results[i + lane] = static_cast<unsigned char>((mask >> lane) & 1);
+			count += results[i + lane];
+		}
+	}
+
+	return count;
+}
+
+// Tests the rectangles in [begin, end) one at a time, returning how many intersect.
+size_t IntersectionBatch::RectangleRectangleScalar(const BoundingRectangle& rect, const RectangleArrays& rects, size_t begin, size_t end, unsigned char* results)
+{
+	size_t count = 0;
+	for (size_t i = begin; i < end; ++i)
+	{
+		// The same test as RectangleRectangleIntersection, reading the sides from the arrays.
+		results[i] = (rect.right >= rects.left[i] && rect.left <= rects.right[i] && rect.top >= rects.bottom[i] && rect.bottom <= rects.top[i]) ? 1 : 0;
+		count += results[i];
+	}
+
+	return count;
+}
+
+// Tests the rectangles in [begin, end) four at a time, returning how many intersect. The range must be a multiple of four long.
+size_t IntersectionBatch::RectangleRectangleSSE2(const BoundingRectangle& rect, const RectangleArrays& rects, size_t begin, size_t end, unsigned char* results)
+{
+	const __m128 left = _mm_set1_ps(rect.left);
+	const __m128 right = _mm_set1_ps(rect.right);
+	const __m128 top = _mm_set1_ps(rect.top);
+	const __m128 bottom = _mm_set1_ps(rect.bottom);
+
+	size_t count = 0;
+	for (size_t i = begin; i < end; i += 4)
+	{
+		__m128 overlap = _mm_cmpge_ps(right, _mm_loadu_ps(rects.left + i));
+		overlap = _mm_and_ps(overlap, _mm_cmple_ps(left, _mm_loadu_ps(rects.right + i)));
+		overlap = _mm_and_ps(overlap, _mm_cmpge_ps(top, _mm_loadu_ps(rects.bottom + i)));
+		overlap = _mm_and_ps(overlap, _mm_cmple_ps(bottom, _mm_loadu_ps(rects.top + i)));
+
+		const int mask = _mm_movemask_ps(overlap);
+		for (unsigned lane = 0; lane < 4; ++lane)
+		{
+			results[i + lane] = static_cast<unsigned char>((mask >> lane) & 1);
+			count += results[i + lane];
+		}
+	}
+
+	return count;
+}
+
+// Tests the rectangles in [begin, end) eight at a time, returning how many intersect. The range must be a multiple of eight long.
+size_t IntersectionBatch::RectangleRectangleAVX2(const BoundingRectangle& rect, const RectangleArrays& rects, size_t begin, size_t end, unsigned char* results)
+{
+	const __m256 left = _mm256_set1_ps(rect.left);
+	const __m256 right = _mm256_set1_ps(rect.right);
+	const __m256 top = _mm256_set1_ps(rect.top);
+	const __m256 bottom = _mm256_set1_ps(rect.bottom);
+
+	size_t count = 0;
+	for (size_t i = begin; i < end; i += 8)
+	{
+		__m256 overlap = _mm256_cmp_ps(right, _mm256_loadu_ps(rects.left + i), _CMP_GE_OQ);
+		overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(left, _mm256_loadu_ps(rects.right + i), _CMP_LE_OQ));
+		overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(top, _mm256_loadu_ps(rects.bottom + i), _CMP_GE_OQ));
+		overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(bottom, _mm256_loadu_ps(rects.top + i), _CMP_LE_OQ));
+
+		const int mask = _mm256_movemask_ps(overlap);
+		for (unsigned lane = 0; lane < 8; ++lane)
+		{
+			results[i + lane] = static_cast<unsigned char>((mask >> lane) & 1);
+			count += results[i + lane];
+		}
+	}
+
+	return count;
+}
+
+// Tests the boxes in [begin, end) one at a time, returning how many intersect.
+size_t IntersectionBatch::OBBOBBScalar(const OBBShape& obb, const OBBArrays& obbs, size_t begin, size_t end, unsigned char* results)
+{
+	// The axes of the box being tested come first, as in OBBOBBIntersection.
+	Vector2D axes[4] = { obb.axes[0], obb.axes[1] };
+	Vector2D corners[4];
+
+	size_t count = 0;
+	for (size_t i = begin; i < end; ++i)
+	{
+		axes[2] = Vector2D(obbs.axisX[0][i], obbs.axisY[0][i]);
+		axes[3] = Vector2D(obbs.axisX[1][i], obbs.axisY[1][i]);
+		for (unsigned j = 0; j < 4; ++j)
+			corners[j] = Vector2D(obbs.cornerX[j][i], obbs.cornerY[j][i]);
+
+		results[i] = SATIntersection(axes, 4, obb.corners, 4, corners, 4) ? 1 : 0;
+		count += results[i];
+	}
+
+	return count;
+}
+
+// Tests the boxes in [begin, end) four at a time, returning how many intersect. The range must be a multiple of four long.
+size_t IntersectionBatch::OBBOBBSSE2(const OBBShape& obb, const OBBArrays& obbs, size_t begin, size_t end, unsigned char* results)
+{
+	// Project the tested box onto its own axes once, since those extents are the same for every box.
+	float ownMin[2];
+	float ownMax[2];
+	for (unsigned axis = 0; axis < 2; ++axis)
+	{
+		ownMin[axis] = FLT_MAX;
+		ownMax[axis] = -FLT_MAX;
+		for (unsigned j = 0; j < 4; ++j)
+		{
+			float projectedPoint = obb.corners[j].DotProduct(obb.axes[axis]);
+			ownMax[axis] = max(ownMax[axis], projectedPoint);
+			ownMin[axis] = min(ownMin[axis], projectedPoint);
+		}
+	}
+
+	const __m128 zero = _mm_setzero_ps();
+
+	size_t count = 0;
+	for (size_t i = begin; i < end; i += 4)
+	{
+		__m128 cornerX[4];
+		__m128 cornerY[4];
+		for (unsigned j = 0; j < 4; ++j)
+		{
+			cornerX[j] = _mm_loadu_ps(obbs.cornerX[j] + i);
+			cornerY[j] = _mm_loadu_ps(obbs.cornerY[j] + i);
+		}
+
+		__m128 separated = zero;
+
+		// The axes of the tested box.
+		for (unsigned axis = 0; axis < 2; ++axis)
+		{
+			const __m128 axisX = _mm_set1_ps(obb.axes[axis].x);
+			const __m128 axisY = _mm_set1_ps(obb.axes[axis].y);
+
+			__m128 otherMin = _mm_set1_ps(FLT_MAX);
+			__m128 otherMax = _mm_set1_ps(-FLT_MAX);
+			for (unsigned j = 0; j < 4; ++j)
+			{
+				const __m128 projectedPoint = _mm_add_ps(_mm_mul_ps(cornerX[j], axisX), _mm_mul_ps(cornerY[j], axisY));
+				otherMax = _mm_max_ps(otherMax, projectedPoint);
+				otherMin = _mm_min_ps(otherMin, projectedPoint);
+			}
+
+			const __m128 gap1 = _mm_sub_ps(otherMin, _mm_set1_ps(ownMax[axis]));
+			const __m128 gap2 = _mm_sub_ps(_mm_set1_ps(ownMin[axis]), otherMax);
+			separated = _mm_or_ps(separated, _mm_cmpgt_ps(_mm_max_ps(gap1, gap2), zero));
+		}
+
+		// The axes of the other boxes, which differ in each lane.
+		for (unsigned axis = 0; axis < 2; ++axis)
+		{
+			const __m128 axisX = _mm_loadu_ps(obbs.axisX[axis] + i);
+			const __m128 axisY = _mm_loadu_ps(obbs.axisY[axis] + i);
+
+			__m128 ownMinLane = _mm_set1_ps(FLT_MAX);
+			__m128 ownMaxLane = _mm_set1_ps(-FLT_MAX);
+			__m128 otherMin = _mm_set1_ps(FLT_MAX);
+			__m128 otherMax = _mm_set1_ps(-FLT_MAX);
+			for (unsigned j = 0; j < 4; ++j)
+			{
+				const __m128 ownPoint = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(obb.corners[j].x), axisX), _mm_mul_ps(_mm_set1_ps(obb.corners[j].y), axisY));
+				ownMaxLane = _mm_max_ps(ownMaxLane, ownPoint);
+				ownMinLane = _mm_min_ps(ownMinLane, ownPoint);
+
+				const __m128 otherPoint = _mm_add_ps(_mm_mul_ps(cornerX[j], axisX), _mm_mul_ps(cornerY[j], axisY));
+				otherMax = _mm_max_ps(otherMax, otherPoint);
+				otherMin = _mm_min_ps(otherMin, otherPoint);
+			}
+
+			const __m128 gap1 = _mm_sub_ps(otherMin, ownMaxLane);
+			const __m128 gap2 = _mm_sub_ps(ownMinLane, otherMax);
+			separated = _mm_or_ps(separated, _mm_cmpgt_ps(_mm_max_ps(gap1, gap2), zero));
+		}
+
+		const int mask = _mm_movemask_ps(separated);
+		for (unsigned lane = 0; lane < 4; ++lane)
+		{
+			results[i + lane] = static_cast<unsigned char>(((mask >> lane) & 1) ^ 1);
+			count += results[i + lane];
+		}
+	}
+
+	return count;
+}
+
+// Tests the boxes in [begin, end) eight at a time, returning how many intersect. The range must be a multiple of eight long.
+size_t IntersectionBatch::OBBOBBAVX2(const OBBShape& obb, const OBBArrays& obbs, size_t begin, size_t end, unsigned char* results)
+{
+	// Project the tested box onto its own axes once, since those extents are the same for every box.
+	float ownMin[2];
+	float ownMax[2];
+	for (unsigned axis = 0; axis < 2; ++axis)
+	{
+		ownMin[axis] = FLT_MAX;
+		ownMax[axis] = -FLT_MAX;
+		for (unsigned j = 0; j < 4; ++j)
+		{
+			float projectedPoint = obb.corners[j].DotProduct(obb.axes[axis]);
+			ownMax[axis] = max(ownMax[axis], projectedPoint);
+			ownMin[axis] = min(ownMin[axis], projectedPoint);
+		}
+	}
+
+	const __m256 zero = _mm256_setzero_ps();
+
+	size_t count = 0;
+	for (size_t i = begin; i < end; i += 8)
+	{
+		__m256 cornerX[4];
+		__m256 cornerY[4];
+		for (unsigned j = 0; j < 4; ++j)
+		{
+			cornerX[j] = _mm256_loadu_ps(obbs.cornerX[j] + i);
+			cornerY[j] = _mm256_loadu_ps(obbs.cornerY[j] + i);
+		}
+
+		__m256 separated = zero;
+
+		// The axes of the tested box.
+		for (unsigned axis = 0; axis < 2; ++axis)
+		{
+			const __m256 axisX = _mm256_set1_ps(obb.axes[axis].x);
+			const __m256 axisY = _mm256_set1_ps(obb.axes[axis].y);
+
+			__m256 otherMin = _mm256_set1_ps(FLT_MAX);
+			__m256 otherMax = _mm256_set1_ps(-FLT_MAX);
+			for (unsigned j = 0; j < 4; ++j)
+			{
+				const __m256 projectedPoint = _mm256_add_ps(_mm256_mul_ps(cornerX[j], axisX), _mm256_mul_ps(cornerY[j], axisY));
+				otherMax = _mm256_max_ps(otherMax, projectedPoint);
+				otherMin = _mm256_min_ps(otherMin, projectedPoint);
+			}
+
+			const __m256 gap1 = _mm256_sub_ps(otherMin, _mm256_set1_ps(ownMax[axis]));
+			const __m256 gap2 = _mm256_sub_ps(_mm256_set1_ps(ownMin[axis]), otherMax);
+			separated = _mm256_or_ps(separated, _mm256_cmp_ps(_mm256_max_ps(gap1, gap2), zero, _CMP_GT_OQ));
+		}
+
+		// The axes of the other boxes, which differ in each lane.
+		for (unsigned axis = 0; axis < 2; ++axis)
+		{
+			const __m256 axisX = _mm256_loadu_ps(obbs.axisX[axis] + i);
+			const __m256 axisY = _mm256_loadu_ps(obbs.axisY[axis] + i);
+
+			__m256 ownMinLane = _mm256_set1_ps(FLT_MAX);
+			__m256 ownMaxLane = _mm256_set1_ps(-FLT_MAX);
+			__m256 otherMin = _mm256_set1_ps(FLT_MAX);
+			__m256 otherMax = _mm256_set1_ps(-FLT_MAX);
+			for (unsigned j = 0; j < 4; ++j)
+			{
+				const __m256 ownPoint = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(obb.corners[j].x), axisX), _mm256_mul_ps(_mm256_set1_ps(obb.corners[j].y), axisY));
+				ownMaxLane = _mm256_max_ps(ownMaxLane, ownPoint);
+				ownMinLane = _mm256_min_ps(ownMinLane, ownPoint);
+
+				const __m256 otherPoint = _mm256_add_ps(_mm256_mul_ps(cornerX[j], axisX), _mm256_mul_ps(cornerY[j], axisY));
+				otherMax = _mm256_max_ps(otherMax, otherPoint);
+				otherMin = _mm256_min_ps(otherMin, otherPoint);
+			}
+
+			const __m256 gap1 = _mm256_sub_ps(otherMin, ownMaxLane);
+			const __m256 gap2 = _mm256_sub_ps(ownMinLane, otherMax);
+			separated = _mm256_or_ps(separated, _mm256_cmp_ps(_mm256_max_ps(gap1, gap2), zero, _CMP_GT_OQ));
+		}
+
+		const int mask = _mm256_movemask_ps(separated);
+		for (unsigned lane = 0; lane < 8; ++lane)
+		{
+			results[i + lane] = static_cast<unsigned char>(((mask >> lane) & 1) ^ 1);
+			count += results[i + lane];
+		}
+	}
+
+	return count;
+}
+
+// Checks which instruction sets the processor and operating system support.
+IntersectionBatch::InstructionSet IntersectionBatch::DetectInstructionSet()
+{
+	// Every x64 processor supports SSE2.
+	int info[4];
+	__cpuid(info, 0);
+	const int highestLeaf = info[0];
+
+	__cpuid(info, 1);
+	const bool hasOSXSave = (info[2] & (1 << 27)) != 0;
+	const bool hasAVX = (info[2] & (1 << 28)) != 0;
+
+	// AVX2 also needs the operating system to save the upper halves of the registers.
+	if (highestLeaf >= 7 && hasOSXSave && hasAVX && (_xgetbv(0) & 0x6) == 0x6)
+	{
+		__cpuidex(info, 7, 0);
+		if ((info[1] & (1 << 5)) != 0)
+			return INSTRUCTIONS_AVX2;
+	}
+
+	return INSTRUCTIONS_SSE2;
+}
+
+//------------------------------------------------------------------------------
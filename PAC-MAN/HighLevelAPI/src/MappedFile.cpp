@@ -0,0 +1,110 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	MappedFile.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "MappedFile.h"
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// Constructor
+MappedFile::MappedFile() : file(INVALID_HANDLE_VALUE), mapping(nullptr), data(nullptr), size(0)
+{
+}
+
+// Destructor - unmaps the file if one is open.
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+// Maps a file into memory, closing the previous file if there was one.
+// Params:
+//   filename = The name of the file to map.
+// Returns:
+//   True if the file was mapped, false if it does not exist, is empty, or could not be mapped.
+bool MappedFile::Open(const std::string& filename)
+{
+	Close();
+
+	file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	// Empty files cannot be mapped.
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0)
+	{
+		Close();
+		return false;
+	}
+
+	mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr)
+	{
+		Close();
+		return false;
+	}
+
+	data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	if (data == nullptr)
+	{
+		Close();
+		return false;
+	}
+
+	size = static_cast<size_t>(fileSize.QuadPart);
+	return true;
+}
+
+// Unmaps the file. Pointers to its data are no longer valid afterwards.
+void MappedFile::Close()
+{
+	if (data != nullptr)
+		UnmapViewOfFile(data);
+
+	if (mapping != nullptr)
+		CloseHandle(mapping);
+
+	if (file != INVALID_HANDLE_VALUE)
+		CloseHandle(file);
+
+	file = INVALID_HANDLE_VALUE;
+	mapping = nullptr;
+	data = nullptr;
+	size = 0;
+}
+
+// Gets the contents of the file, or nullptr if no file is open.
+const unsigned char* MappedFile::GetData() const
+{
+	return data;
+}
+
+// Gets the size of the file in bytes.
+size_t MappedFile::GetSize() const
+{
+	return size;
+}
+
+//------------------------------------------------------------------------------
@@ -20,6 +20,8 @@
 // Systems
 #include "GameObject.h"
 #include "Parser.h"
+#include "Space.h"
+#include "PhysicsStorage.h"
 
 // Components
 #include "Transform.h"
@@ -39,20 +41,68 @@
 //   transform - The transform of the object.
 Physics::Physics() : Component("Physics"),
 	velocity(Vector2D()), angularVelocity(0.0f), inverseMass(1.0f), forcesSum(Vector2D()),
-	acceleration(Vector2D()), oldTranslation(Vector2D()), transform(nullptr)
+	acceleration(Vector2D()), oldTranslation(Vector2D()), transform(nullptr), storage(nullptr), slot(0)
 {
 }
 
+// Copy constructor - the copy is never bound to physics storage.
+// Params:
+//   other = The physics component being copied.
+Physics::Physics(const Physics& other) : Component(other),
+	velocity(other.GetVelocity()), angularVelocity(other.GetAngularVelocity()), inverseMass(other.inverseMass),
+	forcesSum(other.forcesSum), acceleration(other.GetAcceleration()), oldTranslation(other.GetOldTranslation()),
+	transform(nullptr), storage(nullptr), slot(0)
+{
+	// Forces and mass are only stored in the arrays while bound.
+	if (other.storage != nullptr)
+	{
+		inverseMass = other.storage->inverseMasses[other.slot];
+		forcesSum = other.storage->forcesSums[other.slot];
+	}
+}
+
+// Destructor
+Physics::~Physics()
+{
+	if (storage != nullptr)
+		storage->RemovePhysics(*this);
+}
+
 // Clone the physics component, returning a dynamically allocated copy.
 Component* Physics::Clone() const
 {
 	return new Physics(*this);
 }
 
-// Initialize components.
+// Reset the physics component to match the archetype's, so a pooled object can be reused.
+// Params:
+//   archetype = The matching component of the object's archetype.
+// Returns:
+//   True, as the physics component can always be reset.
+bool Physics::Reset(const Component& archetype)
+{
+	const Physics& other = static_cast<const Physics&>(archetype);
+
+	// Pooled objects are never bound to physics storage, and neither are archetypes.
+	// The transform is found again when the object is initialized.
+	velocity = other.velocity;
+	angularVelocity = other.angularVelocity;
+	inverseMass = other.inverseMass;
+	forcesSum = other.forcesSum;
+	acceleration = other.acceleration;
+	oldTranslation = other.oldTranslation;
+
+	return true;
+}
+
+// Initialize components, moving the component's state into its space's physics storage if the space uses one.
 void Physics::Initialize()
 {
 	transform = static_cast<Transform*>(GetOwner()->GetComponent<Transform>());
+
+	PhysicsStorage* physicsStorage = GetOwner()->GetSpace()->GetObjectManager().GetPhysicsStorage();
+	if (physicsStorage != nullptr && transform != nullptr)
+		physicsStorage->AddPhysics(*this, *transform);
 }
 
 // Loads object data from a file.
@@ -86,6 +136,14 @@ void Physics::Serialize(Parser& parser) const
 void Physics::Update(float dt)
 {
 	UNREFERENCED_PARAMETER(dt);
+
+	if (storage != nullptr)
+	{
+		// Calculate the acceleration and clear the current forces.
+		storage->accelerations[slot] = storage->forcesSums[slot] * storage->inverseMasses[slot];
+		storage->forcesSums[slot] = Vector2D();
+		return;
+	}
 	
 	// Calculate the acceleration and clear the current forces.
 	acceleration = forcesSum * inverseMass;
@@ -97,6 +155,10 @@ void Physics::Update(float dt)
 //	 dt = Change in time (in seconds) since the last fixed update.
 void Physics::FixedUpdate(float dt)
 {
+	// The physics storage integrates every bound body in one sweep.
+	if (storage != nullptr)
+		return;
+
 	// Increase velocity by the acceleration from the last update.
 	velocity += acceleration * dt;
 
@@ -117,7 +179,10 @@ void Physics::FixedUpdate(float dt)
 //	 velocity = Pointer to a velocity vector.
 void Physics::SetVelocity(const Vector2D& velocity_)
 {
-	velocity = velocity_;
+	if (storage != nullptr)
+		storage->velocities[slot] = velocity_;
+	else
+		velocity = velocity_;
 }
 
 // Get the velocity of a physics component.
@@ -125,6 +190,9 @@ void Physics::SetVelocity(const Vector2D& velocity_)
 //		A reference to the component's velocity structure.
 const Vector2D& Physics::GetVelocity() const
 {
+	if (storage != nullptr)
+		return storage->velocities[slot];
+
 	return velocity;
 }
 
@@ -133,7 +201,10 @@ const Vector2D& Physics::GetVelocity() const
 //	 velocity = New value for the rotational velocity.
 void Physics::SetAngularVelocity(float velocity_)
 {
-	angularVelocity = velocity_;
+	if (storage != nullptr)
+		storage->angularVelocities[slot] = velocity_;
+	else
+		angularVelocity = velocity_;
 }
 
 // Get the angular velocity of a physics component.
@@ -141,6 +212,9 @@ void Physics::SetAngularVelocity(float velocity_)
 //	 A float representing the new angular velocity.
 float Physics::GetAngularVelocity() const
 {
+	if (storage != nullptr)
+		return storage->angularVelocities[slot];
+
 	return angularVelocity;
 }
 
@@ -150,7 +224,10 @@ float Physics::GetAngularVelocity() const
 void Physics::SetMass(float mass)
 {
 	// We aren't using the mass for anything besides calculating acceleration, so we only need to store the inverse mass.
-	inverseMass = 1.0f / mass;
+	if (storage != nullptr)
+		storage->inverseMasses[slot] = 1.0f / mass;
+	else
+		inverseMass = 1.0f / mass;
 }
 
 // Add a force to the object.
@@ -158,7 +235,10 @@ void Physics::SetMass(float mass)
 //	 force = A force vector with direction and magnitude.
 void Physics::AddForce(const Vector2D& force)
 {
-	forcesSum += force;
+	if (storage != nullptr)
+		storage->forcesSums[slot] += force;
+	else
+		forcesSum += force;
 }
 
 // Get the acceleration of a physics component.
@@ -166,6 +246,9 @@ void Physics::AddForce(const Vector2D& force)
 //	 A reference to the component's acceleration structure.
 const Vector2D& Physics::GetAcceleration() const
 {
+	if (storage != nullptr)
+		return storage->accelerations[slot];
+
 	return acceleration;
 }
 
@@ -174,7 +257,10 @@ const Vector2D& Physics::GetAcceleration() const
 //   oldTranslation = New value for the old translation.
 void Physics::SetOldTranslation(const Vector2D& oldTranslation_)
 {
-	oldTranslation = oldTranslation_;
+	if (storage != nullptr)
+		storage->oldTranslations[slot] = oldTranslation_;
+	else
+		oldTranslation = oldTranslation_;
 }
 
 // Get the old translation (position) of a physics component.
@@ -182,6 +268,9 @@ void Physics::SetOldTranslation(const Vector2D& oldTranslation_)
 //   A reference to the component's oldTranslation structure,
 const Vector2D& Physics::GetOldTranslation() const
 {
+	if (storage != nullptr)
+		return storage->oldTranslations[slot];
+
 	return oldTranslation;
 }
 
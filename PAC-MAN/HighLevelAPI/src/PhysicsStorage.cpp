@@ -0,0 +1,234 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	PhysicsStorage.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "PhysicsStorage.h"
+
+// Components
+#include "Transform.h"
+#include "Physics.h"
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// Constructor
+PhysicsStorage::PhysicsStorage()
+{
+}
+
+// Destructor
+PhysicsStorage::~PhysicsStorage()
+{
+	// Hand any remaining state back to the components so they never point at freed storage.
+	while (!bodyOwners.empty())
+		RemovePhysics(*bodyOwners.back());
+
+	for (auto it = transformOwners.begin(); it != transformOwners.end(); ++it)
+	{
+		if (*it != nullptr)
+			RemoveTransform(**it);
+	}
+}
+
+// Reserves room in the arrays so they do not grow during play.
+// Params:
+//   transformCount = How many transforms to reserve room for.
+//   bodyCount = How many physics components to reserve room for.
+void PhysicsStorage::Reserve(size_t transformCount, size_t bodyCount)
+{
+	translations.reserve(transformCount);
+	rotations.reserve(transformCount);
+	scales.reserve(transformCount);
+	dirtyFlags.reserve(transformCount);
+	transformOwners.reserve(transformCount);
+
+	bodyTransforms.reserve(bodyCount);
+	velocities.reserve(bodyCount);
+	angularVelocities.reserve(bodyCount);
+	inverseMasses.reserve(bodyCount);
+	forcesSums.reserve(bodyCount);
+	accelerations.reserve(bodyCount);
+	oldTranslations.reserve(bodyCount);
+	bodyOwners.reserve(bodyCount);
+}
+
+// Moves a transform's state into the storage. Does nothing if it is already bound.
+// Params:
+//   transform = The transform to bind.
+void PhysicsStorage::AddTransform(Transform& transform)
+{
+	if (transform.storage != nullptr)
+		return;
+
+	unsigned slot;
+	if (freeTransforms.empty())
+	{
+		slot = static_cast<unsigned>(transformOwners.size());
+		translations.push_back(Vector2D());
+		rotations.push_back(0.0f);
+		scales.push_back(Vector2D());
+		dirtyFlags.push_back(0);
+		transformOwners.push_back(nullptr);
+	}
+	else
+	{
+		slot = freeTransforms.back();
+		freeTransforms.pop_back();
+	}
+
+	translations[slot] = transform.translation;
+	rotations[slot] = transform.rotation;
+	scales[slot] = transform.scale;
+	dirtyFlags[slot] = transform.isDirty;
+	transformOwners[slot] = &transform;
+
+	transform.storage = this;
+	transform.slot = slot;
+}
+
+// Moves a transform's state back into the component. Does nothing if it is not bound.
+// Params:
+//   transform = The transform to unbind.
+void PhysicsStorage::RemoveTransform(Transform& transform)
+{
+	if (transform.storage != this)
+		return;
+
+	const unsigned slot = transform.slot;
+
+	transform.translation = translations[slot];
+	transform.rotation = rotations[slot];
+	transform.scale = scales[slot];
+	transform.isDirty = dirtyFlags[slot] != 0;
+	transform.storage = nullptr;
+
+	transformOwners[slot] = nullptr;
+	freeTransforms.push_back(slot);
+}
+
+// Moves a physics component's state into the storage, binding its transform first if needed.
+//   Does nothing if it is already bound.
+// Params:
+//   physics = The physics component to bind.
+//   transform = The transform of the physics component's object.
+void PhysicsStorage::AddPhysics(Physics& physics, Transform& transform)
+{
+	if (physics.storage != nullptr)
+		return;
+
+	AddTransform(transform);
+
+	const unsigned slot = static_cast<unsigned>(bodyOwners.size());
+
+	bodyTransforms.push_back(transform.slot);
+	velocities.push_back(physics.velocity);
+	angularVelocities.push_back(physics.angularVelocity);
+	inverseMasses.push_back(physics.inverseMass);
+	forcesSums.push_back(physics.forcesSum);
+	accelerations.push_back(physics.acceleration);
+	oldTranslations.push_back(physics.oldTranslation);
+	bodyOwners.push_back(&physics);
+
+	physics.storage = this;
+	physics.slot = slot;
+}
+
+// Moves a physics component's state back into the component. Does nothing if it is not bound.
+// Params:
+//   physics = The physics component to unbind.
+void PhysicsStorage::RemovePhysics(Physics& physics)
+{
+	if (physics.storage != this)
+		return;
+
+	const unsigned slot = physics.slot;
+
+	physics.velocity = velocities[slot];
+	physics.angularVelocity = angularVelocities[slot];
+	physics.inverseMass = inverseMasses[slot];
+	physics.forcesSum = forcesSums[slot];
+	physics.acceleration = accelerations[slot];
+	physics.oldTranslation = oldTranslations[slot];
+	physics.storage = nullptr;
+
+	// Keep the bodies packed by moving the last one into the hole.
+	const unsigned last = static_cast<unsigned>(bodyOwners.size() - 1);
+	if (slot != last)
+	{
+		bodyTransforms[slot] = bodyTransforms[last];
+		velocities[slot] = velocities[last];
+		angularVelocities[slot] = angularVelocities[last];
+		inverseMasses[slot] = inverseMasses[last];
+		forcesSums[slot] = forcesSums[last];
+		accelerations[slot] = accelerations[last];
+		oldTranslations[slot] = oldTranslations[last];
+		bodyOwners[slot] = bodyOwners[last];
+		bodyOwners[slot]->slot = slot;
+	}
+
+	bodyTransforms.pop_back();
+	velocities.pop_back();
+	angularVelocities.pop_back();
+	inverseMasses.pop_back();
+	forcesSums.pop_back();
+	accelerations.pop_back();
+	oldTranslations.pop_back();
+	bodyOwners.pop_back();
+}
+
+// Updates the velocity, translation and rotation of every bound physics component.
+// Params:
+//	 dt = A fixed change in time, usually 1/60th of a second.
+void PhysicsStorage::Integrate(float dt)
+{
+	const size_t bodyCount = bodyOwners.size();
+	for (size_t i = 0; i < bodyCount; ++i)
+	{
+		const unsigned transformSlot = bodyTransforms[i];
+
+		// Increase velocity by the acceleration from the last update.
+		velocities[i] += accelerations[i] * dt;
+
+		// Store the old translation.
+		oldTranslations[i] = translations[transformSlot];
+
+		// Add the current velocity to the translation & rotation.
+		Vector2D newTranslation = oldTranslations[i] + velocities[i] * dt;
+		float newRotation = rotations[transformSlot] + angularVelocities[i] * dt;
+
+		// Update the translation & rotation, marking the transform's matrices as dirty if they changed.
+		if (!AlmostEqual(translations[transformSlot], newTranslation))
+		{
+			translations[transformSlot] = newTranslation;
+			dirtyFlags[transformSlot] = 1;
+		}
+
+		if (rotations[transformSlot] != newRotation)
+		{
+			rotations[transformSlot] = newRotation;
+			dirtyFlags[transformSlot] = 1;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
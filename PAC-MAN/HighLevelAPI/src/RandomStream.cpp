@@ -0,0 +1,140 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	RandomStream.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "RandomStream.h"
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// Constructor
+// Params:
+//   seed = The seed shared by related streams.
+//   stream = Which of the seed's streams to draw from.
+RandomStream::RandomStream(unsigned long long seed, unsigned long long stream)
+{
+	Seed(seed, stream);
+}
+
+// Restarts the stream from its first number.
+// Params:
+//   seed = The seed shared by related streams.
+//   stream = Which of the seed's streams to draw from.
+void RandomStream::Seed(unsigned long long seed_, unsigned long long stream_)
+{
+	seed = seed_;
+	stream = stream_;
+	key = Mix(seed ^ Mix(stream + 0x9E3779B97F4A7C15ull));
+	counter = 0;
+}
+
+// Creates a new stream with the same seed, using the next number of this stream as its id.
+RandomStream RandomStream::Split()
+{
+	const unsigned long long high = Next();
+	const unsigned long long low = Next();
+	return RandomStream(seed, (high << 32) | low);
+}
+
+// Generates a random 32-bit number.
+unsigned RandomStream::Next()
+{
+	// Each counter value is hashed on its own, so no number depends on the ones drawn before it.
+	++counter;
+	return static_cast<unsigned>(Mix(key + counter * 0x9E3779B97F4A7C15ull) >> 32);
+}
+
+// Generates a random number in the interval [0, bound). Uses exactly one number of the stream.
+// Params:
+//   bound = One more than the highest possible number. Must not be 0.
+unsigned RandomStream::NextBelow(unsigned bound)
+{
+	// Scale instead of taking the remainder, which avoids a division and favors the low numbers less.
+	return static_cast<unsigned>((static_cast<unsigned long long>(Next()) * bound) >> 32);
+}
+
+// Generates a random number in the interval [rangeMin, rangeMax] (inclusive).
+// Params:
+//	 rangeMin = The lowest possible number generated.
+//	 rangeMax = The highest possible number generated.
+int RandomStream::Range(int rangeMin, int rangeMax)
+{
+	const unsigned span = static_cast<unsigned>(rangeMax - rangeMin) + 1;
+
+	// The full range of an int wraps the span around to 0.
+	if (span == 0)
+		return static_cast<int>(Next());
+
+	return rangeMin + static_cast<int>(NextBelow(span));
+}
+
+// Generates a random floating-point number in the interval [rangeMin, rangeMax).
+// Params:
+//	 rangeMin = The lowest possible number generated.
+//	 rangeMax = The upper limit of the numbers generated.
+float RandomStream::Range(float rangeMin, float rangeMax)
+{
+	// Use the 24 bits a float can hold exactly.
+	const float percent = (Next() >> 8) * (1.0f / 16777216.0f);
+	return rangeMin + (rangeMax - rangeMin) * percent;
+}
+
+// Gets the seed of the stream.
+unsigned long long RandomStream::GetSeed() const
+{
+	return seed;
+}
+
+// Gets the id of the stream.
+unsigned long long RandomStream::GetStream() const
+{
+	return stream;
+}
+
+// Gets how many numbers have been drawn, which together with the seed and id is the whole state.
+unsigned long long RandomStream::GetCounter() const
+{
+	return counter;
+}
+
+// Moves to a position in the stream, such as one saved with GetCounter for a replay.
+// Params:
+//   counter = How many numbers should count as already drawn.
+void RandomStream::SetCounter(unsigned long long counter_)
+{
+	counter = counter_;
+}
+
+//------------------------------------------------------------------------------
+// Private Functions:
+//------------------------------------------------------------------------------
+
+// Scrambles the bits of a 64-bit number (the SplitMix64 finalizer).
+unsigned long long RandomStream::Mix(unsigned long long value)
+{
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+	return value ^ (value >> 31);
+}
+
+//------------------------------------------------------------------------------
@@ -18,6 +18,8 @@
 
 // Systems
 #include "Level.h"
+#include "Tilemap.h"
+#include "TilemapStreamer.h"
 
 //------------------------------------------------------------------------------
 
@@ -31,7 +33,7 @@
 
 // Constructor(s)
 Space::Space(const std::string& name) : BetaObject(name),
-	paused(false), timeScale(1.0f), currentLevel(nullptr), nextLevel(nullptr), objectManager(this)
+	paused(false), timeScale(1.0f), currentLevel(nullptr), nextLevel(nullptr), random(0), randomSeed(0), objectManager(this)
 {
 }
 
@@ -48,6 +50,10 @@ void Space::Update(float dt)
 {
 	objectManager.Update(dt * timeScale);
 
+	// Streamers take in the chunks the objects and sprites asked for this frame, whether or not anything drew the map.
+	for (auto it = streamingTilemaps.begin(); it != streamingTilemaps.end(); ++it)
+		(*it)->GetStreamer()->Update();
+
 	// If there is a next level, handle level changing logic.
 	if (nextLevel != nullptr)
 	{
@@ -71,6 +77,9 @@ void Space::Shutdown()
 	// Shutdown and unload the object manager.
 	objectManager.Shutdown();
 	objectManager.Unload();
+	tileOccupancy.Clear();
+	flowFields.Clear();
+	streamingTilemaps.clear();
 
 	// Unload the current level if there is one.
 	if (currentLevel != nullptr)
@@ -159,6 +168,55 @@ ResourceManager& Space::GetResourceManager()
 	return resourceManager;
 }
 
+// Returns the tile occupancy map, which you can use to find objects on a tile.
+TileOccupancyMap& Space::GetTileOccupancy()
+{
+	return tileOccupancy;
+}
+
+// Returns the flow field map, which you can use to find the way to a tile.
+FlowFieldMap& Space::GetFlowFields()
+{
+	return flowFields;
+}
+
+// Returns the space's random stream. It is reseeded whenever a level starts, so a level
+//   plays out the same way every time it is started with the same seed.
+RandomStream& Space::GetRandom()
+{
+	return random;
+}
+
+// Sets the seed the random stream is reset to when a level starts, and reseeds it now.
+// Params:
+//   seed = The new seed.
+void Space::SetRandomSeed(unsigned long long seed)
+{
+	randomSeed = seed;
+	random.Seed(randomSeed);
+}
+
+// Updates the streamer of a streaming tilemap once per frame, after the objects have updated and
+//   drawn, until the level changes or restarts. Does nothing if the whole map is in memory.
+// Params:
+//   tilemap = The streaming tilemap. It must be removed before it is deleted.
+void Space::AddStreamingTilemap(const Tilemap& tilemap)
+{
+	if (tilemap.GetStreamer() == nullptr)
+		return;
+
+	if (std::find(streamingTilemaps.begin(), streamingTilemaps.end(), &tilemap) == streamingTilemaps.end())
+		streamingTilemaps.push_back(&tilemap);
+}
+
+// Stops updating the streamer of a tilemap added with AddStreamingTilemap.
+// Params:
+//   tilemap = The streaming tilemap.
+void Space::RemoveStreamingTilemap(const Tilemap& tilemap)
+{
+	streamingTilemaps.erase(std::remove(streamingTilemaps.begin(), streamingTilemaps.end(), &tilemap), streamingTilemaps.end());
+}
+
 //------------------------------------------------------------------------------
 // Private Functions:
 //------------------------------------------------------------------------------
@@ -172,6 +230,9 @@ void Space::ChangeLevel()
 
 	// Shutdown the object manager.
 	objectManager.Shutdown();
+	tileOccupancy.Clear();
+	flowFields.Clear();
+	streamingTilemaps.clear();
 
 	// Check if we are changing levels.
 	if (nextLevel != currentLevel)
@@ -197,6 +258,9 @@ void Space::ChangeLevel()
 		resourceManager.OnLevelLoad();
 	}
 
+	// Start every level, including restarts, from the same random numbers.
+	random.Seed(randomSeed);
+
 	// Initialize the next level.
 	currentLevel->Initialize();
 
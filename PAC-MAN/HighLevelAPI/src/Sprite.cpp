@@ -57,6 +57,24 @@ Component* Sprite::Clone() const
 	return new Sprite(*this);
 }
 
+// Reset the sprite to match the archetype's, so a pooled object can be reused.
+// Params:
+//   archetype = The matching component of the object's archetype.
+// Returns:
+//   True, as the sprite can always be reset.
+bool Sprite::Reset(const Component& archetype)
+{
+	const Sprite& other = static_cast<const Sprite&>(archetype);
+
+	// The transform is found again when the object is initialized.
+	frameIndex = other.frameIndex;
+	spriteSource = other.spriteSource;
+	mesh = other.mesh;
+	color = other.color;
+
+	return true;
+}
+
 // Initialize components.
 void Sprite::Initialize()
 {
@@ -47,6 +47,16 @@ Component* SpriteText::Clone() const
 	return new SpriteText(*this);
 }
 
+// Resetting only handles the base sprite's state, so this sprite is cloned again instead.
+// Params:
+//   archetype = The matching component of the object's archetype.
+// Returns:
+//   False, as the sprite cannot be reset in place.
+bool SpriteText::Reset(const Component& archetype)
+{
+	return Component::Reset(archetype);
+}
+
 // Draw a sprite (Sprite can be textured or untextured).
 void SpriteText::Draw()
 {
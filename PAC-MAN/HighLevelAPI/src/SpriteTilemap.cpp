@@ -19,8 +19,14 @@
 
 // Systems
 #include "Tilemap.h"
+#include "TilemapStreamer.h"
 #include "Transform.h"
+#include "SpriteSource.h"
+#include "Matrix2DStudent.h"
 #include <Graphics.h>
+#include <Mesh.h>
+#include <MeshFactory.h>
+#include <Vertex.h>
 
 //------------------------------------------------------------------------------
 
@@ -29,14 +35,34 @@
 //------------------------------------------------------------------------------
 
 // Create a new sprite for use with a tilemap.
-SpriteTilemap::SpriteTilemap() : map(nullptr)
+SpriteTilemap::SpriteTilemap() : map(nullptr), chunkColumns(0), chunkRows(0), bakedSource(nullptr)
 {
 }
 
+// Frees the baked meshes.
+SpriteTilemap::~SpriteTilemap()
+{
+	FreeChunks();
+}
+
 // Clone the sprite, returning a dynamically allocated copy.
 Component* SpriteTilemap::Clone() const
 {
-	return new SpriteTilemap(*this);
+	SpriteTilemap* clone = new SpriteTilemap(*this);
+
+	// The baked meshes belong to this sprite, so the clone bakes its own.
+	clone->chunks.clear();
+	return clone;
+}
+
+// Resetting only handles the base sprite's state, so this sprite is cloned again instead.
+// Params:
+//   archetype = The matching component of the object's archetype.
+// Returns:
+//   False, as the sprite cannot be reset in place.
+bool SpriteTilemap::Reset(const Component& archetype)
+{
+	return Component::Reset(archetype);
 }
 
 // Draw a sprite (Sprite can be textured or untextured).
@@ -51,36 +77,27 @@ void SpriteTilemap::Draw()
 	unsigned height = map->GetHeight();
 	Vector2D translation = transform->GetTranslation();
 	Vector2D scale = transform->GetScale();
+	const BoundingRectangle screenWorldDimensions = Graphics::GetInstance().GetScreenWorldDimensions();
 
-	for (unsigned x = 0; x < width; x++)
-	{
-		for (unsigned y = 0; y < height; y++)
-		{
-			// Get the cell value at the current position.
-			int cellValue = map->GetCellValue(x, y);
+	// Find the tiles on the screen, with a margin of two tiles on each side.
+	const int minX = max(static_cast<int>(ceil((screenWorldDimensions.left - translation.x) / scale.x - 2.0f)), 0);
+	const int maxX = min(static_cast<int>(floor((screenWorldDimensions.right - translation.x) / scale.x + 2.0f)), static_cast<int>(width) - 1);
+	const int minY = max(static_cast<int>(ceil((translation.y - screenWorldDimensions.top) / scale.y - 2.0f)), 0);
+	const int maxY = min(static_cast<int>(floor((translation.y - screenWorldDimensions.bottom) / scale.y + 2.0f)), static_cast<int>(height) - 1);
 
-			// If the cell is empty, don't draw anything.
-			if (cellValue < 1)
-				continue;
-
-			// Set the frame in the spritesheet.
-			SetFrame(cellValue - 1);
-
-			// Draw the tile.
-			Vector2D offset = Vector2D(x * scale.x, y * -scale.y);
+	// Keep the visible part of a streaming map loaded. The space updates the streamer after drawing.
+	TilemapStreamer* streamer = map->GetStreamer();
+	if (streamer != nullptr)
+		streamer->AddFocus(minX, minY, maxX, maxY);
 
-			const BoundingRectangle screenWorldDimensions = Graphics::GetInstance().GetScreenWorldDimensions();
-
-			// If the tile would be off the screen, don't draw anything.
-			if (screenWorldDimensions.bottom > translation.y + offset.y + scale.y * 2.0f
-				|| screenWorldDimensions.top < translation.y + offset.y - scale.y * 2.0f
-				|| screenWorldDimensions.left > translation.x + offset.x + scale.x * 2.0f
-				|| screenWorldDimensions.right < translation.x + offset.x - scale.x * 2.0f)
-				continue;
+	if (minX > maxX || minY > maxY)
+		return;
 
-			Sprite::Draw(offset);
-		}
-	}
+	// Baking a streamed map would load all of it, so it is drawn a tile at a time instead.
+	if (streamer != nullptr || spriteSource == nullptr)
+		DrawTiles(minX, minY, maxX, maxY);
+	else
+		DrawChunks(minX, minY, maxX, maxY);
 }
 
 // Sets the tilemap data that will be used by the sprite.
@@ -88,9 +105,35 @@ void SpriteTilemap::Draw()
 //   map = A pointer to the tilemap resource.
 void SpriteTilemap::SetTilemap(const Tilemap* map_)
 {
+	// Free the chunks first, so they stop listening to the old map.
+	FreeChunks();
 	map = map_;
 }
 
+// Marks the baked meshes covering a rectangle of tiles as out of date, so they are baked again
+//   before they are next drawn. Call after editing cells of the tilemap.
+// Params:
+//   minColumn = The left edge of the edited rectangle.
+//   minRow = The top edge of the edited rectangle.
+//   maxColumn = The right edge of the edited rectangle.
+//   maxRow = The bottom edge of the edited rectangle.
+void SpriteTilemap::InvalidateTiles(int minColumn, int minRow, int maxColumn, int maxRow)
+{
+	if (chunks.empty())
+		return;
+
+	minColumn = max(minColumn, 0);
+	minRow = max(minRow, 0);
+	maxColumn = min(maxColumn, static_cast<int>(chunkColumns * chunkSize) - 1);
+	maxRow = min(maxRow, static_cast<int>(chunkRows * chunkSize) - 1);
+
+	for (int row = minRow / static_cast<int>(chunkSize); row <= maxRow / static_cast<int>(chunkSize); ++row)
+	{
+		for (int column = minColumn / static_cast<int>(chunkSize); column <= maxColumn / static_cast<int>(chunkSize); ++column)
+			chunks[row * chunkColumns + column].dirty = true;
+	}
+}
+
 // Converts a coordinate in tile space to world space.
 // Params:
 //   tilePos = The coordinate in tile space.
@@ -113,3 +156,174 @@ Vector2D SpriteTilemap::WorldToTile(Vector2D worldPos) const
 }
 
 //------------------------------------------------------------------------------
+// Private Functions:
+//------------------------------------------------------------------------------
+
+// Draws the tiles in a rectangle with one draw call per tile.
+// Params:
+//   minX = The left edge of the rectangle.
+//   minY = The top edge of the rectangle.
+//   maxX = The right edge of the rectangle.
+//   maxY = The bottom edge of the rectangle.
+void SpriteTilemap::DrawTiles(int minX, int minY, int maxX, int maxY)
+{
+	Vector2D scale = transform->GetScale();
+
+	const unsigned spanWidth = static_cast<unsigned>(maxX - minX + 1);
+	rowValues.resize(spanWidth);
+
+	// Walk the visible part of the map in the order it is stored, one row at a time.
+	for (unsigned y = static_cast<unsigned>(minY); y <= static_cast<unsigned>(maxY); y++)
+	{
+		map->GetSpan(static_cast<unsigned>(minX), y, spanWidth, rowValues.data());
+
+		for (unsigned x = static_cast<unsigned>(minX); x <= static_cast<unsigned>(maxX); x++)
+		{
+			// Get the cell value at the current position.
+			int cellValue = rowValues[x - minX];
+
+			// If the cell is empty, don't draw anything.
+			if (cellValue < 1)
+				continue;
+
+			// Set the frame in the spritesheet.
+			SetFrame(cellValue - 1);
+
+			// Draw the tile.
+			Vector2D offset = Vector2D(x * scale.x, y * -scale.y);
+			Sprite::Draw(offset);
+		}
+	}
+}
+
+// Draws the baked chunks overlapping a rectangle of tiles, baking any that are out of date.
+// Params:
+//   minX = The left edge of the rectangle.
+//   minY = The top edge of the rectangle.
+//   maxX = The right edge of the rectangle.
+//   maxY = The bottom edge of the rectangle.
+void SpriteTilemap::DrawChunks(int minX, int minY, int maxX, int maxY)
+{
+	// Start over if this is the first draw since the map or the sprite source changed.
+	if (chunks.empty() || bakedSource != spriteSource)
+	{
+		FreeChunks();
+
+		chunkColumns = (map->GetWidth() + chunkSize - 1) / chunkSize;
+		chunkRows = (map->GetHeight() + chunkSize - 1) / chunkSize;
+		BakedChunk chunk = { nullptr, true };
+		chunks.assign(chunkColumns * chunkRows, chunk);
+		bakedSource = spriteSource;
+
+		// Bake cells again when they are edited.
+		map->Subscribe(OnTilemapChanged, this);
+	}
+
+	// The UVs are baked into the vertices, so the texture is not offset.
+	Graphics& graphics = Graphics::GetInstance();
+	graphics.SetTexture(spriteSource->GetTexture(), Vector2D(0.0f, 0.0f));
+	graphics.SetTransform(reinterpret_cast<const Matrix2D&>(transform->GetMatrix()));
+	graphics.SetSpriteBlendColor(color);
+
+	for (unsigned row = static_cast<unsigned>(minY) / chunkSize; row <= static_cast<unsigned>(maxY) / chunkSize; row++)
+	{
+		for (unsigned column = static_cast<unsigned>(minX) / chunkSize; column <= static_cast<unsigned>(maxX) / chunkSize; column++)
+		{
+			BakedChunk& chunk = chunks[row * chunkColumns + column];
+			if (chunk.dirty)
+				BakeChunk(column, row);
+
+			if (chunk.mesh != nullptr)
+				chunk.mesh->Draw();
+		}
+	}
+}
+
+// Builds the mesh of a chunk from the tilemap, with the UVs of each tile's frame.
+// Params:
+//   column = The column of the chunk.
+//   row = The row of the chunk.
+void SpriteTilemap::BakeChunk(unsigned column, unsigned row)
+{
+	BakedChunk& chunk = chunks[row * chunkColumns + column];
+	delete chunk.mesh;
+	chunk.mesh = nullptr;
+	chunk.dirty = false;
+
+	const unsigned minX = column * chunkSize;
+	const unsigned minY = row * chunkSize;
+	const unsigned maxX = min(minX + chunkSize, map->GetWidth()) - 1;
+	const unsigned maxY = min(minY + chunkSize, map->GetHeight()) - 1;
+
+	const unsigned spanWidth = maxX - minX + 1;
+	rowValues.resize(spanWidth);
+
+	// The size of one frame in the sprite sheet.
+	const Vector2D frameSize(1.0f / spriteSource->GetNumCols(), 1.0f / spriteSource->GetNumRows());
+
+	MeshFactory& meshFactory = MeshFactory::GetInstance();
+	bool hasTiles = false;
+
+	for (unsigned y = minY; y <= maxY; y++)
+	{
+		map->GetSpan(minX, y, spanWidth, rowValues.data());
+
+		for (unsigned x = minX; x <= maxX; x++)
+		{
+			// If the cell is empty, don't draw anything.
+			int cellValue = rowValues[x - minX];
+			if (cellValue < 1)
+				continue;
+
+			Vector2D uv;
+			spriteSource->GetUV(cellValue - 1, uv);
+
+			// Place the tile the same way drawing it with an offset would, in the map's local space.
+			const Vector2D center(static_cast<float>(x), -static_cast<float>(y));
+			Vertex corners[4] = {
+				Vertex(center + Vector2D(-0.5f, -0.5f), uv + Vector2D(0.0f, frameSize.y)), // Bottom left.
+				Vertex(center + Vector2D(0.5f, -0.5f), uv + frameSize), // Bottom right.
+				Vertex(center + Vector2D(0.5f, 0.5f), uv + Vector2D(frameSize.x, 0.0f)), // Top right.
+				Vertex(center + Vector2D(-0.5f, 0.5f), uv) // Top left.
+			};
+
+			meshFactory.AddTriangle(corners[0], corners[2], corners[3]);
+			meshFactory.AddTriangle(corners[0], corners[1], corners[2]);
+			hasTiles = true;
+		}
+	}
+
+	if (hasTiles)
+		chunk.mesh = meshFactory.EndCreate();
+}
+
+// Frees the baked meshes of every chunk.
+void SpriteTilemap::FreeChunks()
+{
+	if (!chunks.empty())
+		map->Unsubscribe(OnTilemapChanged, this);
+
+	for (auto it = chunks.begin(); it != chunks.end(); ++it)
+		delete it->mesh;
+
+	chunks.clear();
+	chunkColumns = 0;
+	chunkRows = 0;
+	bakedSource = nullptr;
+}
+
+// Marks the chunks covering the changed cells of the tilemap as out of date.
+// Params:
+//   context = The sprite tilemap that subscribed.
+//   tilemap = The tilemap that changed.
+//   minColumn = The left edge of the changed rectangle.
+//   minRow = The top edge of the changed rectangle.
+//   maxColumn = The right edge of the changed rectangle.
+//   maxRow = The bottom edge of the changed rectangle.
+void SpriteTilemap::OnTilemapChanged(void* context, const Tilemap& tilemap, int minColumn, int minRow, int maxColumn, int maxRow)
+{
+	UNREFERENCED_PARAMETER(tilemap);
+	static_cast<SpriteTilemap*>(context)->InvalidateTiles(minColumn, minRow, maxColumn, maxRow);
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,193 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	ThreadPool.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "ThreadPool.h"
+#include <cassert>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// Runs a job over every index in [0, count), split into batches. Returns once every batch is done.
+// Params:
+//   count = How many indices to run the job over.
+//   batchSize = How many indices each batch covers.
+//   job = The job to run on each batch.
+//   context = A pointer passed to every call of the job.
+void ThreadPool::ParallelFor(size_t count_, size_t batchSize_, JobFunction job_, void* context_)
+{
+	if (count_ == 0)
+		return;
+
+	if (batchSize_ == 0)
+		batchSize_ = 1;
+
+	// The pool only tracks one job at a time, so a job starting another would replace the job the workers are running.
+	assert(!running && "ThreadPool::ParallelFor must not be called from inside a job.");
+
+	// Small jobs are not worth waking the workers for, and nested jobs cannot be given to them.
+	if (workers.empty() || count_ <= batchSize_ || running)
+	{
+		job_(context_, 0, count_);
+		return;
+	}
+
+	running = true;
+
+	Job job;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		currentJob.function = job_;
+		currentJob.context = context_;
+		currentJob.count = count_;
+		currentJob.batchSize = batchSize_;
+		currentJob.batchCount = (count_ + batchSize_ - 1) / batchSize_;
+		++currentJob.generation;
+		nextBatch = static_cast<unsigned long long>(currentJob.generation) << 32;
+		finishedBatches = 0;
+		job = currentJob;
+	}
+	workReady.notify_all();
+
+	// Help out instead of sitting idle.
+	RunBatches(job);
+
+	// Wait for the last batches. Workers that wake up after this can no longer claim any of them.
+	std::unique_lock<std::mutex> lock(mutex);
+	while (finishedBatches < job.batchCount)
+		workDone.wait(lock);
+
+	running = false;
+}
+
+// Gets how many threads run batches, including the calling thread.
+unsigned ThreadPool::GetThreadCount() const
+{
+	return static_cast<unsigned>(workers.size()) + 1;
+}
+
+// Returns an instance of the thread pool.
+ThreadPool& ThreadPool::GetInstance()
+{
+	static ThreadPool instance;
+	return instance;
+}
+
+//------------------------------------------------------------------------------
+// Private Functions:
+//------------------------------------------------------------------------------
+
+// Constructor is private to prevent accidental instantiation
+ThreadPool::ThreadPool() : nextBatch(0), finishedBatches(0), quit(false), running(false)
+{
+	currentJob.function = nullptr;
+	currentJob.context = nullptr;
+	currentJob.count = 0;
+	currentJob.batchSize = 0;
+	currentJob.batchCount = 0;
+	currentJob.generation = 0;
+
+	// hardware_concurrency may return 0 if the count is unknown.
+	const unsigned hardwareThreads = std::thread::hardware_concurrency();
+	const unsigned workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+
+	workers.reserve(workerCount);
+	for (unsigned i = 0; i < workerCount; ++i)
+		workers.push_back(std::thread(&ThreadPool::WorkerThread, this));
+}
+
+// Destructor is private to prevent accidental destruction
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		quit = true;
+	}
+	workReady.notify_all();
+
+	for (auto it = workers.begin(); it != workers.end(); ++it)
+		it->join();
+}
+
+// Waits for work and runs batches until the pool is destroyed.
+void ThreadPool::WorkerThread()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	unsigned seenGeneration = currentJob.generation;
+
+	while (true)
+	{
+		while (!quit && currentJob.generation == seenGeneration)
+			workReady.wait(lock);
+
+		if (quit)
+			return;
+
+		// Copy the job while holding the lock, as the next job may replace it while this one is running.
+		const Job job = currentJob;
+		seenGeneration = job.generation;
+
+		lock.unlock();
+		RunBatches(job);
+		lock.lock();
+	}
+}
+
+// Claims and runs batches of a job until there are none left or another job has started.
+// Params:
+//   job = The thread's copy of the job.
+void ThreadPool::RunBatches(const Job& job)
+{
+	const unsigned long long generationBits = static_cast<unsigned long long>(job.generation) << 32;
+	const unsigned long long batchMask = 0xFFFFFFFFull;
+
+	size_t finished = 0;
+	unsigned long long claim = nextBatch.load();
+	while (true)
+	{
+		// Only claim a batch if it belongs to this job and there is one left.
+		if ((claim & ~batchMask) != generationBits || (claim & batchMask) >= job.batchCount)
+			break;
+
+		if (!nextBatch.compare_exchange_weak(claim, claim + 1))
+			continue;
+
+		const size_t begin = static_cast<size_t>(claim & batchMask) * job.batchSize;
+		const size_t end = min(begin + job.batchSize, job.count);
+		job.function(job.context, begin, end);
+		++finished;
+
+		claim = nextBatch.load();
+	}
+
+	if (finished == 0)
+		return;
+
+	// The job cannot have been replaced yet, as it waits for the batches this thread claimed.
+	std::lock_guard<std::mutex> lock(mutex);
+	finishedBatches += finished;
+	if (finishedBatches == currentJob.batchCount)
+		workDone.notify_one();
+}
+
+//------------------------------------------------------------------------------
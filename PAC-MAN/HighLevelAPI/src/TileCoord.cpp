@@ -0,0 +1,103 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	TileCoord.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "TileCoord.h"
+
+// Systems
+#include <Vector2D.h>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// Constructor - creates the coordinate of tile (0, 0).
+TileCoord::TileCoord() : x(0), y(0)
+{
+}
+
+// Constructor
+// Params:
+//   x = The column of the tile.
+//   y = The row of the tile.
+TileCoord::TileCoord(int x, int y) : x(x), y(y)
+{
+}
+
+// Gets the tile containing a position in tile space.
+// Params:
+//   tileSpace = The position in tile space.
+// Returns:
+//   The tile whose column and row are the position rounded down.
+TileCoord TileCoord::Floor(const Vector2D& tileSpace)
+{
+	return TileCoord(static_cast<int>(floor(tileSpace.x)), static_cast<int>(floor(tileSpace.y)));
+}
+
+// Converts the coordinate to a position in tile space.
+Vector2D TileCoord::ToVector2D() const
+{
+	return Vector2D(static_cast<float>(x), static_cast<float>(y));
+}
+
+// Adds two coordinates.
+TileCoord TileCoord::operator+(const TileCoord& other) const
+{
+	return TileCoord(x + other.x, y + other.y);
+}
+
+// Compares two coordinates.
+bool TileCoord::operator==(const TileCoord& other) const
+{
+	return x == other.x && y == other.y;
+}
+
+bool TileCoord::operator!=(const TileCoord& other) const
+{
+	return !(*this == other);
+}
+
+// Writes a coordinate in the same format as a Vector2D, "{ x, y }".
+std::ostream& operator<<(std::ostream& os, const TileCoord& tile)
+{
+	return os << "{ " << tile.x << ", " << tile.y << " }";
+}
+
+// Reads a coordinate written in the same format as a Vector2D, "{ x, y }".
+std::istream& operator>>(std::istream& is, TileCoord& tile)
+{
+	is.ignore(10, '{');
+	is >> tile.x;
+	is.ignore(10, ',');
+	is >> tile.y;
+	is.ignore(10, '}');
+	return is;
+}
+
+// Hashing, so coordinates can be used as keys in unordered containers.
+size_t std::hash<TileCoord>::operator()(const TileCoord& tile) const
+{
+	// Pack both coordinates into one value, so neighboring tiles never share a hash.
+	return std::hash<unsigned long long>()((static_cast<unsigned long long>(static_cast<unsigned>(tile.x)) << 32) | static_cast<unsigned>(tile.y));
+}
+
+//------------------------------------------------------------------------------
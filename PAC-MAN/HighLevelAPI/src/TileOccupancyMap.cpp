@@ -0,0 +1,181 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	TileOccupancyMap.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "TileOccupancyMap.h"
+
+// Systems
+#include "GameObject.h"
+#include <Vector2D.h>
+
+// Components
+#include "SpriteTilemap.h"
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// Constructor
+TileOccupancyMap::TileOccupancyMap() : spriteTilemap(nullptr)
+{
+}
+
+// Sets the sprite tilemap used to convert world positions into tiles.
+// Params:
+//   spriteTilemap = The sprite tilemap of the space's grid, or nullptr if there is none.
+void TileOccupancyMap::SetSpriteTilemap(const SpriteTilemap* spriteTilemap_)
+{
+	spriteTilemap = spriteTilemap_;
+}
+
+// Gets the sprite tilemap used to convert world positions into tiles.
+const SpriteTilemap* TileOccupancyMap::GetSpriteTilemap() const
+{
+	return spriteTilemap;
+}
+
+// Converts a world position to the nearest tile coordinate.
+// Params:
+//   worldPosition = The position in world space.
+//   x = Receives the column of the tile.
+//   y = Receives the row of the tile.
+// Returns:
+//   False if there is no sprite tilemap to convert with.
+bool TileOccupancyMap::WorldToTile(const Vector2D& worldPosition, int& x, int& y) const
+{
+	if (spriteTilemap == nullptr)
+		return false;
+
+	Vector2D tile = spriteTilemap->WorldToTile(worldPosition);
+	x = static_cast<int>(floor(tile.x + 0.5f));
+	y = static_cast<int>(floor(tile.y + 0.5f));
+	return true;
+}
+
+// Places an object on a tile, moving it off of its previous tile if it had one.
+// Params:
+//   object = The object being placed.
+//   x = The column of the tile.
+//   y = The row of the tile.
+void TileOccupancyMap::Place(GameObject& object, int x, int y)
+{
+	const long long key = TileKey(x, y);
+
+	auto found = objectTiles.find(&object);
+	if (found != objectTiles.end())
+	{
+		// The object has not changed tiles.
+		if (found->second == key)
+			return;
+
+		Remove(object);
+	}
+
+	tiles[key].push_back(&object);
+	objectTiles[&object] = key;
+}
+
+// Removes an object from the tile it is on. Does nothing if the object has not been placed.
+// Params:
+//   object = The object being removed.
+void TileOccupancyMap::Remove(GameObject& object)
+{
+	auto found = objectTiles.find(&object);
+	if (found == objectTiles.end())
+		return;
+
+	std::vector<GameObject*>& occupants = tiles[found->second];
+	for (auto it = occupants.begin(); it != occupants.end(); ++it)
+	{
+		if (*it == &object)
+		{
+			// Keep the remaining occupants in the order they arrived.
+			occupants.erase(it);
+			break;
+		}
+	}
+
+	objectTiles.erase(found);
+}
+
+// Gets the tile an object was placed on.
+// Params:
+//   object = The object to look up.
+//   x = Receives the column of the tile.
+//   y = Receives the row of the tile.
+// Returns:
+//   False if the object has not been placed.
+bool TileOccupancyMap::GetTile(const GameObject& object, int& x, int& y) const
+{
+	auto found = objectTiles.find(&object);
+	if (found == objectTiles.end())
+		return false;
+
+	x = static_cast<int>(found->second >> 32);
+	y = static_cast<int>(static_cast<unsigned>(found->second & 0xFFFFFFFF));
+	return true;
+}
+
+// Fills out a vector with every object on a tile, skipping destroyed objects. Does NOT clear the vector beforehand.
+// Params:
+//   x = The column of the tile.
+//   y = The row of the tile.
+//   objectList = A reference to a vector of game object pointers which will be filled with the found game objects.
+// Returns:
+//   The number of game objects found.
+size_t TileOccupancyMap::GetObjectsAt(int x, int y, std::vector<GameObject*>& objectList) const
+{
+	auto found = tiles.find(TileKey(x, y));
+	if (found == tiles.end())
+		return 0;
+
+	size_t count = 0;
+	for (auto it = found->second.begin(); it != found->second.end(); ++it)
+	{
+		if (!(*it)->IsDestroyed())
+		{
+			objectList.push_back(*it);
+			++count;
+		}
+	}
+
+	return count;
+}
+
+// Removes every object from the map.
+void TileOccupancyMap::Clear()
+{
+	tiles.clear();
+	objectTiles.clear();
+}
+
+//------------------------------------------------------------------------------
+// Private Functions:
+//------------------------------------------------------------------------------
+
+// Packs a tile coordinate into a hash key.
+long long TileOccupancyMap::TileKey(int x, int y)
+{
+	return static_cast<long long>((static_cast<unsigned long long>(static_cast<unsigned>(x)) << 32) | static_cast<unsigned>(y));
+}
+
+//------------------------------------------------------------------------------
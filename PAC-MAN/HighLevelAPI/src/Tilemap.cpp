@@ -18,6 +18,8 @@
 #include "Tilemap.h"
 
 #include "Matrix2DStudent.h"
+#include "MappedFile.h"
+#include "TilemapStreamer.h"
 
 //------------------------------------------------------------------------------
 
@@ -25,6 +27,8 @@
 // Public Structures:
 //------------------------------------------------------------------------------
 
+const char Tilemap::binaryMagic[4] = { 'T', 'M', 'B', 0x1A };
+
 //------------------------------------------------------------------------------
 // Public Functions:
 //------------------------------------------------------------------------------
@@ -33,22 +37,34 @@
 // Params:
 //   numColumns = The width of the map.
 //   numRows = The height of the map.
-//   data = The array containing the map data.
-Tilemap::Tilemap(unsigned numColumns, unsigned numRows, int** data) : numColumns(numColumns), numRows(numRows), data(data)
-{
-}
-
-// Destructor.
-Tilemap::~Tilemap()
+//   data = The array containing the map data, indexed by [column][row]. Values must be between 0 and 65535.
+//     The tilemap copies the values into its own storage and deletes the array.
+Tilemap::Tilemap(unsigned numColumns, unsigned numRows, int** data) : numColumns(numColumns), numRows(numRows),
+	cellFormat(CELL_UINT8), cells(nullptr), mappedFile(nullptr), streamer(nullptr),
+	hasChanges(false), changedMinColumn(0), changedMinRow(0), changedMaxColumn(0), changedMaxRow(0), flushing(false)
 {
-	// Delete all allocated rows.
+	// Flatten the columns into rows.
+	std::vector<int> values(static_cast<size_t>(numColumns) * numRows);
 	for (unsigned column = 0; column < numColumns; column++)
 	{
+		for (unsigned row = 0; row < numRows; row++)
+		{
+			values[static_cast<size_t>(row) * numColumns + column] = data[column][row];
+		}
+
 		delete[] data[column];
 	}
 
-	// Delete the container column array.
 	delete[] data;
+
+	SetCells(values);
+}
+
+// Destructor.
+Tilemap::~Tilemap()
+{
+	delete mappedFile;
+	delete streamer;
 }
 
 // Gets the width of the map (in tiles).
@@ -76,13 +92,394 @@ int Tilemap::GetCellValue(unsigned column, unsigned row) const
 	if (column >= numColumns || row >= numRows)
 		return -1;
 
-	return data[column][row];
+	if (streamer != nullptr)
+		return streamer->GetCellValue(column, row);
+
+	const size_t index = static_cast<size_t>(row) * numColumns + column;
+	if (cellFormat == CELL_UINT8)
+		return cells[index];
+
+	return reinterpret_cast<const unsigned short*>(cells)[index];
+}
+
+// Sets the value of the cell in the map with the given indices, and adds it to the changed region.
+//   Cells of a mapped binary file are copied into the tilemap's own storage first, and 8-bit cells
+//   are widened if the value does not fit.
+// Params:
+//   column = The column of the cell.
+//   row = The row of the cell.
+//   value = The new value, between 0 and 65535.
+// Returns:
+//   False if the indices or the value are invalid, or the map is streamed.
+bool Tilemap::SetCellValue(unsigned column, unsigned row, int value)
+{
+	if (column >= numColumns || row >= numRows || value < 0 || value > 0xFFFF || streamer != nullptr)
+		return false;
+
+	if (GetCellValue(column, row) == value)
+		return true;
+
+	const size_t index = static_cast<size_t>(row) * numColumns + column;
+
+	// Mapped cells are read-only, and 8-bit cells cannot hold the value, so store the cells again.
+	if (mappedFile != nullptr || (cellFormat == CELL_UINT8 && value > 0xFF))
+	{
+		std::vector<int> values(static_cast<size_t>(numColumns) * numRows);
+		for (unsigned y = 0; y < numRows; ++y)
+			GetSpan(0, y, numColumns, &values[static_cast<size_t>(y) * numColumns]);
+
+		values[index] = value;
+		SetCells(values);
+
+		delete mappedFile;
+		mappedFile = nullptr;
+	}
+	else if (cellFormat == CELL_UINT8)
+	{
+		ownedCells[index] = static_cast<unsigned char>(value);
+	}
+	else
+	{
+		reinterpret_cast<unsigned short*>(ownedCells.data())[index] = static_cast<unsigned short>(value);
+	}
+
+	// Grow the changed region to include the cell.
+	const int x = static_cast<int>(column);
+	const int y = static_cast<int>(row);
+	if (!hasChanges)
+	{
+		hasChanges = true;
+		changedMinColumn = changedMaxColumn = x;
+		changedMinRow = changedMaxRow = y;
+	}
+	else
+	{
+		changedMinColumn = min(changedMinColumn, x);
+		changedMinRow = min(changedMinRow, y);
+		changedMaxColumn = max(changedMaxColumn, x);
+		changedMaxRow = max(changedMaxRow, y);
+	}
+
+	return true;
+}
+
+// Gets the rectangle containing every cell changed since the last flush.
+// Params:
+//   minColumn = Receives the left edge of the rectangle.
+//   minRow = Receives the top edge of the rectangle.
+//   maxColumn = Receives the right edge of the rectangle.
+//   maxRow = Receives the bottom edge of the rectangle.
+// Returns:
+//   False if no cells have changed.
+bool Tilemap::GetChangedRegion(int& minColumn, int& minRow, int& maxColumn, int& maxRow) const
+{
+	if (!hasChanges)
+		return false;
+
+	minColumn = changedMinColumn;
+	minRow = changedMinRow;
+	maxColumn = changedMaxColumn;
+	maxRow = changedMaxRow;
+	return true;
+}
+
+// Passes the changed region to every subscriber and clears it. Does nothing if no cells have
+//   changed. Call once per frame, before the subscribers' caches are used.
+void Tilemap::FlushChanges()
+{
+	if (!hasChanges)
+		return;
+
+	// Take the region and clear it first, so a subscriber that changes cells starts a new region
+	//   without changing the one the remaining subscribers are given.
+	const int minColumn = changedMinColumn;
+	const int minRow = changedMinRow;
+	const int maxColumn = changedMaxColumn;
+	const int maxRow = changedMaxRow;
+	hasChanges = false;
+
+	// Loop by index, since a subscriber may subscribe while it is called. Subscribers that unsubscribe
+	//   are only marked, so the ones after them keep their place and are still called.
+	const bool outerFlush = !flushing;
+	flushing = true;
+	for (size_t i = 0; i < subscribers.size(); ++i)
+	{
+		if (subscribers[i].handler != nullptr)
+			subscribers[i].handler(subscribers[i].context, *this, minColumn, minRow, maxColumn, maxRow);
+	}
+
+	// A subscriber may flush again while it is called, so only the outermost flush removes the marked subscribers.
+	if (outerFlush)
+	{
+		flushing = false;
+		subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(), IsUnsubscribed), subscribers.end());
+	}
+}
+
+// Registers a function to call with the changed region whenever changes are flushed.
+// Params:
+//   handler = The function to call.
+//   context = A pointer passed to the function, usually the subscriber.
+void Tilemap::Subscribe(TilemapChangeHandler handler, void* context) const
+{
+	Subscriber subscriber = { handler, context };
+	subscribers.push_back(subscriber);
+}
+
+// Removes a function registered with Subscribe. Subscribers must unsubscribe before they are destroyed.
+//   A subscriber may unsubscribe while it is called, and the other subscribers are still called.
+// Params:
+//   handler = The function that was registered.
+//   context = The pointer it was registered with.
+void Tilemap::Unsubscribe(TilemapChangeHandler handler, void* context) const
+{
+	for (auto it = subscribers.begin(); it != subscribers.end(); ++it)
+	{
+		if (it->handler == handler && it->context == context)
+		{
+			// Subscribers are being looped over, so leave the entry in place until the flush is done.
+			if (flushing)
+			{
+				it->handler = nullptr;
+				it->context = nullptr;
+				return;
+			}
+
+			// Keep the remaining subscribers in the order they subscribed.
+			subscribers.erase(it);
+			return;
+		}
+	}
+}
+
+// Gets how the cells of the map are stored.
+Tilemap::CellFormat Tilemap::GetCellFormat() const
+{
+	return cellFormat;
+}
+
+// Gets the cells of a row of a map stored with 8-bit cells.
+// Params:
+//   row = The row to get.
+// Returns:
+//   A pointer to the first of GetWidth() cells, or nullptr if the row is invalid or the map uses another format.
+const unsigned char* Tilemap::GetRow8(unsigned row) const
+{
+	if (cellFormat != CELL_UINT8 || row >= numRows || streamer != nullptr)
+		return nullptr;
+
+	return cells + static_cast<size_t>(row) * numColumns;
+}
+
+// Gets the cells of a row of a map stored with 16-bit cells.
+// Params:
+//   row = The row to get.
+// Returns:
+//   A pointer to the first of GetWidth() cells, or nullptr if the row is invalid or the map uses another format.
+const unsigned short* Tilemap::GetRow16(unsigned row) const
+{
+	if (cellFormat != CELL_UINT16 || row >= numRows || streamer != nullptr)
+		return nullptr;
+
+	return reinterpret_cast<const unsigned short*>(cells) + static_cast<size_t>(row) * numColumns;
+}
+
+// Copies the values of consecutive cells in a row, regardless of how the map is stored.
+// Params:
+//   column = The column of the first cell.
+//   row = The row of the cells.
+//   count = How many cells to copy.
+//   values = The array to copy the values into. Must have room for count values.
+// Returns:
+//   The number of values copied, which is less than count if the span runs past the end of the row.
+unsigned Tilemap::GetSpan(unsigned column, unsigned row, unsigned count, int* values) const
+{
+	if (column >= numColumns || row >= numRows)
+		return 0;
+
+	if (count > numColumns - column)
+		count = numColumns - column;
+
+	if (streamer != nullptr)
+	{
+		streamer->GetSpan(column, row, count, values);
+		return count;
+	}
+
+	const size_t start = static_cast<size_t>(row) * numColumns + column;
+	if (cellFormat == CELL_UINT8)
+	{
+		const unsigned char* rowCells = cells + start;
+		for (unsigned i = 0; i < count; ++i)
+			values[i] = rowCells[i];
+	}
+	else
+	{
+		const unsigned short* rowCells = reinterpret_cast<const unsigned short*>(cells) + start;
+		for (unsigned i = 0; i < count; ++i)
+			values[i] = rowCells[i];
+	}
+
+	return count;
 }
 
-// Create a tilemap from the given file.
+// Create a tilemap from the given file. If a binary copy of the file (with the .tmb extension)
+//   exists and is not older than the text file, it is loaded instead of the text file.
 // Params:
 //   filename = The name of the file containing the tilemap data.
 Tilemap* Tilemap::CreateTilemapFromFile(const std::string& filename)
+{
+	// A binary copy that is older than the text file is out of date, so the text file is loaded instead.
+	if (IsBinaryFileCurrent(filename))
+	{
+		Tilemap* tilemap = CreateTilemapFromBinaryFile(GetBinaryFilename(filename));
+		if (tilemap != nullptr)
+			return tilemap;
+	}
+
+	return CreateTilemapFromTextFile(filename);
+}
+
+// Create a tilemap from the given file like the function above, but stream it in chunks with
+//   CreateStreamingTilemap if it has too many cells to keep in memory. Add the tilemap to its space
+//   with Space::AddStreamingTilemap either way, which does nothing if it is not streamed.
+// Params:
+//   filename = The name of the file containing the tilemap data.
+//   streamingCellCount = The number of cells from which the tilemap is streamed.
+// Returns:
+//   The tilemap, or nullptr if the file could not be loaded.
+Tilemap* Tilemap::CreateTilemapFromFile(const std::string& filename, size_t streamingCellCount)
+{
+	unsigned width;
+	unsigned height;
+	if (ReadFileSize(filename, width, height) && static_cast<size_t>(width) * height >= streamingCellCount)
+	{
+		// If the binary copy cannot be written or opened, the whole map is loaded instead.
+		Tilemap* tilemap = CreateStreamingTilemap(filename);
+		if (tilemap != nullptr)
+			return tilemap;
+	}
+
+	return CreateTilemapFromFile(filename);
+}
+
+// Create a tilemap from a binary tilemap file. The file is mapped into memory and its cells are used
+//   in place, so the file stays open for as long as the tilemap exists.
+// Params:
+//   filename = The name of the binary tilemap file.
+// Returns:
+//   The tilemap, or nullptr if the file does not exist or is not a valid binary tilemap.
+Tilemap* Tilemap::CreateTilemapFromBinaryFile(const std::string& filename)
+{
+	MappedFile* file = new MappedFile();
+	if (!file->Open(filename) || file->GetSize() < sizeof(BinaryHeader))
+	{
+		delete file;
+		return nullptr;
+	}
+
+	BinaryHeader header;
+	size_t offset;
+	if (!ReadBinaryHeader(file->GetData(), file->GetSize(), file->GetSize(), header, offset))
+	{
+		delete file;
+		return nullptr;
+	}
+
+	const CellFormat cellFormat = header.cellWidth == 1 ? CELL_UINT8 : CELL_UINT16;
+	return new Tilemap(header.width, header.height, cellFormat, file->GetData() + offset, file);
+}
+
+// Saves the tilemap as a binary tilemap file.
+// Params:
+//   filename = The name of the file to write.
+// Returns:
+//   True if the file was written, false otherwise.
+bool Tilemap::WriteBinaryFile(const std::string& filename) const
+{
+	if (streamer != nullptr)
+		return false;
+
+	std::ofstream file(filename, std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	BinaryHeader header;
+	memcpy(header.magic, binaryMagic, sizeof(header.magic));
+	header.version = binaryVersion;
+	header.cellWidth = cellFormat == CELL_UINT8 ? 1 : 2;
+	header.width = numColumns;
+	header.height = numRows;
+	header.layerCount = 0;
+	header.reserved = 0;
+
+	// A single layer needs no layer table, so the cells follow the header.
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(cells), static_cast<std::streamsize>(numColumns) * numRows * header.cellWidth);
+
+	return file.good();
+}
+
+// Converts a text tilemap file to a binary one with the same name and the .tmb extension.
+// Params:
+//   filename = The name of the text tilemap file.
+// Returns:
+//   True if the binary file was written, false otherwise.
+bool Tilemap::ConvertToBinaryFile(const std::string& filename)
+{
+	Tilemap* tilemap = CreateTilemapFromTextFile(filename);
+	if (tilemap == nullptr)
+		return false;
+
+	bool written = tilemap->WriteBinaryFile(GetBinaryFilename(filename));
+	delete tilemap;
+	return written;
+}
+
+// Create a tilemap that streams its cells from the binary copy of a tilemap file (with the .tmb
+//   extension) in chunks, for maps too large to keep in memory. The chunks near the camera and
+//   moving objects are kept loaded; see TilemapStreamer. If the text file is newer than the binary
+//   copy, the binary copy is converted again first. Add the tilemap to its space with
+//   Space::AddStreamingTilemap, so its streamer is updated every frame.
+// Params:
+//   filename = The name of the file containing the tilemap data.
+//   chunkSize = The width and height of each chunk, in tiles.
+//   maxResidentChunks = How many chunks may stay in memory at once.
+// Returns:
+//   The tilemap, or nullptr if the binary file does not exist or is not valid.
+Tilemap* Tilemap::CreateStreamingTilemap(const std::string& filename, unsigned chunkSize, size_t maxResidentChunks)
+{
+	// Streaming only reads the binary copy, so it is brought up to date with the text file first.
+	//   Maps that only exist as binary files are streamed as they are.
+	if (!IsBinaryFileCurrent(filename))
+		ConvertToBinaryFile(filename);
+
+	TilemapStreamer* streamer = new TilemapStreamer(chunkSize, maxResidentChunks);
+	if (!streamer->Open(GetBinaryFilename(filename)))
+	{
+		delete streamer;
+		return nullptr;
+	}
+
+	return new Tilemap(streamer);
+}
+
+// Gets the streamer that loads the cells of a streaming tilemap.
+// Returns:
+//   The streamer, or nullptr if the whole map is in memory.
+TilemapStreamer* Tilemap::GetStreamer() const
+{
+	return streamer;
+}
+
+//------------------------------------------------------------------------------
+// Private Functions:
+//------------------------------------------------------------------------------
+
+// Create a tilemap from a text tilemap file.
+// Params:
+//   filename = The name of the file containing the tilemap data.
+Tilemap* Tilemap::CreateTilemapFromTextFile(const std::string& filename)
 {
 	std::ifstream file(filename);
 
@@ -101,17 +498,129 @@ Tilemap* Tilemap::CreateTilemapFromFile(const std::string& filename)
 		return nullptr;
 
 	// Read the map array.
-	int** data = ReadArrayVariable(file, "data", numColumns, numRows);
-	if (data == nullptr)
+	std::vector<int> values;
+	if (!ReadArrayVariable(file, "data", numColumns, numRows, values))
 		return nullptr;
 	
 	// Create the tilemap.
-	return new Tilemap(numColumns, numRows, data);
+	return new Tilemap(numColumns, numRows, values);
 }
 
-//------------------------------------------------------------------------------
-// Private Functions:
-//------------------------------------------------------------------------------
+// Reads and verifies the header of a binary tilemap file.
+// Params:
+//   data = The start of the file.
+//   dataSize = How many bytes of the file are in data.
+//   fileSize = The size of the whole file in bytes.
+//   header = Receives the header.
+//   cellOffset = Receives the offset of the first layer's cells from the start of the file.
+// Returns:
+//   True if the header is valid and every cell of the first layer is inside the file, false otherwise.
+bool Tilemap::ReadBinaryHeader(const unsigned char* data, size_t dataSize, size_t fileSize, BinaryHeader& header, size_t& cellOffset)
+{
+	if (dataSize < sizeof(BinaryHeader))
+		return false;
+
+	// Verify the header.
+	memcpy(&header, data, sizeof(header));
+	if (memcmp(header.magic, binaryMagic, sizeof(header.magic)) != 0 || header.version != binaryVersion
+		|| (header.cellWidth != 1 && header.cellWidth != 2))
+		return false;
+
+	// Find the cells of the first layer.
+	cellOffset = sizeof(BinaryHeader);
+	if (header.layerCount > 0)
+	{
+		if (dataSize < sizeof(BinaryHeader) + sizeof(BinaryLayer))
+			return false;
+
+		BinaryLayer layer;
+		memcpy(&layer, data + sizeof(BinaryHeader), sizeof(layer));
+		cellOffset = layer.offset;
+	}
+
+	// Make sure every cell is inside the file, and that 16-bit cells are aligned.
+	const size_t cellBytes = static_cast<size_t>(header.width) * header.height * header.cellWidth;
+	return cellOffset % header.cellWidth == 0 && cellOffset <= fileSize && cellBytes <= fileSize - cellOffset;
+}
+
+// Gets the name of the binary copy of a tilemap file.
+// Params:
+//   filename = The name of the tilemap file.
+// Returns:
+//   The name with its extension replaced by .tmb.
+std::string Tilemap::GetBinaryFilename(const std::string& filename)
+{
+	const size_t extension = filename.find_last_of('.');
+	const size_t directory = filename.find_last_of("/\\");
+	if (extension == std::string::npos || (directory != std::string::npos && extension < directory))
+		return filename + ".tmb";
+
+	return filename.substr(0, extension) + ".tmb";
+}
+
+// Checks whether the binary copy of a tilemap file exists and is at least as new as the text file.
+// Params:
+//   filename = The name of the text tilemap file.
+// Returns:
+//   True if the binary copy exists, and the text file does not exist or was not modified after it.
+bool Tilemap::IsBinaryFileCurrent(const std::string& filename)
+{
+	WIN32_FILE_ATTRIBUTE_DATA binaryAttributes;
+	if (!GetFileAttributesExA(GetBinaryFilename(filename).c_str(), GetFileExInfoStandard, &binaryAttributes))
+		return false;
+
+	WIN32_FILE_ATTRIBUTE_DATA textAttributes;
+	if (!GetFileAttributesExA(filename.c_str(), GetFileExInfoStandard, &textAttributes))
+		return true;
+
+	return CompareFileTime(&textAttributes.ftLastWriteTime, &binaryAttributes.ftLastWriteTime) <= 0;
+}
+
+// Reads the size of a tilemap without loading its cells, from the binary copy if it is current.
+// Params:
+//   filename = The name of the text tilemap file.
+//   width = Receives the number of columns.
+//   height = Receives the number of rows.
+// Returns:
+//   True if the size was read, false if neither file has a valid header.
+bool Tilemap::ReadFileSize(const std::string& filename, unsigned& width, unsigned& height)
+{
+	if (IsBinaryFileCurrent(filename))
+	{
+		std::ifstream binaryFile(GetBinaryFilename(filename), std::ios::binary | std::ios::ate);
+		if (binaryFile.is_open())
+		{
+			// Read enough of the file for the header and the first layer table entry.
+			const size_t fileSize = static_cast<size_t>(binaryFile.tellg());
+			binaryFile.seekg(0, std::ios::beg);
+
+			unsigned char start[sizeof(BinaryHeader) + sizeof(BinaryLayer)];
+			const size_t startSize = min(fileSize, sizeof(start));
+			binaryFile.read(reinterpret_cast<char*>(start), startSize);
+
+			BinaryHeader header;
+			size_t cellOffset;
+			if (binaryFile.good() && ReadBinaryHeader(start, startSize, fileSize, header, cellOffset))
+			{
+				width = header.width;
+				height = header.height;
+				return true;
+			}
+		}
+	}
+
+	// The text file starts with its size.
+	std::ifstream file(filename);
+	int numColumns;
+	int numRows;
+	if (!file.is_open() || !ReadIntegerVariable(file, "width", numColumns) || !ReadIntegerVariable(file, "height", numRows)
+		|| numColumns <= 0 || numRows <= 0)
+		return false;
+
+	width = static_cast<unsigned>(numColumns);
+	height = static_cast<unsigned>(numRows);
+	return true;
+}
 
 // Helper function for reading in values of integers.
 // Params:
@@ -142,10 +651,11 @@ bool Tilemap::ReadIntegerVariable(std::ifstream& file, const std::string& name,
 //   name = The text to look for before reading the array.
 //   columns = The number of columns in the array.
 //   rows = The number of rows in the array.
+//   values = The vector to fill with the values, in row-major order.
 // Returns:
-//   A pointer to the dynamically allocated array if the data is valid, nullptr otherwise.
-int** Tilemap::ReadArrayVariable(std::ifstream& file, const std::string& name,
-	unsigned columns, unsigned rows)
+//   True if the data is valid, false otherwise.
+bool Tilemap::ReadArrayVariable(std::ifstream& file, const std::string& name,
+	unsigned columns, unsigned rows, std::vector<int>& values)
 {
 	// Read the property name.
 	std::string word = "";
@@ -153,25 +663,89 @@ int** Tilemap::ReadArrayVariable(std::ifstream& file, const std::string& name,
 
 	// If the property name is not what was expected, exit.
 	if (word != name)
-		return nullptr;
+		return false;
 
-	// Allocate the new 2D array.
-	int** arr = new int*[columns];
-	for (unsigned column = 0; column < columns; column++)
+	// Read the values.
+	values.resize(static_cast<size_t>(columns) * rows);
+	for (auto it = values.begin(); it != values.end(); ++it)
 	{
-		arr[column] = new int[rows];
+		file >> *it;
+
+		// Cells are stored in at most 16 bits.
+		if (*it < 0 || *it > 0xFFFF)
+			return false;
 	}
 
-	// Read the values.
-	for (unsigned row = 0; row < rows; row++)
+	return true;
+}
+
+// Create a tilemap from values in row-major order.
+// Params:
+//   numColumns = The width of the map.
+//   numRows = The height of the map.
+//   values = The values of the cells. Values must be between 0 and 65535.
+Tilemap::Tilemap(unsigned numColumns, unsigned numRows, const std::vector<int>& values) : numColumns(numColumns), numRows(numRows),
+	cellFormat(CELL_UINT8), cells(nullptr), mappedFile(nullptr), streamer(nullptr),
+	hasChanges(false), changedMinColumn(0), changedMinRow(0), changedMaxColumn(0), changedMaxRow(0), flushing(false)
+{
+	SetCells(values);
+}
+
+// Create a tilemap whose cells are stored in a mapped file.
+// Params:
+//   numColumns = The width of the map.
+//   numRows = The height of the map.
+//   cellFormat = How the cells are stored.
+//   cells = The first cell in the mapped file.
+//   mappedFile = The mapped file. The tilemap takes ownership of it.
+Tilemap::Tilemap(unsigned numColumns, unsigned numRows, CellFormat cellFormat, const unsigned char* cells, MappedFile* mappedFile)
+	: numColumns(numColumns), numRows(numRows), cellFormat(cellFormat), cells(cells), mappedFile(mappedFile), streamer(nullptr),
+	hasChanges(false), changedMinColumn(0), changedMinRow(0), changedMaxColumn(0), changedMaxRow(0), flushing(false)
+{
+}
+
+// Create a tilemap whose cells are loaded by a streamer.
+// Params:
+//   streamer = The opened streamer. The tilemap takes ownership of it.
+Tilemap::Tilemap(TilemapStreamer* streamer) : numColumns(streamer->GetWidth()), numRows(streamer->GetHeight()),
+	cellFormat(streamer->GetCellWidth() == 1 ? CELL_UINT8 : CELL_UINT16), cells(nullptr), mappedFile(nullptr), streamer(streamer),
+	hasChanges(false), changedMinColumn(0), changedMinRow(0), changedMaxColumn(0), changedMaxRow(0), flushing(false)
+{
+}
+
+// Stores the values of the cells in the smallest format that fits them.
+// Params:
+//   values = The values of the cells in row-major order.
+void Tilemap::SetCells(const std::vector<int>& values)
+{
+	int maxValue = 0;
+	for (auto it = values.begin(); it != values.end(); ++it)
+		maxValue = max(maxValue, *it);
+
+	if (maxValue <= 0xFF)
 	{
-		for (unsigned column = 0; column < columns; column++)
-		{
-			file >> arr[column][row];
-		}
+		cellFormat = CELL_UINT8;
+		ownedCells.resize(values.size());
+		for (size_t i = 0; i < values.size(); ++i)
+			ownedCells[i] = static_cast<unsigned char>(values[i]);
+	}
+	else
+	{
+		// The buffer comes from the general allocator, so it is aligned for 16-bit cells.
+		cellFormat = CELL_UINT16;
+		ownedCells.resize(values.size() * sizeof(unsigned short));
+		unsigned short* cells16 = reinterpret_cast<unsigned short*>(ownedCells.data());
+		for (size_t i = 0; i < values.size(); ++i)
+			cells16[i] = static_cast<unsigned short>(values[i]);
 	}
 
-	return arr;
+	cells = ownedCells.data();
+}
+
+// Checks whether a subscriber unsubscribed during a flush.
+bool Tilemap::IsUnsubscribed(const Subscriber& subscriber)
+{
+	return subscriber.handler == nullptr;
 }
 
 //------------------------------------------------------------------------------
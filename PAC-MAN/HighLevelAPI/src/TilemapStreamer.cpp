@@ -0,0 +1,372 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	TilemapStreamer.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "TilemapStreamer.h"
+
+// Systems
+#include "Tilemap.h"
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// Constructor
+// Params:
+//   chunkSize = The width and height of each chunk, in tiles.
+//   maxResidentChunks = How many chunks may stay in memory before the least recently used are evicted.
+TilemapStreamer::TilemapStreamer(unsigned chunkSize, size_t maxResidentChunks) : width(0), height(0), cellWidth(1), cellOffset(0),
+	chunkSize(chunkSize), chunkColumns(0), chunkRows(0), maxResidentChunks(maxResidentChunks), frame(0), missCount(0), stopping(false)
+{
+}
+
+// Destructor - stops the loader thread and frees every chunk.
+TilemapStreamer::~TilemapStreamer()
+{
+	if (loader.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+
+		condition.notify_one();
+		loader.join();
+	}
+
+	for (auto it = chunks.begin(); it != chunks.end(); ++it)
+		delete *it;
+
+	for (auto it = loadedChunks.begin(); it != loadedChunks.end(); ++it)
+		delete it->second;
+}
+
+// Opens a binary tilemap file and starts the loader thread.
+// Params:
+//   filename = The name of the binary tilemap file.
+// Returns:
+//   True if the file is a valid binary tilemap, false otherwise.
+bool TilemapStreamer::Open(const std::string& filename_)
+{
+	file.open(filename_, std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	// Read enough of the file for the header and the first layer table entry.
+	file.seekg(0, std::ios::end);
+	const size_t fileSize = static_cast<size_t>(file.tellg());
+	file.seekg(0, std::ios::beg);
+
+	unsigned char start[sizeof(Tilemap::BinaryHeader) + sizeof(Tilemap::BinaryLayer)];
+	const size_t startSize = min(fileSize, sizeof(start));
+	file.read(reinterpret_cast<char*>(start), startSize);
+
+	Tilemap::BinaryHeader header;
+	if (!file.good() || !Tilemap::ReadBinaryHeader(start, startSize, fileSize, header, cellOffset) || chunkSize == 0)
+	{
+		file.close();
+		return false;
+	}
+
+	filename = filename_;
+	width = header.width;
+	height = header.height;
+	cellWidth = header.cellWidth;
+
+	chunkColumns = (width + chunkSize - 1) / chunkSize;
+	chunkRows = (height + chunkSize - 1) / chunkSize;
+	chunks.assign(static_cast<size_t>(chunkColumns) * chunkRows, nullptr);
+	chunkStates.assign(chunks.size(), CHUNK_ABSENT);
+
+	loader = std::thread(&TilemapStreamer::LoaderThread, this);
+	return true;
+}
+
+// Gets the width of the map (in tiles).
+unsigned TilemapStreamer::GetWidth() const
+{
+	return width;
+}
+
+// Gets the height of the map (in tiles).
+unsigned TilemapStreamer::GetHeight() const
+{
+	return height;
+}
+
+// Gets the size of each cell in bytes, either 1 or 2.
+unsigned TilemapStreamer::GetCellWidth() const
+{
+	return cellWidth;
+}
+
+// Gets the value of a cell, reading its chunk from the file if it is not in memory.
+// Params:
+//   column = The column of the cell. Must be less than the width.
+//   row = The row of the cell. Must be less than the height.
+int TilemapStreamer::GetCellValue(unsigned column, unsigned row)
+{
+	const Chunk* chunk = GetChunk((row / chunkSize) * chunkColumns + column / chunkSize);
+	const size_t index = static_cast<size_t>(row % chunkSize) * chunkSize + column % chunkSize;
+
+	if (cellWidth == 1)
+		return chunk->cells[index];
+
+	return reinterpret_cast<const unsigned short*>(chunk->cells.data())[index];
+}
+
+// Copies the values of consecutive cells in a row.
+// Params:
+//   column = The column of the first cell.
+//   row = The row of the cells. Must be less than the height.
+//   count = How many cells to copy. The span must not run past the end of the row.
+//   values = The array to copy the values into.
+void TilemapStreamer::GetSpan(unsigned column, unsigned row, unsigned count, int* values)
+{
+	// Copy one chunk's part of the row at a time.
+	while (count > 0)
+	{
+		const Chunk* chunk = GetChunk((row / chunkSize) * chunkColumns + column / chunkSize);
+		const unsigned chunkColumn = column % chunkSize;
+		const unsigned spanCount = min(count, chunkSize - chunkColumn);
+		const size_t start = static_cast<size_t>(row % chunkSize) * chunkSize + chunkColumn;
+
+		if (cellWidth == 1)
+		{
+			const unsigned char* cells = chunk->cells.data() + start;
+			for (unsigned i = 0; i < spanCount; ++i)
+				values[i] = cells[i];
+		}
+		else
+		{
+			const unsigned short* cells = reinterpret_cast<const unsigned short*>(chunk->cells.data()) + start;
+			for (unsigned i = 0; i < spanCount; ++i)
+				values[i] = cells[i];
+		}
+
+		column += spanCount;
+		values += spanCount;
+		count -= spanCount;
+	}
+}
+
+// Requests every chunk overlapping a rectangle of tiles for the next update. Focus is cleared after each update.
+// Params:
+//   minColumn = The left edge of the rectangle.
+//   minRow = The top edge of the rectangle.
+//   maxColumn = The right edge of the rectangle.
+//   maxRow = The bottom edge of the rectangle.
+void TilemapStreamer::AddFocus(int minColumn, int minRow, int maxColumn, int maxRow)
+{
+	// Clip the rectangle to the map.
+	minColumn = max(minColumn, 0);
+	minRow = max(minRow, 0);
+	maxColumn = min(maxColumn, static_cast<int>(width) - 1);
+	maxRow = min(maxRow, static_cast<int>(height) - 1);
+	if (minColumn > maxColumn || minRow > maxRow)
+		return;
+
+	const unsigned minChunkColumn = static_cast<unsigned>(minColumn) / chunkSize;
+	const unsigned maxChunkColumn = static_cast<unsigned>(maxColumn) / chunkSize;
+	const unsigned minChunkRow = static_cast<unsigned>(minRow) / chunkSize;
+	const unsigned maxChunkRow = static_cast<unsigned>(maxRow) / chunkSize;
+
+	for (unsigned chunkRow = minChunkRow; chunkRow <= maxChunkRow; ++chunkRow)
+	{
+		for (unsigned chunkColumn = minChunkColumn; chunkColumn <= maxChunkColumn; ++chunkColumn)
+			focusChunks.push_back(chunkRow * chunkColumns + chunkColumn);
+	}
+}
+
+// Keeps chunks in the focus loaded, starts streaming any that are missing, takes in the chunks
+//   the loader thread has finished, and evicts chunks until the budget is met. Call once per frame,
+//   usually by adding the tilemap to its space with Space::AddStreamingTilemap.
+void TilemapStreamer::Update()
+{
+	// Take in the chunks the loader thread has finished, and queue the missing chunks in focus. The finished
+	//   chunks are stamped with the previous frame, so the ones that left the focus while loading can be evicted.
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		for (auto it = loadedChunks.begin(); it != loadedChunks.end(); ++it)
+		{
+			// The chunk may have been read immediately while it was waiting.
+			if (chunkStates[it->first] == CHUNK_RESIDENT)
+				delete it->second;
+			else
+				AddChunk(it->first, it->second);
+		}
+
+		loadedChunks.clear();
+
+		for (auto it = focusChunks.begin(); it != focusChunks.end(); ++it)
+		{
+			if (chunkStates[*it] == CHUNK_ABSENT)
+			{
+				chunkStates[*it] = CHUNK_REQUESTED;
+				requests.push_back(*it);
+			}
+		}
+	}
+
+	condition.notify_one();
+	++frame;
+
+	// Chunks in focus are never evicted this frame.
+	for (auto it = focusChunks.begin(); it != focusChunks.end(); ++it)
+	{
+		if (chunks[*it] != nullptr)
+			chunks[*it]->lastUsed = frame;
+	}
+
+	focusChunks.clear();
+
+	if (residentChunks.size() <= maxResidentChunks)
+		return;
+
+	// Order the resident chunks from least to most recently used.
+	evictionOrder.clear();
+	for (auto it = residentChunks.begin(); it != residentChunks.end(); ++it)
+		evictionOrder.push_back(std::make_pair(chunks[*it]->lastUsed, *it));
+
+	std::sort(evictionOrder.begin(), evictionOrder.end());
+
+	// Evict the least recently used chunks, never touching one used this frame.
+	size_t evictCount = 0;
+	while (residentChunks.size() - evictCount > maxResidentChunks && evictionOrder[evictCount].first != frame)
+	{
+		const unsigned chunkIndex = evictionOrder[evictCount].second;
+		delete chunks[chunkIndex];
+		chunks[chunkIndex] = nullptr;
+		chunkStates[chunkIndex] = CHUNK_ABSENT;
+		++evictCount;
+	}
+
+	residentChunks.clear();
+	for (size_t i = evictCount; i < evictionOrder.size(); ++i)
+		residentChunks.push_back(evictionOrder[i].second);
+}
+
+// Gets how many chunks are in memory.
+size_t TilemapStreamer::GetResidentChunkCount() const
+{
+	return residentChunks.size();
+}
+
+// Gets how many chunks had to be read immediately because they were needed before being streamed in.
+unsigned TilemapStreamer::GetMissCount() const
+{
+	return missCount;
+}
+
+//------------------------------------------------------------------------------
+// Private Functions:
+//------------------------------------------------------------------------------
+
+// Reads a chunk from the file.
+// Params:
+//   file = The file to read from. The main thread and the loader thread each use their own.
+//   chunkIndex = The index of the chunk.
+// Returns:
+//   The new chunk.
+TilemapStreamer::Chunk* TilemapStreamer::ReadChunk(std::ifstream& chunkFile, unsigned chunkIndex) const
+{
+	const unsigned firstColumn = (chunkIndex % chunkColumns) * chunkSize;
+	const unsigned firstRow = (chunkIndex / chunkColumns) * chunkSize;
+	const unsigned columns = min(chunkSize, width - firstColumn);
+	const unsigned rows = min(chunkSize, height - firstRow);
+
+	// Cells past the edge of the map stay empty.
+	Chunk* chunk = new Chunk();
+	chunk->cells.assign(static_cast<size_t>(chunkSize) * chunkSize * cellWidth, 0);
+	chunk->lastUsed = 0;
+
+	// Each row of the chunk is a separate run of cells in the file.
+	for (unsigned row = 0; row < rows; ++row)
+	{
+		const size_t fileOffset = cellOffset + (static_cast<size_t>(firstRow + row) * width + firstColumn) * cellWidth;
+		chunkFile.seekg(static_cast<std::streamoff>(fileOffset), std::ios::beg);
+		chunkFile.read(reinterpret_cast<char*>(chunk->cells.data() + static_cast<size_t>(row) * chunkSize * cellWidth),
+			static_cast<std::streamsize>(columns) * cellWidth);
+	}
+
+	chunkFile.clear();
+	return chunk;
+}
+
+// Gets a chunk, reading it from the file if it is not in memory.
+// Params:
+//   chunkIndex = The index of the chunk.
+TilemapStreamer::Chunk* TilemapStreamer::GetChunk(unsigned chunkIndex)
+{
+	Chunk* chunk = chunks[chunkIndex];
+	if (chunk == nullptr)
+	{
+		// The chunk was not streamed in time, so read it now.
+		++missCount;
+		chunk = ReadChunk(file, chunkIndex);
+		AddChunk(chunkIndex, chunk);
+	}
+
+	chunk->lastUsed = frame;
+	return chunk;
+}
+
+// Stores a chunk that is now in memory.
+// Params:
+//   chunkIndex = The index of the chunk.
+//   chunk = The chunk.
+void TilemapStreamer::AddChunk(unsigned chunkIndex, Chunk* chunk)
+{
+	chunk->lastUsed = frame;
+	chunks[chunkIndex] = chunk;
+	chunkStates[chunkIndex] = CHUNK_RESIDENT;
+	residentChunks.push_back(chunkIndex);
+}
+
+// Reads requested chunks until the streamer is destroyed.
+void TilemapStreamer::LoaderThread()
+{
+	std::ifstream loaderFile(filename, std::ios::binary);
+
+	std::unique_lock<std::mutex> lock(mutex);
+	for (;;)
+	{
+		while (!stopping && requests.empty())
+			condition.wait(lock);
+
+		if (stopping)
+			return;
+
+		const unsigned chunkIndex = requests.front();
+		requests.pop_front();
+
+		// Read without holding the lock, so the main thread is never blocked on the disk.
+		lock.unlock();
+		Chunk* chunk = ReadChunk(loaderFile, chunkIndex);
+		lock.lock();
+
+		loadedChunks.push_back(std::make_pair(chunkIndex, chunk));
+	}
+}
+
+//------------------------------------------------------------------------------
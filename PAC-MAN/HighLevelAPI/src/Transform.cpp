@@ -19,6 +19,9 @@
 
 // Systems
 #include "../include/Parser.h"
+#include "GameObject.h"
+#include "Space.h"
+#include "PhysicsStorage.h"
 
 //------------------------------------------------------------------------------
 
@@ -40,7 +43,7 @@
 //	 y = Initial world position on the y-axis.
 Transform::Transform(float x, float y) : Component("Transform"),
 	translation(Vector2D(x, y)), scale(Vector2D(50.0f, 50.0f)), rotation(0.0f),
-	matrix(CS230::Matrix2D()), isDirty(true)
+	matrix(CS230::Matrix2D()), isDirty(true), matrixVersion(0), storage(nullptr), slot(0)
 {
 }
 
@@ -51,16 +54,56 @@ Transform::Transform(float x, float y) : Component("Transform"),
 //   rotation	 = Rotation of the object about the z-axis.
 Transform::Transform(Vector2D translation, Vector2D scale, float rotation) : Component("Transform"),
 	translation(translation), scale(scale), rotation(rotation),
-	matrix(CS230::Matrix2D()), isDirty(true)
+	matrix(CS230::Matrix2D()), isDirty(true), matrixVersion(0), storage(nullptr), slot(0)
 {
 }
 
+// Copy constructor - the copy is never bound to physics storage.
+// Params:
+//   other = The transform being copied.
+Transform::Transform(const Transform& other) : Component(other),
+	translation(other.GetTranslation()), scale(other.GetScale()), rotation(other.GetRotation()),
+	matrix(CS230::Matrix2D()), isDirty(true), matrixVersion(0), storage(nullptr), slot(0)
+{
+}
+
+// Destructor
+Transform::~Transform()
+{
+	if (storage != nullptr)
+		storage->RemoveTransform(*this);
+}
+
 // Clone the transform, returning a dynamically allocated copy.
 Component* Transform::Clone() const
 {
 	return new Transform(*this);
 }
 
+// Reset the transform to match the archetype's, so a pooled object can be reused.
+// Params:
+//   archetype = The matching component of the object's archetype.
+// Returns:
+//   True, as the transform can always be reset.
+bool Transform::Reset(const Component& archetype)
+{
+	const Transform& other = static_cast<const Transform&>(archetype);
+
+	SetTranslation(other.GetTranslation());
+	SetRotation(other.GetRotation());
+	SetScale(other.GetScale());
+
+	return true;
+}
+
+// Moves the transform's state into its space's physics storage, if the space uses one.
+void Transform::Initialize()
+{
+	PhysicsStorage* physicsStorage = GetOwner()->GetSpace()->GetObjectManager().GetPhysicsStorage();
+	if (physicsStorage != nullptr)
+		physicsStorage->AddTransform(*this);
+}
+
 // Loads object data from a file.
 // Params:
 //   parser = The parser for the file.
@@ -101,11 +144,34 @@ const CS230::Matrix2D& Transform::GetInverseMatrix()
 	return inverseMatrix;
 }
 
+// Gets a number that changes whenever the transform matrix is recalculated, so geometry
+//   built from the matrix can be cached until the transform changes.
+// Returns:
+//	 The version of the current matrix.
+unsigned Transform::GetMatrixVersion()
+{
+	CalculateMatrices();
+
+	return matrixVersion;
+}
+
 // Set the translation of a transform component.
 // Params:
 //	 translation = Reference to a translation vector.
 void Transform::SetTranslation(const Vector2D& translation_)
 {
+	if (storage != nullptr)
+	{
+		// If the given translation is different, store it and mark the current matrix as dirty.
+		if (!AlmostEqual(storage->translations[slot], translation_))
+		{
+			storage->translations[slot] = translation_;
+			storage->dirtyFlags[slot] = 1;
+		}
+
+		return;
+	}
+
 	// If the given translation is different, store it and mark the current matrix as dirty.
 	if (!AlmostEqual(translation, translation_))
 	{
@@ -119,6 +185,9 @@ void Transform::SetTranslation(const Vector2D& translation_)
 //	 A reference to the component's translation structure.
 const Vector2D& Transform::GetTranslation() const
 {
+	if (storage != nullptr)
+		return storage->translations[slot];
+
 	return translation;
 }
 
@@ -127,6 +196,18 @@ const Vector2D& Transform::GetTranslation() const
 //	 rotation = The rotation value (in radians).
 void Transform::SetRotation(float rotation_)
 {
+	if (storage != nullptr)
+	{
+		// If the given rotation is different, store it and mark the current matrix as dirty.
+		if (storage->rotations[slot] != rotation_)
+		{
+			storage->rotations[slot] = rotation_;
+			storage->dirtyFlags[slot] = 1;
+		}
+
+		return;
+	}
+
 	// If the given rotation is different, store it and mark the current matrix as dirty.
 	if (rotation != rotation_)
 	{
@@ -140,6 +221,9 @@ void Transform::SetRotation(float rotation_)
 //	 The component's rotation value (in radians).
 float Transform::GetRotation() const
 {
+	if (storage != nullptr)
+		return storage->rotations[slot];
+
 	return rotation;
 }
 
@@ -148,6 +232,18 @@ float Transform::GetRotation() const
 //	 translation = Reference to a scale vector.
 void Transform::SetScale(const Vector2D& scale_)
 {
+	if (storage != nullptr)
+	{
+		// If the given scale is different, store it and mark the current matrix as dirty.
+		if (!AlmostEqual(storage->scales[slot], scale_))
+		{
+			storage->scales[slot] = scale_;
+			storage->dirtyFlags[slot] = 1;
+		}
+
+		return;
+	}
+
 	// If the given scale is different, store it and mark the current matrix as dirty.
 	if (!AlmostEqual(scale, scale_))
 	{
@@ -161,6 +257,9 @@ void Transform::SetScale(const Vector2D& scale_)
 //	 A reference to the component's scale structure.
 const Vector2D& Transform::GetScale() const
 {
+	if (storage != nullptr)
+		return storage->scales[slot];
+
 	return scale;
 }
 
@@ -172,25 +271,40 @@ const Vector2D& Transform::GetScale() const
 // translation, rotation, and scale.
 void Transform::CalculateMatrices()
 {
+	// While bound to physics storage, the state (and whether it changed) lives in the storage's arrays.
+	if (storage != nullptr)
+	{
+		if (!storage->dirtyFlags[slot])
+			return;
+
+		storage->dirtyFlags[slot] = 0;
+		isDirty = true;
+	}
+
+	const Vector2D& currentTranslation = GetTranslation();
+	const float currentRotation = GetRotation();
+	const Vector2D& currentScale = GetScale();
+
 	// Check if the matrix needs to be recalculated.
 	if (isDirty)
 	{
 		// Recalculate the matrix.
-		CS230::Matrix2D translationMatrix = CS230::Matrix2D::TranslationMatrix(translation.x, translation.y);
-		CS230::Matrix2D rotationMatrix = CS230::Matrix2D::RotationMatrixRadians(rotation);
-		CS230::Matrix2D scalingMatrix = CS230::Matrix2D::ScalingMatrix(scale.x, scale.y);
+		CS230::Matrix2D translationMatrix = CS230::Matrix2D::TranslationMatrix(currentTranslation.x, currentTranslation.y);
+		CS230::Matrix2D rotationMatrix = CS230::Matrix2D::RotationMatrixRadians(currentRotation);
+		CS230::Matrix2D scalingMatrix = CS230::Matrix2D::ScalingMatrix(currentScale.x, currentScale.y);
 
 		matrix = translationMatrix * rotationMatrix * scalingMatrix;
 
 		// Recalculate the inverse matrix.
-		CS230::Matrix2D invTranslationMatrix = CS230::Matrix2D::TranslationMatrix(-translation.x, -translation.y);
-		CS230::Matrix2D invRotationMatrix = CS230::Matrix2D::RotationMatrixRadians(-rotation);
-		CS230::Matrix2D invScalingMatrix = CS230::Matrix2D::ScalingMatrix(1.0f / scale.x, 1.0f / scale.y);
+		CS230::Matrix2D invTranslationMatrix = CS230::Matrix2D::TranslationMatrix(-currentTranslation.x, -currentTranslation.y);
+		CS230::Matrix2D invRotationMatrix = CS230::Matrix2D::RotationMatrixRadians(-currentRotation);
+		CS230::Matrix2D invScalingMatrix = CS230::Matrix2D::ScalingMatrix(1.0f / currentScale.x, 1.0f / currentScale.y);
 
 		inverseMatrix = invScalingMatrix * invRotationMatrix * invTranslationMatrix;
 
 		// Mark the current matrix as clean.
 		isDirty = false;
+		++matrixVersion;
 	}
 }
 
@@ -21,7 +21,6 @@
 #include <GameObject.h>
 #include <Engine.h>
 #include <Parser.h>
-#include <Random.h>
 #include <Graphics.h>
 #include <GameObjectManager.h>
 #include <Space.h>
@@ -91,7 +90,7 @@ namespace Behaviors
 		physics = GetOwner()->GetComponent<Physics>();
 
 		// Add the collision handler to the collider.
-		GetOwner()->GetComponent<Collider>()->SetCollisionHandler(CollisionHandlerAsteroid);
+		GetOwner()->GetComponent<Collider>()->SetCollisionEnterHandler(CollisionHandlerAsteroid);
 
 		// Update position & velocity.
 		SetPosition();
@@ -151,7 +150,7 @@ namespace Behaviors
 		if (size == SizeLarge)
 		{
 			// Choose a random location.
-			location = static_cast<Location>(RandomRange(0, 3));
+			location = static_cast<Location>(GetOwner()->GetSpace()->GetRandom().Range(0, 3));
 			BoundingRectangle screenDimensions = Graphics::GetInstance().GetScreenWorldDimensions();
 
 			float margin = 50.0f;
@@ -178,8 +177,9 @@ namespace Behaviors
 	// Set velocity based on size
 	void Asteroid::SetVelocity()
 	{
-		float angle = RandomRange(0.0f, 360.0f);
-		float speed = RandomRange(speedMin, speedMax);
+		RandomStream& random = GetOwner()->GetSpace()->GetRandom();
+		float angle = random.Range(0.0f, 360.0f);
+		float speed = random.Range(speedMin, speedMax);
 		physics->SetVelocity(Vector2D::FromAngleDegrees(angle) * speed);
 	}
 
@@ -199,13 +199,13 @@ namespace Behaviors
 		{
 		case SizeLarge:
 		{
-			clones = RandomRange(2, 3);
+			clones = GetOwner()->GetSpace()->GetRandom().Range(2, 3);
 			cloneSize = SizeMedium;
 			break;
 		}
 		case SizeMedium:
 		{
-			clones = RandomRange(1, 2);
+			clones = GetOwner()->GetSpace()->GetRandom().Range(1, 2);
 			cloneSize = SizeSmall;
 			break;
 		}
@@ -25,12 +25,15 @@
 #include <Graphics.h>
 #include <Camera.h>
 #include <DebugDraw.h>
+#include <cfloat>
+#include "MazeGraph.h"
 
 // Components
 #include <Transform.h>
 #include <SpriteTilemap.h>
 #include "PlayerScore.h"
 #include "GhostAnimation.h"
+#include "Tags.h"
 
 //------------------------------------------------------------------------------
 
@@ -47,9 +50,9 @@ namespace Behaviors
 	// Constructor
 	// Params:
 	//   dotsLeftToLeave = How many dots the player must eat before the ghost moves.
-	BaseAI::BaseAI(unsigned dotsLeftToLeave) : player(nullptr), target(), scatterTarget(), mode(CHASE), ghostAnimation(nullptr),
+	BaseAI::BaseAI(unsigned dotsLeftToLeave) : player(), target(), scatterTarget(), mode(CHASE), ghostAnimation(nullptr),
 		hasMoved(false), dotsLeftToLeave(dotsLeftToLeave), forceReverse(false), isDead(false), wave(0), waveTimer(0.0f), frightenTime(6.0f), frightTimer(0.0f),
-		overriddenTiles(), overriddenExclusionTiles()
+		overriddenTiles(), overriddenExclusionTiles(), random(), overriddenDirections(), excludedDirections()
 	{
 		// Set waveTime Timers
 		waveTime[0] = 7.0f;
@@ -69,8 +72,13 @@ namespace Behaviors
 		SetFrozen(true);
 
 		ghostAnimation = GetOwner()->GetComponent<GhostAnimation>();
+		random = GetOwner()->GetSpace()->GetRandom().Split();
 
-		player = GetOwner()->GetSpace()->GetObjectManager().GetObjectByName("PAC-MAN");
+		GameObject* playerObject = GetOwner()->GetSpace()->GetObjectManager().GetObjectByName("PAC-MAN");
+		player = playerObject != nullptr ? playerObject->GetHandle() : GameObjectHandle();
+
+		// Let gameplay code find every ghost with a single query.
+		GetOwner()->SetTags(GetOwner()->GetTags() | Tags::Ghost);
 	}
 
 	// Updates components using a fixed timestep (usually just physics)
@@ -80,7 +88,8 @@ namespace Behaviors
 	{
 		if (!hasMoved && ghostAnimation->currentState != GhostAnimation::State::StateSpawn)
 		{
-			if (player->GetComponent<PlayerScore>()->GetDots() >= dotsLeftToLeave)
+			GameObject* playerObject = GetPlayer();
+			if (playerObject != nullptr && playerObject->GetComponent<PlayerScore>()->GetDots() >= dotsLeftToLeave)
 			{
 				SetFrozen(false);
 				hasMoved = true;
@@ -186,7 +195,7 @@ namespace Behaviors
 		{
 			OverriddenTile overriddenTile;
 			parser.ReadValue(overriddenTile);
-			overriddenTiles.push_back(overriddenTile);
+			AddOverrideTile(overriddenTile.pos, overriddenTile.direction);
 		}
 		parser.ReadSkip("}");
 
@@ -202,7 +211,7 @@ namespace Behaviors
 		{
 			OverriddenTile overriddenExclusionTile;
 			parser.ReadValue(overriddenExclusionTile);
-			overriddenExclusionTiles.push_back(overriddenExclusionTile);
+			AddOverrideExclusionTile(overriddenExclusionTile.pos, overriddenExclusionTile.direction);
 		}
 		parser.ReadSkip("}");
 	}
@@ -245,18 +254,22 @@ namespace Behaviors
 		// Params:
 		//   tile = The coordinates of the tile to add an override for.
 		//   overriddenDirection = The direction the AI should be forced to move in when encountering the specified tile.
-	void BaseAI::AddOverrideTile(Vector2D tile, Direction overriddenDirection)
+	void BaseAI::AddOverrideTile(TileCoord tile, Direction overriddenDirection)
 	{
 		overriddenTiles.push_back({ tile, overriddenDirection });
+
+		// The first override added for a tile wins.
+		overriddenDirections.emplace(tile, overriddenDirection);
 	}
 
 	// Adds an overridden direction exclusion for a specific tile.
 	// Params:
 	//   tile = The coordinates of the tile to add an override for.
 	//   excludedDirection = The direction the AI cannot move in when encountering the specified tile.
-	void BaseAI::AddOverrideExclusionTile(Vector2D tile, Direction excludedDirection)
+	void BaseAI::AddOverrideExclusionTile(TileCoord tile, Direction excludedDirection)
 	{
 		overriddenExclusionTiles.push_back({ tile, excludedDirection });
+		excludedDirections[tile] |= 1u << excludedDirection;
 	}
 
 	// Sets the current wave progress.
@@ -295,7 +308,7 @@ namespace Behaviors
 		{
 			target = Vector2D(13, 14);
 
-			if (AlmostEqual(GetNewTile(), target))
+			if (GetNewTile() == TileCoord(13, 14))
 			{
 				// SUPER SCUFFED CHECK FOR WHETHER THIS IS BLINKY BECAUSE APPARENTLY BLINKY DOESN'T HAVE A COOLDOWN FOR LEAVING THE GHOST HOUSE
 				// IT'S 2 AM AS I WRITE THIS AND AJ IS ASLEEP AND I DON'T KNOW PAC-MAN THAT WELL AAAAA
@@ -312,16 +325,13 @@ namespace Behaviors
 			}
 		}
 
-		// Check all overridden tiles.
-		for (auto it = overriddenTiles.begin(); it != overriddenTiles.end(); ++it)
+		// Check if this tile is overridden.
+		auto overridden = overriddenDirections.find(GetNewTile());
+		if (overridden != overriddenDirections.end())
 		{
-			// Check if this tile is overridden.
-			if (AlmostEqual(it->pos, Vector2D(floor(GetNewTile().x), floor(GetNewTile().y))))
-			{
-				// Set the direction to the overridden direction.
-				direction = it->direction;
-				return;
-			}
+			// Set the direction to the overridden direction.
+			direction = overridden->second;
+			return;
 		}
 
 		// If the ghost is forced to invert direction, handle that here.
@@ -337,14 +347,17 @@ namespace Behaviors
 		if (mode == FRIGHTENED)
 		{
 			// Choose a random direction that has an empty tile and is not backwards.
-			AdjacentTile adjacentTile;
-			do
+			const Direction reverse = static_cast<Direction>((direction + DIRECTION_MAX / 2) % DIRECTION_MAX);
+			Direction exits[4];
+			unsigned exitCount = 0;
+			for (size_t i = 0; i < 4; i++)
 			{
-				adjacentTile = adjacentTiles[rand() % 4];
-			} while (!adjacentTile.empty || adjacentTile.direction == (direction + DIRECTION_MAX / 2) % DIRECTION_MAX);
+				if (adjacentTiles[i].empty && adjacentTiles[i].direction != reverse)
+					exits[exitCount++] = adjacentTiles[i].direction;
+			}
 
-			// Set the direction to the tile.
-			direction = adjacentTile.direction;
+			// Turn around at a dead end.
+			direction = exitCount != 0 ? exits[random.NextBelow(exitCount)] : reverse;
 			return;
 		}
 		else if (mode == SCATTER)
@@ -366,6 +379,28 @@ namespace Behaviors
 		UNREFERENCED_PARAMETER(emptyCount);
 	}
 
+	// Gets the player game object.
+	// Returns:
+	//   The player, or nullptr if it is no longer active.
+	GameObject* BaseAI::GetPlayer() const
+	{
+		return GetOwner()->GetSpace()->GetObjectManager().GetObjectByHandle(player);
+	}
+
+	// Gathers the player's state read by the targeting rules.
+	// Params:
+	//   playerObject = The player game object.
+	GhostTargeting::PlayerState BaseAI::GetPlayerState(GameObject& playerObject) const
+	{
+		const GridMovement* playerMovement = playerObject.GetComponent<GridMovement>();
+
+		GhostTargeting::PlayerState playerState;
+		playerState.tile = GetSpriteTilemap()->WorldToTile(playerObject.GetComponent<Transform>()->GetTranslation());
+		playerState.ahead2 = playerMovement->GetDirectionVector(2);
+		playerState.ahead4 = playerMovement->GetDirectionVector(4);
+		return playerState;
+	}
+
 	//------------------------------------------------------------------------------
 	// Private Functions:
 	//------------------------------------------------------------------------------
@@ -379,28 +414,27 @@ namespace Behaviors
 		UNREFERENCED_PARAMETER(emptyCount);
 
 		AdjacentTile closest;
-		float closestDistance = 999.0f;
+		float closestDistance = FLT_MAX;
+
+		// Every ghost heading for the same tile shares one field. Eyes may also pass through the ghost house door.
+		FlowFieldMap& flowFields = GetOwner()->GetSpace()->GetFlowFields();
+		const int doorValue = isDead ? MazeGraph::ghostDoorValue : -1;
 
-		// Choose closest tile to move towards.
+		const TileCoord tile = GetNewTile();
+		auto excludedTile = excludedDirections.find(tile);
+		const unsigned excluded = excludedTile != excludedDirections.end() ? excludedTile->second : 0;
+
+		// Choose closest tile to move towards. Ties go to the first direction in the order up, left, down, right.
 		for (size_t i = 0; i < 4; i++)
 		{
-			bool excluded = false;
-			for (auto it = overriddenExclusionTiles.begin(); it != overriddenExclusionTiles.end(); ++it)
-			{
-				if (AlmostEqual(it->pos, Vector2D(floor(GetNewTile().x), floor(GetNewTile().y))) && it->direction == adjacentTiles[i].direction)
-				{
-					excluded = true;
-					break;
-				}
-			}
-			if (excluded)
+			if (excluded & (1u << adjacentTiles[i].direction))
 				continue;
 
-			// Make sure the tile is empty and would not be backtracking.
-			bool valid;
-			if ((adjacentTiles[i].empty || isDead && GetCellValue(adjacentTiles[i].pos, valid) == 31) && !AlmostEqual(adjacentTiles[i].pos, GetOldTile()))
+			// Make sure the tile is empty and would not be backtracking. Eyes may also pass through the ghost house door.
+			const bool passable = adjacentTiles[i].empty || isDead && GetMazeGraph()->IsGhostPassable(tile.x, tile.y, adjacentTiles[i].direction);
+			if (passable && adjacentTiles[i].pos != GetOldTile())
 			{
-				float distance = adjacentTiles[i].pos.Distance(target);
+				float distance = flowFields.GetCost(target, adjacentTiles[i].pos, doorValue);
 				if (distance < closestDistance)
 				{
 					closestDistance = distance;
@@ -16,6 +16,10 @@
 //------------------------------------------------------------------------------
 
 #include "GridMovement.h"
+#include "GhostTargeting.h"
+#include <GameObjectHandle.h>
+#include <RandomStream.h>
+#include <unordered_map>
 
 //------------------------------------------------------------------------------
 
@@ -76,13 +80,13 @@ namespace Behaviors
 		// Params:
 		//   tile = The coordinates of the tile to add an override for.
 		//   overriddenDirection = The direction the AI should be forced to move in when encountering the specified tile.
-		void AddOverrideTile(Vector2D tile, Direction overriddenDirection);
+		void AddOverrideTile(TileCoord tile, Direction overriddenDirection);
 
 		// Adds an overridden direction exclusion for a specific tile.
 		// Params:
 		//   tile = The coordinates of the tile to add an override for.
 		//   excludedDirection = The direction the AI cannot move in when encountering the specified tile.
-		void AddOverrideExclusionTile(Vector2D tile, Direction excludedDirection);
+		void AddOverrideExclusionTile(TileCoord tile, Direction excludedDirection);
 
 		// Sets the current wave progress.
 		// Params:
@@ -132,12 +136,22 @@ namespace Behaviors
 		//   emptyCount = How many empty tiles were found.
 		virtual void OnTarget(AdjacentTile adjacentTiles[4], size_t emptyCount) = 0;
 
+		// Gets the player game object.
+		// Returns:
+		//   The player, or nullptr if it is no longer active.
+		GameObject* GetPlayer() const;
+
+		// Gathers the player's state read by the targeting rules.
+		// Params:
+		//   playerObject = The player game object.
+		GhostTargeting::PlayerState GetPlayerState(GameObject& playerObject) const;
+
 		//------------------------------------------------------------------------------
 		// Protected Variables:
 		//------------------------------------------------------------------------------
 
 		// The player game object.
-		GameObject* player;
+		GameObjectHandle player;
 
 		// Other variables
 		Vector2D target;
@@ -151,7 +165,7 @@ namespace Behaviors
 
 		struct OverriddenTile
 		{
-			Vector2D pos;
+			TileCoord pos;
 			Direction direction;
 		};
 
@@ -187,6 +201,13 @@ namespace Behaviors
 		std::vector<OverriddenTile> overriddenTiles;
 		std::vector<OverriddenTile> overriddenExclusionTiles;
 
+		// This ghost's own random numbers, split from the space's stream when the ghost is created.
+		RandomStream random;
+
+		// The overrides looked up by tile. Each exclusion mask has one bit per excluded direction.
+		std::unordered_map<TileCoord, Direction> overriddenDirections;
+		std::unordered_map<TileCoord, unsigned> excludedDirections;
+
 		// Insertion operator for OverriddenTile.
 		// Params:
 		//   os = The output stream.
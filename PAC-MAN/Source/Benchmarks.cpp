@@ -0,0 +1,1512 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	Benchmarks.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "Benchmarks.h"
+
+// Systems
+#include <cfloat>
+#include <chrono>
+#include <cstdio>
+#include <unordered_map>
+#include <GameObject.h>
+#include <GameObjectManager.h>
+#include <Space.h>
+#include <Tilemap.h>
+#include <TilemapStreamer.h>
+#include <RandomStream.h>
+#include <ThreadPool.h>
+#include <Intersection2D.h>
+#include <IntersectionBatch2D.h>
+#include <BroadphaseGrid.h>
+#include <BroadphaseSweep.h>
+#include <FlowFieldMap.h>
+#include "MazeGraph.h"
+
+// Components
+#include <Transform.h>
+#include <Physics.h>
+#include <Sprite.h>
+#include <Animation.h>
+#include <ColliderCircle.h>
+#include <ColliderRectangle.h>
+#include <ColliderLine.h>
+#include <SpriteTilemap.h>
+#include "GhostSwarm.h"
+
+//------------------------------------------------------------------------------
+
+namespace Benchmarks
+{
+	//------------------------------------------------------------------------------
+	// Private Structures:
+	//------------------------------------------------------------------------------
+
+	// Shapes to test a batch against, stored the way the batch tests read them.
+	struct BatchShapes
+	{
+		std::vector<float> centerX;
+		std::vector<float> centerY;
+		std::vector<float> radius;
+
+		std::vector<float> left;
+		std::vector<float> right;
+		std::vector<float> top;
+		std::vector<float> bottom;
+
+		std::vector<float> cornerX[4];
+		std::vector<float> cornerY[4];
+		std::vector<float> axisX[2];
+		std::vector<float> axisY[2];
+
+		std::vector<Circle> circles;
+		std::vector<BoundingRectangle> rectangles;
+		std::vector<OBBShape> obbs;
+	};
+
+	// The offsets to the neighbors of a tile, in the order ghosts prefer directions when costs tie: up, left, down, right.
+	const TileCoord DirectionOffsets[4] = { TileCoord(0, -1), TileCoord(-1, 0), TileCoord(0, 1), TileCoord(1, 0) };
+
+	// Names of the instruction sets, in the order of IntersectionBatch::InstructionSet.
+	const char* const InstructionSetNames[] = { "scalar", "SSE2", "AVX2" };
+
+	// The collision events sent during a narrowphase run, as (event, object, other object) triples,
+	//   where objects are numbered in the order they were added.
+	struct CollisionRecording
+	{
+		std::unordered_map<const GameObject*, unsigned> objectIndices;
+		std::vector<unsigned> events;
+	};
+
+	// The recording the collision handlers below add to, as handlers are only given the two objects.
+	CollisionRecording* collisionRecording = nullptr;
+
+	//------------------------------------------------------------------------------
+	// Private Functions:
+	//------------------------------------------------------------------------------
+
+	// Gets the milliseconds that have passed since a point in time.
+	// Params:
+	//   start = The point in time.
+	double MillisecondsSince(std::chrono::high_resolution_clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+	// Fills a space with objects, destroys every other one, and times the frame that removes them.
+	// Params:
+	//   objectCount = How many objects to create.
+	//   ordered = Whether the object manager keeps the remaining objects in order.
+	//   reclaimBudget = How many destroyed objects the object manager deletes per frame.
+	//   passed = Set to false if the wrong objects were left behind.
+	// Returns:
+	//   The time the object manager took to update, in milliseconds.
+	double TimeDestroyFrame(size_t objectCount, bool ordered, unsigned reclaimBudget, bool& passed)
+	{
+		// The space is paused, so updating the object manager only removes destroyed objects (and draws the rest,
+		//   which is why the objects have nothing to draw).
+		Space space("Benchmark");
+		space.SetPaused(true);
+
+		GameObjectManager& objectManager = space.GetObjectManager();
+		objectManager.SetOrderedDestruction(ordered);
+		objectManager.SetReclaimBudget(reclaimBudget);
+		objectManager.Reserve(objectCount);
+
+		std::vector<GameObjectHandle> handles;
+		handles.reserve(objectCount);
+		for (size_t i = 0; i < objectCount; ++i)
+		{
+			GameObject* object = new GameObject(i % 2 == 0 ? "Pellet" : "Ghost");
+			object->AddComponent(new Transform());
+			object->AddComponent(new Physics());
+			objectManager.AddObject(*object);
+			handles.push_back(object->GetHandle());
+		}
+
+		for (size_t i = 0; i < objectCount; i += 2)
+			objectManager.GetObjectByHandle(handles[i])->Destroy();
+
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		objectManager.Update(0.0f);
+		const double time = MillisecondsSince(start);
+
+		// Only the ghosts should be left, and only the pellets' handles should have gone stale.
+		if (objectManager.GetObjectCount("Pellet") != 0 || objectManager.GetObjectCount("Ghost") != objectCount / 2)
+			passed = false;
+
+		for (size_t i = 0; i < objectCount; ++i)
+		{
+			if ((objectManager.GetObjectByHandle(handles[i]) == nullptr) != (i % 2 == 0))
+			{
+				passed = false;
+				break;
+			}
+		}
+
+		return time;
+	}
+
+	// Fills a tilemap with random values and times reading all of its cells in each of the ways the tilemap offers.
+	// Params:
+	//   out = The stream the results are written to.
+	//   width = The number of columns of the map.
+	//   height = The number of rows of the map.
+	//   maxValue = The highest value of a cell, which decides how the cells are stored.
+	// Returns:
+	//   True if every way of reading the map gave the same cells.
+	bool TimeTilemapSweep(std::ostream& out, unsigned width, unsigned height, int maxValue)
+	{
+		// Small maps are swept several times, so every sweep reads about as many cells.
+		const size_t cellCount = static_cast<size_t>(width) * height;
+		const unsigned sweepCount = static_cast<unsigned>(max(static_cast<size_t>(1), (1u << 24) / cellCount));
+
+		RandomStream random(width, height);
+		int** data = new int*[width];
+		for (unsigned column = 0; column < width; ++column)
+		{
+			data[column] = new int[height];
+			for (unsigned row = 0; row < height; ++row)
+				data[column][row] = random.Range(0, maxValue);
+		}
+
+		// The tilemap deletes the data.
+		Tilemap tilemap(width, height, data);
+		const bool wide = tilemap.GetCellFormat() == Tilemap::CELL_UINT16;
+
+		// Sum the cells, so the sweeps cannot be optimized away and can be compared.
+		unsigned long long cellSum = 0;
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		for (unsigned sweep = 0; sweep < sweepCount; ++sweep)
+		{
+			for (unsigned row = 0; row < height; ++row)
+			{
+				for (unsigned column = 0; column < width; ++column)
+					cellSum += tilemap.GetCellValue(column, row);
+			}
+		}
+		const double cellTime = MillisecondsSince(start);
+
+		unsigned long long rowSum = 0;
+		start = std::chrono::high_resolution_clock::now();
+		for (unsigned sweep = 0; sweep < sweepCount; ++sweep)
+		{
+			for (unsigned row = 0; row < height; ++row)
+			{
+				if (wide)
+				{
+					const unsigned short* cells = tilemap.GetRow16(row);
+					for (unsigned column = 0; column < width; ++column)
+						rowSum += cells[column];
+				}
+				else
+				{
+					const unsigned char* cells = tilemap.GetRow8(row);
+					for (unsigned column = 0; column < width; ++column)
+						rowSum += cells[column];
+				}
+			}
+		}
+		const double rowTime = MillisecondsSince(start);
+
+		std::vector<int> span(width);
+		unsigned long long spanSum = 0;
+		start = std::chrono::high_resolution_clock::now();
+		for (unsigned sweep = 0; sweep < sweepCount; ++sweep)
+		{
+			for (unsigned row = 0; row < height; ++row)
+			{
+				const unsigned count = tilemap.GetSpan(0, row, width, span.data());
+				for (unsigned column = 0; column < count; ++column)
+					spanSum += span[column];
+			}
+		}
+		const double spanTime = MillisecondsSince(start);
+
+		out << "  " << width << "x" << height << (wide ? ", 16-bit cells" : ", 8-bit cells")
+			<< " (" << sweepCount << (sweepCount == 1 ? " sweep)" : " sweeps)") << std::endl;
+		out << "    GetCellValue: " << cellTime << " ms" << std::endl;
+		out << (wide ? "    GetRow16:     " : "    GetRow8:      ") << rowTime << " ms" << std::endl;
+		out << "    GetSpan:      " << spanTime << " ms" << std::endl;
+
+		return cellSum == rowSum && cellSum == spanSum;
+	}
+
+	// Writes a tilemap with random values to a binary file, then streams it back from a space while a camera
+	//   sweeps across it, checking every cell the camera sees against the whole file mapped into memory.
+	// Params:
+	//   out = The stream the results are written to.
+	//   width = The number of columns of the map.
+	//   height = The number of rows of the map.
+	//   maxValue = The highest value of a cell, which decides how the cells are stored.
+	// Returns:
+	//   True if the streamed cells matched the file and no update left more chunks in memory than allowed.
+	bool CheckStreamingSweep(std::ostream& out, unsigned width, unsigned height, int maxValue)
+	{
+		const std::string filename = "StreamingBenchmark.tmb";
+		const unsigned chunkSize = 32;
+		const size_t maxResidentChunks = 64;
+
+		// The camera sees a 64x36 tile screen and moves 12 tiles per frame, back and forth in 8 bands from
+		//   the top of the map to the bottom. It asks for one more chunk on each side, so chunks stream in ahead of it.
+		const unsigned viewColumns = 64;
+		const unsigned viewRows = 36;
+		const unsigned cameraSpeed = 12;
+		const unsigned bandCount = 8;
+		const int lookAhead = static_cast<int>(chunkSize);
+
+		RandomStream random(width, height);
+		int** data = new int*[width];
+		for (unsigned column = 0; column < width; ++column)
+		{
+			data[column] = new int[height];
+			for (unsigned row = 0; row < height; ++row)
+				data[column][row] = random.Range(0, maxValue);
+		}
+
+		// The tilemap deletes the data.
+		bool written;
+		bool wide;
+		{
+			Tilemap source(width, height, data);
+			written = source.WriteBinaryFile(filename);
+			wide = source.GetCellFormat() == Tilemap::CELL_UINT16;
+		}
+
+		Tilemap* mapped = written ? Tilemap::CreateTilemapFromBinaryFile(filename) : nullptr;
+		Tilemap* streamed = written ? Tilemap::CreateStreamingTilemap(filename, chunkSize, maxResidentChunks) : nullptr;
+		if (mapped == nullptr || streamed == nullptr)
+		{
+			out << "  FAILED: could not write and reopen " << filename << std::endl;
+			delete mapped;
+			delete streamed;
+			std::remove(filename.c_str());
+			return false;
+		}
+
+		// The space updates the streamer once per frame, the way it does for a level's map.
+		Space space("Benchmark");
+		space.AddStreamingTilemap(*streamed);
+		TilemapStreamer* streamer = streamed->GetStreamer();
+
+		bool passed = streamed->GetWidth() == width && streamed->GetHeight() == height;
+		unsigned frameCount = 0;
+		size_t cellCount = 0;
+		size_t mismatchCount = 0;
+		size_t mostResident = 0;
+		std::vector<int> mappedSpan(viewColumns);
+		std::vector<int> streamedSpan(viewColumns);
+
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		for (unsigned band = 0; band < bandCount; ++band)
+		{
+			const unsigned top = band * (height - viewRows) / (bandCount - 1);
+			const unsigned stepCount = (width - viewColumns) / cameraSpeed + 1;
+
+			for (unsigned step = 0; step < stepCount; ++step)
+			{
+				const unsigned left = (band % 2 == 0 ? step : stepCount - 1 - step) * cameraSpeed;
+
+				// Read what the camera sees, one cell at a time and a row at a time.
+				for (unsigned row = top; row < top + viewRows; ++row)
+				{
+					for (unsigned column = left; column < left + viewColumns; ++column)
+					{
+						if (streamed->GetCellValue(column, row) != mapped->GetCellValue(column, row))
+							++mismatchCount;
+					}
+
+					const unsigned count = streamed->GetSpan(left, row, viewColumns, streamedSpan.data());
+					mapped->GetSpan(left, row, viewColumns, mappedSpan.data());
+					if (count != viewColumns || streamedSpan != mappedSpan)
+						++mismatchCount;
+				}
+
+				cellCount += viewColumns * viewRows;
+
+				streamer->AddFocus(static_cast<int>(left) - lookAhead, static_cast<int>(top) - lookAhead,
+					static_cast<int>(left + viewColumns - 1) + lookAhead, static_cast<int>(top + viewRows - 1) + lookAhead);
+				space.Update(1.0f / 60.0f);
+				++frameCount;
+
+				mostResident = max(mostResident, streamer->GetResidentChunkCount());
+			}
+		}
+		const double sweepTime = MillisecondsSince(start);
+
+		out << "  " << width << "x" << height << (wide ? ", 16-bit cells" : ", 8-bit cells") << ", " << chunkSize << "x" << chunkSize
+			<< " chunks, at most " << maxResidentChunks << " in memory" << std::endl;
+		out << "    camera sweep:             " << frameCount << " frames, " << cellCount << " cells, " << sweepTime << " ms" << std::endl;
+		out << "    cells that differed:      " << mismatchCount << std::endl;
+		out << "    chunks read immediately:  " << streamer->GetMissCount() << std::endl;
+		out << "    most chunks after update: " << mostResident << std::endl;
+
+		passed = passed && mismatchCount == 0 && mostResident <= maxResidentChunks;
+
+		// Both tilemaps keep the file open, so they are closed before it is deleted.
+		space.RemoveStreamingTilemap(*streamed);
+		delete streamed;
+		delete mapped;
+		std::remove(filename.c_str());
+
+		return passed;
+	}
+
+	// Makes an oriented bounding box.
+	// Params:
+	//   center = The center of the box.
+	//   extents = Half the width and height of the box.
+	//   angle = The rotation of the box, in radians.
+	OBBShape MakeOBB(const Vector2D& center, const Vector2D& extents, float angle)
+	{
+		OBBShape obb;
+		obb.axes[0] = Vector2D(cosf(angle), sinf(angle));
+		obb.axes[1] = Vector2D(-obb.axes[0].y, obb.axes[0].x);
+
+		const Vector2D right = obb.axes[0] * extents.x;
+		const Vector2D up = obb.axes[1] * extents.y;
+		obb.corners[0] = center - right - up;
+		obb.corners[1] = center + right - up;
+		obb.corners[2] = center + right + up;
+		obb.corners[3] = center - right + up;
+		return obb;
+	}
+
+	// Adds a circle, a rectangle and a box to a set of batch shapes.
+	// Params:
+	//   shapes = The shapes to add to.
+	//   circle = The circle.
+	//   rectangle = The rectangle.
+	//   obb = The box.
+	void AddBatchShapes(BatchShapes& shapes, const Circle& circle, const BoundingRectangle& rectangle, const OBBShape& obb)
+	{
+		shapes.centerX.push_back(circle.center.x);
+		shapes.centerY.push_back(circle.center.y);
+		shapes.radius.push_back(circle.radius);
+		shapes.circles.push_back(circle);
+
+		shapes.left.push_back(rectangle.left);
+		shapes.right.push_back(rectangle.right);
+		shapes.top.push_back(rectangle.top);
+		shapes.bottom.push_back(rectangle.bottom);
+		shapes.rectangles.push_back(rectangle);
+
+		for (unsigned i = 0; i < 4; ++i)
+		{
+			shapes.cornerX[i].push_back(obb.corners[i].x);
+			shapes.cornerY[i].push_back(obb.corners[i].y);
+		}
+		for (unsigned i = 0; i < 2; ++i)
+		{
+			shapes.axisX[i].push_back(obb.axes[i].x);
+			shapes.axisY[i].push_back(obb.axes[i].y);
+		}
+		shapes.obbs.push_back(obb);
+	}
+
+	// Fills a set of batch shapes with random shapes around the origin. About a quarter of them exactly touch
+	//   an axis-aligned circle of radius 2, rectangle or box with extents (2, 1.5) at the origin, along an edge or at a corner.
+	// Params:
+	//   shapes = The shapes to fill.
+	//   random = The random stream to draw from.
+	//   count = How many of each shape to make.
+	void MakeBatchShapes(BatchShapes& shapes, RandomStream& random, size_t count)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (random.NextBelow(4) == 0)
+			{
+				// Whole and half numbers keep the touching distances exact.
+				const float size = 0.5f * random.Range(1, 6);
+				const bool corner = random.NextBelow(2) == 0;
+				const Vector2D extents(size, size);
+
+				const Vector2D circleCenter = corner ? Vector2D(0.0f, -(2.0f + size)) : Vector2D(2.0f + size, 0.0f);
+				const Vector2D boxCenter = corner ? Vector2D(2.0f + size, 1.5f + size) : Vector2D(-(2.0f + size), 0.5f);
+				AddBatchShapes(shapes, Circle(circleCenter, size), BoundingRectangle(boxCenter, extents), MakeOBB(boxCenter, extents, 0.0f));
+			}
+			else
+			{
+				const Vector2D center(random.Range(-8.0f, 8.0f), random.Range(-8.0f, 8.0f));
+				const Vector2D extents(random.Range(0.1f, 3.0f), random.Range(0.1f, 3.0f));
+				AddBatchShapes(shapes, Circle(center, extents.x), BoundingRectangle(center, extents), MakeOBB(center, extents, random.Range(0.0f, 3.14159265f)));
+			}
+		}
+	}
+
+	// Runs the batch tests with each instruction set and compares them against the single-pair tests.
+	// Params:
+	//   out = The stream mismatches are written to.
+	//   shapes = The shapes to test against.
+	//   circle = The circle to test.
+	//   rectangle = The rectangle to test.
+	//   obb = The box to test.
+	// Returns:
+	//   True if every instruction set gave the same results and counts as the single-pair tests.
+	bool CheckIntersectionBatches(std::ostream& out, const BatchShapes& shapes, const Circle& circle, const BoundingRectangle& rectangle, const OBBShape& obb)
+	{
+		const size_t count = shapes.circles.size();
+		const CircleArrays circles = { shapes.centerX.data(), shapes.centerY.data(), shapes.radius.data(), count };
+		const RectangleArrays rectangles = { shapes.left.data(), shapes.right.data(), shapes.top.data(), shapes.bottom.data(), count };
+		OBBArrays obbs;
+		for (unsigned i = 0; i < 4; ++i)
+		{
+			obbs.cornerX[i] = shapes.cornerX[i].data();
+			obbs.cornerY[i] = shapes.cornerY[i].data();
+		}
+		for (unsigned i = 0; i < 2; ++i)
+		{
+			obbs.axisX[i] = shapes.axisX[i].data();
+			obbs.axisY[i] = shapes.axisY[i].data();
+		}
+		obbs.count = count;
+
+		// The expected results, one shape at a time.
+		std::vector<unsigned char> expected(3 * count);
+		size_t expectedCounts[3] = { 0, 0, 0 };
+		for (size_t i = 0; i < count; ++i)
+		{
+			expected[i] = ::CircleCircleIntersection(circle, shapes.circles[i]) ? 1 : 0;
+			expected[count + i] = ::RectangleRectangleIntersection(rectangle, shapes.rectangles[i]) ? 1 : 0;
+			expected[2 * count + i] = ::OBBOBBIntersection(obb, shapes.obbs[i]) ? 1 : 0;
+			expectedCounts[0] += expected[i];
+			expectedCounts[1] += expected[count + i];
+			expectedCounts[2] += expected[2 * count + i];
+		}
+
+		bool passed = true;
+		std::vector<unsigned char> results(3 * count + 1);
+		for (int set = IntersectionBatch::INSTRUCTIONS_SCALAR; set <= IntersectionBatch::INSTRUCTIONS_AVX2; ++set)
+		{
+			IntersectionBatch::SetInstructionSet(static_cast<IntersectionBatch::InstructionSet>(set));
+
+			size_t counts[3];
+			counts[0] = IntersectionBatch::CircleCircleIntersection(circle, circles, results.data());
+			counts[1] = IntersectionBatch::RectangleRectangleIntersection(rectangle, rectangles, results.data() + count);
+			counts[2] = IntersectionBatch::OBBOBBIntersection(obb, obbs, results.data() + 2 * count);
+
+			if (!std::equal(expected.begin(), expected.end(), results.begin())
+				|| counts[0] != expectedCounts[0] || counts[1] != expectedCounts[1] || counts[2] != expectedCounts[2])
+			{
+				out << "  " << InstructionSetNames[IntersectionBatch::GetInstructionSet()] << " disagrees with the single-pair tests on "
+					<< count << " shapes" << std::endl;
+				passed = false;
+			}
+		}
+
+		return passed;
+	}
+
+	// Adds a collision event to the current recording.
+	// Params:
+	//   event = 0 for enter, 1 for stay and 2 for exit.
+	//   object = The object whose handler is being called.
+	//   other = The other object.
+	void RecordCollision(unsigned event, const GameObject& object, const GameObject& other)
+	{
+		collisionRecording->events.push_back(event);
+		collisionRecording->events.push_back(collisionRecording->objectIndices[&object]);
+		collisionRecording->events.push_back(collisionRecording->objectIndices[&other]);
+	}
+
+	// Collision handlers that record each event.
+	// Params:
+	//   object = The object whose handler is being called.
+	//   other = The other object.
+	void RecordCollisionEnter(GameObject& object, GameObject& other)
+	{
+		RecordCollision(0, object, other);
+	}
+
+	void RecordCollisionStay(GameObject& object, GameObject& other)
+	{
+		RecordCollision(1, object, other);
+	}
+
+	void RecordCollisionExit(GameObject& object, GameObject& other)
+	{
+		RecordCollision(2, object, other);
+	}
+
+	// Fills a space with moving circles and spinning boxes, and times stepping their physics and collisions.
+	// Params:
+	//   parallel = Whether the narrowphase uses the thread pool.
+	//   broadphase = The broadphase the space should use, or nullptr to keep the default one.
+	//   bodyCount = How many objects to add.
+	//   stepCount = How many fixed steps to run.
+	//   recording = Receives the collision events of every step.
+	// Returns:
+	//   The time the steps took, in milliseconds.
+	double TimeNarrowphase(bool parallel, Broadphase* broadphase, size_t bodyCount, unsigned stepCount, CollisionRecording& recording)
+	{
+		const float dt = 1.0f / 60.0f;
+
+		Space space("Benchmark");
+		GameObjectManager& objectManager = space.GetObjectManager();
+		objectManager.SetParallelNarrowphase(parallel);
+		if (broadphase != nullptr)
+			objectManager.SetBroadphase(broadphase);
+		objectManager.Reserve(bodyCount);
+
+		// Both runs draw the same bodies.
+		RandomStream random(24);
+		for (size_t i = 0; i < bodyCount; ++i)
+		{
+			GameObject* object = new GameObject("Body");
+			const float x = random.Range(-1500.0f, 1500.0f);
+			const float y = random.Range(-1500.0f, 1500.0f);
+			Transform* transform = new Transform(x, y);
+			object->AddComponent(transform);
+
+			const float velocityX = random.Range(-100.0f, 100.0f);
+			const float velocityY = random.Range(-100.0f, 100.0f);
+			Physics* physics = new Physics();
+			physics->SetVelocity(Vector2D(velocityX, velocityY));
+			object->AddComponent(physics);
+
+			Collider* collider;
+			if (i % 2 == 0)
+			{
+				collider = new ColliderCircle(random.Range(8.0f, 24.0f));
+			}
+			else
+			{
+				const float extentX = random.Range(8.0f, 24.0f);
+				const float extentY = random.Range(8.0f, 24.0f);
+				collider = new ColliderRectangle(Vector2D(extentX, extentY));
+				transform->SetRotation(random.Range(0.0f, 3.14159265f));
+				physics->SetAngularVelocity(random.Range(-2.0f, 2.0f));
+			}
+			collider->SetCollisionEnterHandler(RecordCollisionEnter);
+			collider->SetCollisionStayHandler(RecordCollisionStay);
+			collider->SetCollisionExitHandler(RecordCollisionExit);
+			object->AddComponent(collider);
+
+			objectManager.AddObject(*object);
+			recording.objectIndices[object] = static_cast<unsigned>(i);
+		}
+
+		// The object manager is stepped through BetaObject's FixedUpdate, as updating the space
+		//   would also draw the colliders.
+		BetaObject& manager = objectManager;
+		collisionRecording = &recording;
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		for (unsigned step = 0; step < stepCount; ++step)
+			manager.FixedUpdate(dt);
+		const double time = MillisecondsSince(start);
+		collisionRecording = nullptr;
+
+		return time;
+	}
+
+	// Adds circles to a space for the broadphase comparison, each with its own velocity.
+	// Params:
+	//   objectManager = The object manager to add the circles to.
+	//   random = The random stream to draw from.
+	//   count = How many circles to add.
+	//   colliders = The list the circles' colliders are added to.
+	//   velocities = The list the circles' velocities are added to.
+	void AddBroadphaseCircles(GameObjectManager& objectManager, RandomStream& random, size_t count, std::vector<Collider*>& colliders, std::vector<Vector2D>& velocities)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			GameObject* object = new GameObject("Circle");
+			const float x = random.Range(-3000.0f, 3000.0f);
+			const float y = random.Range(-3000.0f, 3000.0f);
+			object->AddComponent(new Transform(x, y));
+
+			Collider* collider = new ColliderCircle(random.Range(8.0f, 24.0f));
+			object->AddComponent(collider);
+			objectManager.AddObject(*object);
+			colliders.push_back(collider);
+
+			const float velocityX = random.Range(-100.0f, 100.0f);
+			const float velocityY = random.Range(-100.0f, 100.0f);
+			velocities.push_back(Vector2D(velocityX, velocityY));
+		}
+	}
+
+	// Checks whether two broadphase pairs refer to the same proxies.
+	bool BroadphasePairEqual(const BroadphasePair& a, const BroadphasePair& b)
+	{
+		return a.first == b.first && a.second == b.second;
+	}
+
+	// Finds pairs with a broadphase and times it.
+	// Params:
+	//   broadphase = The broadphase.
+	//   proxies = The colliders taking part in the step.
+	//   pairs = Receives the pairs, replacing what it held.
+	// Returns:
+	//   The time the broadphase took, in milliseconds.
+	double TimeFindPairs(Broadphase& broadphase, const std::vector<BroadphaseProxy>& proxies, std::vector<BroadphasePair>& pairs)
+	{
+		pairs.clear();
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		broadphase.FindPairs(proxies, pairs);
+		return MillisecondsSince(start);
+	}
+
+	// Sweeps random circles across random segments, half of them starting closer to the segment than their radius,
+	//   and checks that no circle is first hit later than its center crosses the segment.
+	// Params:
+	//   out = The stream the results are written to.
+	//   random = The random stream to draw from.
+	//   sweepCount = How many sweeps to check.
+	// Returns:
+	//   True if no circle passed through a segment.
+	bool CheckCircleSweeps(std::ostream& out, RandomStream& random, size_t sweepCount)
+	{
+		size_t crossings = 0;
+		size_t nearCrossings = 0;
+		size_t misses = 0;
+		for (size_t i = 0; i < sweepCount; ++i)
+		{
+			const float startX = random.Range(-100.0f, 100.0f);
+			const float startY = random.Range(-100.0f, 100.0f);
+			const float angle = random.Range(0.0f, 6.28318531f);
+			const float length = random.Range(20.0f, 200.0f);
+			const Vector2D direction(cosf(angle), sinf(angle));
+			const LineSegment segment(Vector2D(startX, startY), Vector2D(startX, startY) + direction * length);
+			const float radius = random.Range(1.0f, 20.0f);
+
+			// Near circles start within their radius of the line, past the ends as well, and move to its other side.
+			LineSegment path;
+			const bool near = i % 2 == 0;
+			if (near)
+			{
+				const float along = random.Range(-radius, length + radius);
+				const float side = random.Range(-radius, radius);
+				const float endAlong = random.Range(-radius, length + radius);
+				const float endSide = random.Range(1.0f, 300.0f);
+				path.start = segment.start + direction * along + segment.normal * side;
+				path.end = segment.start + direction * endAlong + segment.normal * (side < 0.0f ? endSide : -endSide);
+			}
+			else
+			{
+				const float pathStartX = random.Range(-300.0f, 300.0f);
+				const float pathStartY = random.Range(-300.0f, 300.0f);
+				const float pathEndX = random.Range(-300.0f, 300.0f);
+				const float pathEndY = random.Range(-300.0f, 300.0f);
+				path.start = Vector2D(pathStartX, pathStartY);
+				path.end = Vector2D(pathEndX, pathEndY);
+			}
+
+			Vector2D pointIntersection;
+			float pointT;
+			if (!MovingPointLineIntersection(segment, path, pointIntersection, pointT))
+				continue;
+
+			++crossings;
+			if (near)
+				++nearCrossings;
+
+			// The circle must touch the segment no later than its center crosses it.
+			Vector2D circleIntersection;
+			float circleT;
+			LineSegment contactLine;
+			if (!MovingCircleLineIntersection(segment, path, radius, circleIntersection, circleT, contactLine) || circleT > pointT + 0.0001f)
+				++misses;
+		}
+
+		out << "  " << crossings << " circles crossed a segment, " << nearCrossings << " of them starting within their radius of it" << std::endl;
+		if (misses != 0)
+			out << "  " << misses << " circles passed through a segment" << std::endl;
+
+		return misses == 0 && nearCrossings != 0;
+	}
+
+	// Fills a space with circles bouncing around inside a box of line segments, and times stepping them.
+	// Params:
+	//   circleCount = How many circles to add.
+	//   stepCount = How many fixed steps to run.
+	//   passed = Set to false if a circle left the box.
+	// Returns:
+	//   The time the steps took, in milliseconds.
+	double TimeLineBounces(size_t circleCount, unsigned stepCount, bool& passed)
+	{
+		const float dt = 1.0f / 60.0f;
+		const float halfSize = 500.0f;
+
+		Space space("Benchmark");
+		GameObjectManager& objectManager = space.GetObjectManager();
+
+		// The walls of the box, with short segments scattered away from them. Circles caught between segments closer
+		//   together than a step can run out of resolutions, which is not what this checks.
+		RandomStream random(25);
+		GameObject* linesObject = new GameObject("Lines");
+		linesObject->AddComponent(new Transform());
+		ColliderLine* lines = new ColliderLine();
+		lines->AddLineSegment(Vector2D(-halfSize, -halfSize), Vector2D(halfSize, -halfSize));
+		lines->AddLineSegment(Vector2D(halfSize, -halfSize), Vector2D(halfSize, halfSize));
+		lines->AddLineSegment(Vector2D(halfSize, halfSize), Vector2D(-halfSize, halfSize));
+		lines->AddLineSegment(Vector2D(-halfSize, halfSize), Vector2D(-halfSize, -halfSize));
+		for (unsigned i = 0; i < 200; ++i)
+		{
+			const float x = random.Range(-halfSize + 150.0f, halfSize - 150.0f);
+			const float y = random.Range(-halfSize + 150.0f, halfSize - 150.0f);
+			const float angle = random.Range(0.0f, 6.28318531f);
+			lines->AddLineSegment(Vector2D(x, y), Vector2D(x + 40.0f * cosf(angle), y + 40.0f * sinf(angle)));
+		}
+		linesObject->AddComponent(lines);
+		objectManager.AddObject(*linesObject);
+
+		// Circles move up to 50 units per step, several times their radius.
+		for (size_t i = 0; i < circleCount; ++i)
+		{
+			GameObject* object = new GameObject("Circle");
+			const float x = random.Range(-halfSize + 20.0f, halfSize - 20.0f);
+			const float y = random.Range(-halfSize + 20.0f, halfSize - 20.0f);
+			object->AddComponent(new Transform(x, y));
+
+			const float angle = random.Range(0.0f, 6.28318531f);
+			const float speed = random.Range(600.0f, 3000.0f);
+			Physics* physics = new Physics();
+			physics->SetVelocity(Vector2D(cosf(angle), sinf(angle)) * speed);
+			object->AddComponent(physics);
+
+			object->AddComponent(new ColliderCircle(random.Range(2.0f, 10.0f)));
+			objectManager.AddObject(*object);
+		}
+
+		std::vector<GameObject*> circles;
+		objectManager.GetAllObjectsByName("Circle", circles);
+
+		// The object manager is stepped through BetaObject's FixedUpdate, as updating the space
+		//   would also draw the colliders.
+		BetaObject& manager = objectManager;
+		double time = 0.0;
+		for (unsigned step = 0; step < stepCount; ++step)
+		{
+			std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+			manager.FixedUpdate(dt);
+			time += MillisecondsSince(start);
+
+			for (auto it = circles.begin(); it != circles.end(); ++it)
+			{
+				const Vector2D& translation = (*it)->GetComponent<Transform>()->GetTranslation();
+				if (fabsf(translation.x) > halfSize || fabsf(translation.y) > halfSize)
+					passed = false;
+			}
+		}
+
+		return time;
+	}
+
+	// Walks through a maze toward a target the way BaseAI::Pathfind moves a ghost: at each tile it moves to the
+	//   neighbor with the lowest cost, never turning back, with ties going to the first direction.
+	// Params:
+	//   mazeGraph = The links between the maze's cells.
+	//   flowFields = The flow fields costs are read from, or nullptr for the straight-line distance Pathfind used before flow fields.
+	//   width = The width of the maze. Walking off one side leads onto the other.
+	//   tile = The tile to start from.
+	//   target = The target, in tile space.
+	//   maxSteps = The most steps to take.
+	//   directions = Receives the direction of each step.
+	// Returns:
+	//   True if the walk reached the target's tile.
+	bool WalkMaze(const MazeGraph& mazeGraph, FlowFieldMap* flowFields, int width, TileCoord tile, const Vector2D& target, unsigned maxSteps, std::vector<unsigned>& directions)
+	{
+		const TileCoord targetTile = TileCoord::Floor(target + Vector2D(0.5f, 0.5f));
+		TileCoord previous = tile;
+
+		directions.clear();
+		while (tile != targetTile)
+		{
+			if (directions.size() >= maxSteps)
+				return false;
+
+			// The straight-line rule starts from 999, as Pathfind did before flow fields.
+			unsigned closestDirection = 4;
+			float closestCost = flowFields != nullptr ? FLT_MAX : 999.0f;
+			for (unsigned i = 0; i < 4; ++i)
+			{
+				const TileCoord neighbor = tile + DirectionOffsets[i];
+				if (!mazeGraph.IsEmpty(tile.x, tile.y, i) || neighbor == previous)
+					continue;
+
+				const float cost = flowFields != nullptr ? flowFields->GetCost(target, neighbor) : neighbor.ToVector2D().Distance(target);
+				if (cost < closestCost)
+				{
+					closestCost = cost;
+					closestDirection = i;
+				}
+			}
+
+			// Only dead ends leave nowhere to go.
+			if (closestDirection == 4)
+				return false;
+
+			directions.push_back(closestDirection);
+			previous = tile;
+			tile = tile + DirectionOffsets[closestDirection];
+
+			// Tunnels lead onto the other side of the maze.
+			if (tile.x < 0 || tile.x >= width)
+			{
+				const TileCoord wrap(tile.x < 0 ? width : -width, 0);
+				tile = tile + wrap;
+				previous = previous + wrap;
+			}
+		}
+
+		return true;
+	}
+
+	// Fills a ghost swarm in its own space and times moving it.
+	// Params:
+	//   tilemap = The maze the ghosts move through.
+	//   mazeGraph = The links between the maze's cells.
+	//   ghostCount = How many ghosts to add.
+	//   stepCount = How many fixed steps to move them for.
+	//   tiles = Receives the tile each ghost ends up moving to.
+	// Returns:
+	//   The time the steps took, in milliseconds.
+	double TimeGhostSwarm(const Tilemap& tilemap, const MazeGraph& mazeGraph, size_t ghostCount, unsigned stepCount, std::vector<TileCoord>& tiles)
+	{
+		const float dt = 1.0f / 60.0f;
+
+		Space space("Benchmark");
+		GameObjectManager& objectManager = space.GetObjectManager();
+
+		GameObject* tilemapObject = new GameObject("Tilemap");
+		tilemapObject->AddComponent(new Transform());
+		tilemapObject->AddComponent(new SpriteTilemap());
+		objectManager.AddObject(*tilemapObject);
+
+		SpriteTilemap* spriteTilemap = tilemapObject->GetComponent<SpriteTilemap>();
+		spriteTilemap->SetTilemap(&tilemap);
+
+		// There is no player, so the ghosts chase the top-left corner between scatter waves.
+		GameObject* swarmObject = new GameObject("GhostSwarm");
+		swarmObject->AddComponent(new Transform());
+		swarmObject->AddComponent(new Behaviors::GhostSwarm());
+		objectManager.AddObject(*swarmObject);
+
+		Behaviors::GhostSwarm* swarm = swarmObject->GetComponent<Behaviors::GhostSwarm>();
+		swarm->SetTilemap(&tilemap, spriteTilemap, &mazeGraph);
+		swarm->Reserve(ghostCount);
+
+		// Spread the ghosts over the empty tiles of the maze, cycling through the ghost types.
+		const unsigned width = tilemap.GetWidth();
+		const unsigned height = tilemap.GetHeight();
+		unsigned tile = 0;
+		for (size_t i = 0; i < ghostCount; ++i)
+		{
+			while (tilemap.GetCellValue(tile % width, (tile / width) % height) != 0)
+				++tile;
+
+			const TileCoord start(static_cast<int>(tile % width), static_cast<int>((tile / width) % height));
+			swarm->AddGhost(static_cast<GhostTargeting::Ghost>(i % GhostTargeting::GHOST_MAX), start);
+			++tile;
+		}
+
+		// The swarm is stepped directly, as the space would also draw it.
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		for (unsigned step = 0; step < stepCount; ++step)
+			swarm->FixedUpdate(dt);
+		const double time = MillisecondsSince(start);
+
+		tiles.resize(ghostCount);
+		for (size_t i = 0; i < ghostCount; ++i)
+			tiles[i] = swarm->GetTile(i);
+
+		return time;
+	}
+
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Runs a benchmark by name.
+	// Params:
+	//   name = The name of the benchmark. Unknown names list the available ones.
+	//   out = The stream the results are written to.
+	// Returns:
+	//   0 if the benchmark ran and all of its checks passed, nonzero otherwise.
+	int Run(const std::string& name, std::ostream& out)
+	{
+		if (name == "components")
+			return ComponentLookup(out);
+		if (name == "destroy")
+			return ObjectDestruction(out);
+		if (name == "tilemap")
+			return TilemapSweep(out);
+		if (name == "streaming")
+			return TilemapStreaming(out);
+		if (name == "swarm")
+			return GhostSwarmStress(out);
+		if (name == "intersection")
+			return IntersectionBatches(out);
+		if (name == "narrowphase")
+			return NarrowphaseDeterminism(out);
+		if (name == "lines")
+			return LineSweeps(out);
+		if (name == "broadphase")
+			return BroadphaseComparison(out);
+		if (name == "flowfield")
+			return FlowFieldParity(out);
+
+		out << "Unknown benchmark \"" << name << "\". Available benchmarks:" << std::endl;
+		out << "  components" << std::endl;
+		out << "  destroy" << std::endl;
+		out << "  tilemap" << std::endl;
+		out << "  streaming" << std::endl;
+		out << "  swarm" << std::endl;
+		out << "  intersection" << std::endl;
+		out << "  narrowphase" << std::endl;
+		out << "  lines" << std::endl;
+		out << "  broadphase" << std::endl;
+		out << "  flowfield" << std::endl;
+		return 1;
+	}
+
+	// Times looking up components through the per-type cache against searching the component list.
+	// Params:
+	//   out = The stream the results are written to.
+	// Returns:
+	//   0 if both lookups found the same components, nonzero otherwise.
+	int ComponentLookup(std::ostream& out)
+	{
+		const unsigned lookupCount = 1000000;
+
+		// The collider is added last, so the search has to cast every other component first.
+		GameObject object("Benchmark");
+		object.AddComponent(new Transform());
+		object.AddComponent(new Physics());
+		object.AddComponent(new Sprite());
+		object.AddComponent(new Animation());
+		object.AddComponent(new ColliderCircle());
+
+		// Count what was found, so the lookups cannot be optimized away.
+		size_t searchFound = 0;
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		for (unsigned i = 0; i < lookupCount; ++i)
+		{
+			searchFound += object.FindComponent<Transform>() != nullptr;
+			searchFound += object.FindComponent<Collider>() != nullptr;
+		}
+		const double searchTime = MillisecondsSince(start);
+
+		size_t cacheFound = 0;
+		start = std::chrono::high_resolution_clock::now();
+		for (unsigned i = 0; i < lookupCount; ++i)
+		{
+			cacheFound += object.GetComponent<Transform>() != nullptr;
+			cacheFound += object.GetComponent<Collider>() != nullptr;
+		}
+		const double cacheTime = MillisecondsSince(start);
+
+		out << "Component lookups (" << 2 * lookupCount << " each)" << std::endl;
+		out << "  dynamic_cast search: " << searchTime << " ms" << std::endl;
+		out << "  type ID cache:       " << cacheTime << " ms" << std::endl;
+
+		const bool passed = searchFound == cacheFound
+			&& object.FindComponent<Transform>() == object.GetComponent<Transform>()
+			&& object.FindComponent<Collider>() == object.GetComponent<Collider>();
+		out << (passed ? "  PASSED" : "  FAILED: the lookups found different components") << std::endl;
+
+		return passed ? 0 : 1;
+	}
+
+	// Times destroying half of 100,000 objects in a single frame, with each of the object manager's removal modes.
+	// Params:
+	//   out = The stream the results are written to.
+	// Returns:
+	//   0 if every mode left the right objects behind, nonzero otherwise.
+	int ObjectDestruction(std::ostream& out)
+	{
+		const size_t objectCount = 100000;
+		const unsigned reclaimBudget = 1000;
+
+		// Destroyed objects used to be erased from the active list one at a time.
+		std::vector<size_t> activeList(objectCount);
+		for (size_t i = 0; i < objectCount; ++i)
+			activeList[i] = i;
+
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		for (auto it = activeList.begin(); it != activeList.end();)
+		{
+			if (*it % 2 == 0)
+				it = activeList.erase(it);
+			else
+				++it;
+		}
+		const double eraseTime = MillisecondsSince(start);
+
+		bool passed = activeList.size() == objectCount / 2;
+		const double orderedTime = TimeDestroyFrame(objectCount, true, 0, passed);
+		const double unorderedTime = TimeDestroyFrame(objectCount, false, 0, passed);
+		const double budgetTime = TimeDestroyFrame(objectCount, true, reclaimBudget, passed);
+
+		out << "Destroying " << objectCount / 2 << " of " << objectCount << " objects in one frame" << std::endl;
+		out << "  active list erase per object (previous): " << eraseTime << " ms" << std::endl;
+		out << "  ordered removal:                         " << orderedTime << " ms" << std::endl;
+		out << "  unordered removal:                       " << unorderedTime << " ms" << std::endl;
+		out << "  ordered, deleting " << reclaimBudget << " per frame:        " << budgetTime << " ms" << std::endl;
+		out << (passed ? "  PASSED" : "  FAILED: the wrong objects were left behind") << std::endl;
+
+		return passed ? 0 : 1;
+	}
+
+	// Times reading every cell of a 28x31 and a 4096x4096 tilemap, in both cell formats, one cell
+	//   at a time with GetCellValue, a row at a time with GetRow8/GetRow16, and with GetSpan.
+	// Params:
+	//   out = The stream the results are written to.
+	// Returns:
+	//   0 if every way of reading a map gave the same cells, nonzero otherwise.
+	int TilemapSweep(std::ostream& out)
+	{
+		out << "Full tilemap sweeps" << std::endl;
+
+		// The classic maze is 28x31. Values above 255 need 16-bit cells.
+		bool passed = TimeTilemapSweep(out, 28, 31, 15);
+		passed = TimeTilemapSweep(out, 28, 31, 1000) && passed;
+		passed = TimeTilemapSweep(out, 4096, 4096, 15) && passed;
+		passed = TimeTilemapSweep(out, 4096, 4096, 1000) && passed;
+
+		out << (passed ? "  PASSED" : "  FAILED: the sweeps read different cells") << std::endl;
+
+		return passed ? 0 : 1;
+	}
+
+	// Checks that a 4096x4096 tilemap streamed in chunks gives the same cells as the whole file mapped into memory,
+	//   in both cell formats, while a camera sweeps across it, and that the streamer stays within its chunk budget.
+	// Params:
+	//   out = The stream the results are written to.
+	// Returns:
+	//   0 if every streamed cell matched and the budget was kept, nonzero otherwise.
+	int TilemapStreaming(std::ostream& out)
+	{
+		out << "Streaming tilemap camera sweeps" << std::endl;
+
+		bool passed = CheckStreamingSweep(out, 4096, 4096, 15);
+		passed = CheckStreamingSweep(out, 4096, 4096, 1000) && passed;
+
+		out << (passed ? "  PASSED" : "  FAILED: the streamed cells differed from the file, or too many chunks stayed in memory") << std::endl;
+
+		return passed ? 0 : 1;
+	}
+
+	// Times the ghost swarm moving 10,000 ghosts through the first level's maze for ten seconds of game time.
+	// Params:
+	//   out = The stream the results are written to.
+	// Returns:
+	//   0 if two runs moved every ghost the same way and no ghost ended up inside a wall, nonzero otherwise.
+	int GhostSwarmStress(std::ostream& out)
+	{
+		const size_t ghostCount = 10000;
+		const unsigned stepCount = 600;
+
+		Tilemap* tilemap = Tilemap::CreateTilemapFromFile("Assets/Levels/Level1.txt");
+		if (tilemap == nullptr)
+		{
+			out << "  FAILED: Assets/Levels/Level1.txt could not be loaded" << std::endl;
+			return 1;
+		}
+
+		MazeGraph* mazeGraph = new MazeGraph(*tilemap);
+
+		// The batches of each step run in parallel, so two runs only match if no ghost depends on another's batch.
+		std::vector<TileCoord> firstTiles;
+		std::vector<TileCoord> secondTiles;
+		const double firstTime = TimeGhostSwarm(*tilemap, *mazeGraph, ghostCount, stepCount, firstTiles);
+		const double secondTime = TimeGhostSwarm(*tilemap, *mazeGraph, ghostCount, stepCount, secondTiles);
+
+		bool passed = firstTiles == secondTiles;
+		for (auto it = firstTiles.begin(); it != firstTiles.end(); ++it)
+		{
+			// Ghosts in the tunnel may be off the edge of the map.
+			if (tilemap->GetCellValue(it->x, it->y) > 0)
+				passed = false;
+		}
+
+		delete mazeGraph;
+		delete tilemap;
+
+		out << "Ghost swarm, " << ghostCount << " ghosts for " << stepCount << " steps on "
+			<< ThreadPool::GetInstance().GetThreadCount() << " threads" << std::endl;
+		out << "  first run:  " << firstTime << " ms (" << firstTime / stepCount << " ms per step)" << std::endl;
+		out << "  second run: " << secondTime << " ms (" << secondTime / stepCount << " ms per step)" << std::endl;
+		out << (passed ? "  PASSED" : "  FAILED: the runs differed or a ghost ended up inside a wall") << std::endl;
+
+		return passed ? 0 : 1;
+	}
+
+	// Checks that the scalar, SSE2 and AVX2 batch intersection tests agree with the single-pair tests on random
+	//   shapes, including touching shapes and counts that are not a multiple of the vector width, and times each.
+	// Params:
+	//   out = The stream the results are written to.
+	// Returns:
+	//   0 if every instruction set gave the same results as the single-pair tests, nonzero otherwise.
+	int IntersectionBatches(std::ostream& out)
+	{
+		const size_t checkCounts[] = { 0, 1, 3, 4, 5, 7, 8, 9, 15, 17, 31, 33, 100, 257, 1001 };
+		const size_t timedCount = 100003;
+		const unsigned timedRepeats = 100;
+
+		const IntersectionBatch::InstructionSet supported = IntersectionBatch::GetSupportedInstructionSet();
+		out << "Batch intersection tests (this processor supports " << InstructionSetNames[supported] << ")" << std::endl;
+
+		// The shapes touch the axis-aligned test shapes exactly, and are tested against a rotated box as well.
+		const Circle circle(Vector2D(0.0f, 0.0f), 2.0f);
+		const BoundingRectangle rectangle(Vector2D(0.0f, 0.0f), Vector2D(2.0f, 1.5f));
+		const OBBShape obb = MakeOBB(Vector2D(0.0f, 0.0f), Vector2D(2.0f, 1.5f), 0.0f);
+		const OBBShape rotatedOBB = MakeOBB(Vector2D(0.5f, -0.25f), Vector2D(2.0f, 1.5f), 0.6f);
+
+		RandomStream random(22);
+		bool passed = true;
+		for (size_t i = 0; i < sizeof(checkCounts) / sizeof(checkCounts[0]); ++i)
+		{
+			BatchShapes shapes;
+			MakeBatchShapes(shapes, random, checkCounts[i]);
+			passed = CheckIntersectionBatches(out, shapes, circle, rectangle, obb) && passed;
+			passed = CheckIntersectionBatches(out, shapes, circle, rectangle, rotatedOBB) && passed;
+		}
+
+		BatchShapes shapes;
+		MakeBatchShapes(shapes, random, timedCount);
+		const CircleArrays circles = { shapes.centerX.data(), shapes.centerY.data(), shapes.radius.data(), timedCount };
+		const RectangleArrays rectangles = { shapes.left.data(), shapes.right.data(), shapes.top.data(), shapes.bottom.data(), timedCount };
+		OBBArrays obbs;
+		for (unsigned i = 0; i < 4; ++i)
+		{
+			obbs.cornerX[i] = shapes.cornerX[i].data();
+			obbs.cornerY[i] = shapes.cornerY[i].data();
+		}
+		for (unsigned i = 0; i < 2; ++i)
+		{
+			obbs.axisX[i] = shapes.axisX[i].data();
+			obbs.axisY[i] = shapes.axisY[i].data();
+		}
+		obbs.count = timedCount;
+
+		std::vector<unsigned char> results(timedCount);
+		out << "  " << timedCount << " shapes, " << timedRepeats << " times each" << std::endl;
+		for (int set = IntersectionBatch::INSTRUCTIONS_SCALAR; set <= supported; ++set)
+		{
+			IntersectionBatch::SetInstructionSet(static_cast<IntersectionBatch::InstructionSet>(set));
+
+			// Count the hits, so the tests cannot be optimized away.
+			size_t hits = 0;
+			std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+			for (unsigned i = 0; i < timedRepeats; ++i)
+				hits += IntersectionBatch::CircleCircleIntersection(circle, circles, results.data());
+			const double circleTime = MillisecondsSince(start);
+
+			start = std::chrono::high_resolution_clock::now();
+			for (unsigned i = 0; i < timedRepeats; ++i)
+				hits += IntersectionBatch::RectangleRectangleIntersection(rectangle, rectangles, results.data());
+			const double rectangleTime = MillisecondsSince(start);
+
+			start = std::chrono::high_resolution_clock::now();
+			for (unsigned i = 0; i < timedRepeats; ++i)
+				hits += IntersectionBatch::OBBOBBIntersection(rotatedOBB, obbs, results.data());
+			const double obbTime = MillisecondsSince(start);
+
+			out << "  " << InstructionSetNames[set] << ": circles " << circleTime << " ms, rectangles " << rectangleTime
+				<< " ms, boxes " << obbTime << " ms (" << hits << " hits)" << std::endl;
+		}
+
+		IntersectionBatch::SetInstructionSet(supported);
+
+		out << (passed ? "  PASSED" : "  FAILED: an instruction set disagreed with the single-pair tests") << std::endl;
+
+		return passed ? 0 : 1;
+	}
+
+	// Checks that the narrowphase sends the same collision events in the same order whether it runs on the
+	//   main thread or across the thread pool, and times both.
+	// Params:
+	//   out = The stream the results are written to.
+	// Returns:
+	//   0 if both runs sent the same events, nonzero otherwise.
+	int NarrowphaseDeterminism(std::ostream& out)
+	{
+		const size_t bodyCount = 4000;
+		const unsigned stepCount = 300;
+
+		CollisionRecording serial;
+		CollisionRecording parallel;
+		const double serialTime = TimeNarrowphase(false, nullptr, bodyCount, stepCount, serial);
+		const double parallelTime = TimeNarrowphase(true, nullptr, bodyCount, stepCount, parallel);
+
+		// Every kind of event should have been sent, or the check would not cover it.
+		size_t eventCounts[3] = { 0, 0, 0 };
+		for (size_t i = 0; i < serial.events.size(); i += 3)
+			++eventCounts[serial.events[i]];
+
+		const bool passed = serial.events == parallel.events
+			&& eventCounts[0] != 0 && eventCounts[1] != 0 && eventCounts[2] != 0;
+
+		out << "Narrowphase, " << bodyCount << " bodies for " << stepCount << " steps on "
+			<< ThreadPool::GetInstance().GetThreadCount() << " threads" << std::endl;
+		out << "  " << eventCounts[0] << " enter, " << eventCounts[1] << " stay and " << eventCounts[2] << " exit events" << std::endl;
+		out << "  main thread: " << serialTime << " ms (" << serialTime / stepCount << " ms per step)" << std::endl;
+		out << "  thread pool: " << parallelTime << " ms (" << parallelTime / stepCount << " ms per step)" << std::endl;
+		out << (passed ? "  PASSED" : "  FAILED: the runs sent different collision events") << std::endl;
+
+		return passed ? 0 : 1;
+	}
+
+	// Checks that greedy flow fields choose the same directions as the straight-line rule ghosts used before flow
+	//   fields, and that flow fields never take more steps to reach a target.
+	// Params:
+	//   out = The stream the results are written to.
+	// Returns:
+	//   0 if both checks passed, nonzero otherwise.
+	int FlowFieldParity(std::ostream& out)
+	{
+		const unsigned parityStepCount = 100;
+		const unsigned maxSteps = 1000;
+
+		Tilemap* tilemap = Tilemap::CreateTilemapFromFile("Assets/Levels/Level1.txt");
+		if (tilemap == nullptr)
+		{
+			out << "  FAILED: Assets/Levels/Level1.txt could not be loaded" << std::endl;
+			return 1;
+		}
+
+		MazeGraph* mazeGraph = new MazeGraph(*tilemap);
+		FlowFieldMap* flowFields = new FlowFieldMap();
+		flowFields->SetTilemap(tilemap, true);
+
+		// Only tiles connected to the maze's top-left corner, which leaves out the ghost house and the empty
+		//   cells beside the tunnels.
+		const int width = static_cast<int>(tilemap->GetWidth());
+		const int height = static_cast<int>(tilemap->GetHeight());
+		std::vector<TileCoord> walkable;
+		for (int row = 0; row < height; ++row)
+		{
+			for (int column = 0; column < width; ++column)
+			{
+				if (flowFields->GetDistance(TileCoord(1, 1), TileCoord(column, row)) != FlowFieldMap::unreachable)
+					walkable.push_back(TileCoord(column, row));
+			}
+		}
+
+		// The scatter corners and ghost house, which are off the map or cannot be reached, and walkable tiles.
+		std::vector<Vector2D> targets;
+		targets.push_back(Vector2D(25.0f, -2.0f));
+		targets.push_back(Vector2D(2.0f, -2.0f));
+		targets.push_back(Vector2D(27.0f, 32.0f));
+		targets.push_back(Vector2D(13.0f, 14.0f));
+		const size_t firstWalkableTarget = targets.size();
+
+		RandomStream random(16);
+		for (unsigned i = 0; i < 12; ++i)
+			targets.push_back(walkable[random.NextBelow(static_cast<unsigned>(walkable.size()))].ToVector2D());
+
+		// Greedy mode should make every choice the old rule made, from every tile to every target.
+		flowFields->SetMode(FlowFieldMap::MODE_GREEDY);
+		std::vector<unsigned> expected;
+		std::vector<unsigned> directions;
+		size_t parityMismatches = 0;
+		for (auto start = walkable.begin(); start != walkable.end(); ++start)
+		{
+			for (auto target = targets.begin(); target != targets.end(); ++target)
+			{
+				WalkMaze(*mazeGraph, nullptr, width, *start, *target, parityStepCount, expected);
+				WalkMaze(*mazeGraph, flowFields, width, *start, *target, parityStepCount, directions);
+				if (directions != expected)
+					++parityMismatches;
+			}
+		}
+
+		// Flow fields follow a shortest path, so they should never need more steps than the greedy rule.
+		flowFields->SetMode(FlowFieldMap::MODE_FLOW_FIELD);
+		size_t walkCount = 0;
+		size_t greedyMisses = 0;
+		size_t flowMisses = 0;
+		size_t longerWalks = 0;
+		unsigned long long greedySteps = 0;
+		unsigned long long flowSteps = 0;
+		for (auto start = walkable.begin(); start != walkable.end(); ++start)
+		{
+			for (auto target = targets.begin() + firstWalkableTarget; target != targets.end(); ++target)
+			{
+				++walkCount;
+				const bool greedyReached = WalkMaze(*mazeGraph, nullptr, width, *start, *target, maxSteps, expected);
+				const bool flowReached = WalkMaze(*mazeGraph, flowFields, width, *start, *target, maxSteps, directions);
+
+				// Walks that never arrive count as taking every step.
+				const size_t greedyCount = greedyReached ? expected.size() : maxSteps;
+				const size_t flowCount = flowReached ? directions.size() : maxSteps;
+				greedySteps += greedyCount;
+				flowSteps += flowCount;
+				if (!greedyReached)
+					++greedyMisses;
+				if (!flowReached)
+					++flowMisses;
+				if (flowCount > greedyCount)
+					++longerWalks;
+			}
+		}
+
+		delete flowFields;
+		delete mazeGraph;
+		delete tilemap;
+
+		out << "Flow fields on the first level's maze, from " << walkable.size() << " tiles" << std::endl;
+		out << "  greedy mode against the straight-line rule: " << walkable.size() * targets.size() << " walks of up to "
+			<< parityStepCount << " steps, " << parityMismatches << " differed" << std::endl;
+		out << "  " << walkCount << " walks to walkable targets:" << std::endl;
+		out << "    greedy:     " << greedySteps << " steps, " << greedyMisses << " never arrived" << std::endl;
+		out << "    flow field: " << flowSteps << " steps, " << flowMisses << " never arrived, "
+			<< longerWalks << " longer than greedy" << std::endl;
+
+		const bool passed = parityMismatches == 0 && flowMisses == 0 && longerWalks == 0;
+		out << (passed ? "  PASSED" : "  FAILED: greedy mode made different choices, or a flow field walk was longer") << std::endl;
+
+		return passed ? 0 : 1;
+	}
+
+	// Checks that the sort and sweep broadphase finds the same pairs as the grid, including on the first step and
+	//   when many colliders are added or removed at once, and times both.
+	// Params:
+	//   out = The stream the results are written to.
+	// Returns:
+	//   0 if both broadphases found the same pairs and sent the same collision events, nonzero otherwise.
+	int BroadphaseComparison(std::ostream& out)
+	{
+		const size_t bodyCount = 20000;
+		const size_t spawnCount = 20000;
+		const unsigned stepCount = 120;
+		const float dt = 1.0f / 60.0f;
+
+		// The colliders need an object and transform, but the broadphases are called directly.
+		Space space("Benchmark");
+		GameObjectManager& objectManager = space.GetObjectManager();
+
+		RandomStream random(2);
+		std::vector<Collider*> colliders;
+		std::vector<Vector2D> velocities;
+		std::vector<bool> removed;
+		AddBroadphaseCircles(objectManager, random, bodyCount, colliders, velocities);
+		removed.resize(colliders.size(), false);
+
+		BroadphaseGrid grid;
+		BroadphaseSweep sweep;
+		std::vector<BroadphaseProxy> proxies;
+		std::vector<BroadphasePair> gridPairs;
+		std::vector<BroadphasePair> sweepPairs;
+
+		double gridTimes[3] = { 0.0, 0.0, 0.0 };
+		double sweepTimes[3] = { 0.0, 0.0, 0.0 };
+		size_t pairCount = 0;
+		bool passed = true;
+		for (unsigned step = 0; step < stepCount; ++step)
+		{
+			// Halfway through, remove every fourth collider and add as many new ones as there were to begin with.
+			const bool spawnStep = step == stepCount / 2;
+			if (spawnStep)
+			{
+				for (size_t i = 0; i < colliders.size(); i += 4)
+				{
+					removed[i] = true;
+					grid.RemoveCollider(*colliders[i]);
+					sweep.RemoveCollider(*colliders[i]);
+				}
+
+				AddBroadphaseCircles(objectManager, random, spawnCount, colliders, velocities);
+				removed.resize(colliders.size(), false);
+			}
+
+			proxies.clear();
+			for (size_t i = 0; i < colliders.size(); ++i)
+			{
+				if (removed[i])
+					continue;
+
+				Transform* transform = colliders[i]->transform;
+				transform->SetTranslation(transform->GetTranslation() + velocities[i] * dt);
+
+				BroadphaseProxy proxy(colliders[i]);
+				proxy.bounded = colliders[i]->GetBounds(proxy.min, proxy.max);
+				proxies.push_back(proxy);
+			}
+
+			// Time the first step, the spawn step and every other step separately.
+			const unsigned timing = step == 0 ? 0 : (spawnStep ? 1 : 2);
+			gridTimes[timing] += TimeFindPairs(grid, proxies, gridPairs);
+			sweepTimes[timing] += TimeFindPairs(sweep, proxies, sweepPairs);
+
+			pairCount += gridPairs.size();
+			if (gridPairs.size() != sweepPairs.size()
+				|| !std::equal(gridPairs.begin(), gridPairs.end(), sweepPairs.begin(), BroadphasePairEqual))
+			{
+				if (passed)
+					out << "  the broadphases found different pairs on step " << step << std::endl;
+				passed = false;
+			}
+		}
+
+		// Run the whole collision step with the sweep broadphase selected through the object manager.
+		const size_t eventBodyCount = 4000;
+		const unsigned eventStepCount = 120;
+		CollisionRecording gridEvents;
+		CollisionRecording sweepEvents;
+		TimeNarrowphase(true, nullptr, eventBodyCount, eventStepCount, gridEvents);
+		TimeNarrowphase(true, new BroadphaseSweep(), eventBodyCount, eventStepCount, sweepEvents);
+		if (gridEvents.events != sweepEvents.events)
+		{
+			out << "  the broadphases led to different collision events" << std::endl;
+			passed = false;
+		}
+
+		out << "Broadphases, " << bodyCount << " circles for " << stepCount << " steps, removing a quarter and adding "
+			<< spawnCount << " halfway (" << pairCount << " pairs)" << std::endl;
+		out << "  grid:           first step " << gridTimes[0] << " ms, spawn step " << gridTimes[1] << " ms, other steps "
+			<< gridTimes[2] / (stepCount - 2) << " ms each" << std::endl;
+		out << "  sort and sweep: first step " << sweepTimes[0] << " ms, spawn step " << sweepTimes[1] << " ms, other steps "
+			<< sweepTimes[2] / (stepCount - 2) << " ms each" << std::endl;
+		out << (passed ? "  PASSED" : "  FAILED: the broadphases disagreed") << std::endl;
+
+		return passed ? 0 : 1;
+	}
+
+	// Checks that circles swept against line segments cannot pass through them, including circles that start
+	//   closer to a segment than their radius, and times circles bouncing around inside a box of line colliders.
+	// Params:
+	//   out = The stream the results are written to.
+	// Returns:
+	//   0 if no circle passed through a segment or left the box, nonzero otherwise.
+	int LineSweeps(std::ostream& out)
+	{
+		const size_t sweepCount = 100000;
+		const size_t circleCount = 2000;
+		const unsigned stepCount = 300;
+
+		out << "Circles swept against line segments" << std::endl;
+
+		RandomStream random(25);
+		bool passed = CheckCircleSweeps(out, random, sweepCount);
+
+		bool bouncesPassed = true;
+		const double time = TimeLineBounces(circleCount, stepCount, bouncesPassed);
+		out << "  " << circleCount << " circles bouncing in a box for " << stepCount << " steps: "
+			<< time << " ms (" << time / stepCount << " ms per step)" << std::endl;
+		if (!bouncesPassed)
+			out << "  a circle left the box" << std::endl;
+
+		passed = passed && bouncesPassed;
+		out << (passed ? "  PASSED" : "  FAILED: a circle passed through a segment") << std::endl;
+
+		return passed ? 0 : 1;
+	}
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,121 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	Benchmarks.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		BetaFramework
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <ostream>
+#include <string>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// Benchmarks and self-checks run from the command line instead of the game,
+//   e.g. "PAC-MAN.exe -bench components > results.txt".
+namespace Benchmarks
+{
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Runs a benchmark by name.
+	// Params:
+	//   name = The name of the benchmark. Unknown names list the available ones.
+	//   out = The stream the results are written to.
+	// Returns:
+	//   0 if the benchmark ran and all of its checks passed, nonzero otherwise.
+	int Run(const std::string& name, std::ostream& out);
+
+	// Times looking up components through the per-type cache against searching the component list.
+	// Params:
+	//   out = The stream the results are written to.
+	// Returns:
+	//   0 if both lookups found the same components, nonzero otherwise.
+	int ComponentLookup(std::ostream& out);
+
+	// Times destroying half of 100,000 objects in a single frame, with each of the object manager's removal modes.
+	// Params:
+	//   out = The stream the results are written to.
+	// Returns:
+	//   0 if every mode left the right objects behind, nonzero otherwise.
+	int ObjectDestruction(std::ostream& out);
+
+	// Times reading every cell of a 28x31 and a 4096x4096 tilemap, in both cell formats, one cell
+	//   at a time with GetCellValue, a row at a time with GetRow8/GetRow16, and with GetSpan.
+	// Params:
+	//   out = The stream the results are written to.
+	// Returns:
+	//   0 if every way of reading a map gave the same cells, nonzero otherwise.
+	int TilemapSweep(std::ostream& out);
+
+	// Checks that a 4096x4096 tilemap streamed in chunks gives the same cells as the whole file mapped into memory,
+	//   in both cell formats, while a camera sweeps across it, and that the streamer stays within its chunk budget.
+	// Params:
+	//   out = The stream the results are written to.
+	// Returns:
+	//   0 if every streamed cell matched and the budget was kept, nonzero otherwise.
+	int TilemapStreaming(std::ostream& out);
+
+	// Times the ghost swarm moving 10,000 ghosts through the first level's maze for ten seconds of game time.
+	// Params:
+	//   out = The stream the results are written to.
+	// Returns:
+	//   0 if two runs moved every ghost the same way and no ghost ended up inside a wall, nonzero otherwise.
+	int GhostSwarmStress(std::ostream& out);
+
+	// Checks that the scalar, SSE2 and AVX2 batch intersection tests agree with the single-pair tests on random
+	//   shapes, including touching shapes and counts that are not a multiple of the vector width, and times each.
+	// Params:
+	//   out = The stream the results are written to.
+	// Returns:
+	//   0 if every instruction set gave the same results as the single-pair tests, nonzero otherwise.
+	int IntersectionBatches(std::ostream& out);
+
+	// Checks that the collision narrowphase sends the same events in the same order on the main thread and across
+	//   the thread pool, with 4,000 moving circles and spinning boxes for five seconds of game time, and times both.
+	// Params:
+	//   out = The stream the results are written to.
+	// Returns:
+	//   0 if both runs sent the same events, nonzero otherwise.
+	int NarrowphaseDeterminism(std::ostream& out);
+
+	// Checks that circles swept against line segments never pass through them, including circles that start closer
+	//   to a segment than their radius, and times 2,000 fast circles bouncing inside a box of line colliders.
+	// Params:
+	//   out = The stream the results are written to.
+	// Returns:
+	//   0 if no circle passed through a segment or left the box, nonzero otherwise.
+	int LineSweeps(std::ostream& out);
+
+	// Checks that the sort and sweep broadphase finds the same pairs as the grid with 20,000 moving circles, including
+	//   on the first step and when a quarter are removed and 20,000 more added at once, and times both.
+	// Params:
+	//   out = The stream the results are written to.
+	// Returns:
+	//   0 if both broadphases found the same pairs and sent the same collision events, nonzero otherwise.
+	int BroadphaseComparison(std::ostream& out);
+
+	// Checks on the first level's maze that greedy flow fields choose the same directions as the straight-line rule ghosts
+	//   used before flow fields, and that flow fields reach walkable targets in no more steps than the greedy rule.
+	// Params:
+	//   out = The stream the results are written to.
+	// Returns:
+	//   0 if both checks passed, nonzero otherwise.
+	int FlowFieldParity(std::ostream& out);
+}
+
+//------------------------------------------------------------------------------
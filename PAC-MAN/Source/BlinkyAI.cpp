@@ -62,10 +62,14 @@ namespace Behaviors
 		// Call BaseAI's FixedUpdate
 		BaseAI::FixedUpdate(dt);
 
-		float pacmanBaseSpeed = player->GetComponent<PlayerController>()->GetSpeed(0);
+		GameObject* playerObject = GetPlayer();
+		if (playerObject == nullptr)
+			return;
+
+		float pacmanBaseSpeed = playerObject->GetComponent<PlayerController>()->GetSpeed(0);
 
 		// Check if 10 pellets are left
-		if (player->GetComponent<PlayerScore>()->GetDots() >= 230)
+		if (playerObject->GetComponent<PlayerScore>()->GetDots() >= 230)
 		{
 			// Set isElroy to true
 			isElroy = true;
@@ -73,7 +77,7 @@ namespace Behaviors
 			GetOwner()->GetComponent<GridMovement>()->SetSpeed((GhostBaseSpeed + 2 * IncreaseSpeedRate) * pacmanBaseSpeed);
 		}
 		// Check if 20 pellets are left
-		else if (player->GetComponent<PlayerScore>()->GetDots() >= 220)
+		else if (playerObject->GetComponent<PlayerScore>()->GetDots() >= 220)
 		{
 			// Set isElroy to true
 			isElroy = true;
@@ -95,8 +99,12 @@ namespace Behaviors
 		UNREFERENCED_PARAMETER(adjacentTiles);
 		UNREFERENCED_PARAMETER(emptyCount);
 
+		GameObject* playerObject = GetPlayer();
+		if (playerObject == nullptr)
+			return;
+
 		// Set Chase Target (Player Position)
 		if (mode == CHASE || isElroy)
-			target = GetSpriteTilemap()->WorldToTile(player->GetComponent<Transform>()->GetTranslation());
+			target = GhostTargeting::GetBlinkyTarget(GetPlayerState(*playerObject));
 	}
 }
@@ -26,8 +26,6 @@
 #include "PlayerScore.h"
 #include "spriteTileMap.h"
 
-const float MaxDistanceSqrd = 64.0f;
-
 //------------------------------------------------------------------------------
 
 //------------------------------------------------------------------------------
@@ -66,15 +64,10 @@ namespace Behaviors
 		UNREFERENCED_PARAMETER(adjacentTiles);
 		UNREFERENCED_PARAMETER(emptyCount);
 
-		// Get Player Position
-		Vector2D playerPos = GetSpriteTilemap()->WorldToTile(player->GetComponent<Transform>()->GetTranslation());
-		// Get distance squared between Clyde and PAC-MAN
-		float distSqToPacman = GetNewTile().DistanceSquared(playerPos);
+		GameObject* playerObject = GetPlayer();
+		if (playerObject == nullptr)
+			return;
 
-		// If Clyde is further than 8 tiles from PAC-MAN 
-		if (distSqToPacman >= MaxDistanceSqrd)
-			target = playerPos;
-		else
-			target = scatterTarget;
+		target = GhostTargeting::GetClydeTarget(GetPlayerState(*playerObject), GetNewTile().ToVector2D(), scatterTarget);
 	}
 }
@@ -22,6 +22,7 @@
 
 #include "BaseAI.h"
 #include "PlayerController.h"
+#include "Tags.h"
 
 //------------------------------------------------------------------------------
 // Public Structures:
@@ -48,7 +49,7 @@ namespace Behaviors
 		// Get each ghost
 		std::vector<GameObject*> ghosts;
 		ghosts.reserve(4);
-		this->GetOwner()->GetSpace()->GetObjectManager().GetAllObjectsByName("Ghost", ghosts);
+		this->GetOwner()->GetSpace()->GetObjectManager().GetAllObjectsWithTags(Tags::Ghost, ghosts);
 		// Set every ghost's mode to frightened
 		for (GameObject* ghost : ghosts)
 			ghost->GetComponent<BaseAI>()->SetFrightened();
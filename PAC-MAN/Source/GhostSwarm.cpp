@@ -0,0 +1,415 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	GhostSwarm.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		PAC-MAN
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "GhostSwarm.h"
+
+// Systems
+#include <GameObject.h>
+#include <Space.h>
+#include <GameObjectManager.h>
+#include <Parser.h>
+#include <Tilemap.h>
+#include <ThreadPool.h>
+#include <Interpolation.h>
+#include <cfloat>
+#include "MazeGraph.h"
+
+// Components
+#include <Transform.h>
+#include <Sprite.h>
+#include <SpriteTilemap.h>
+#include "GridMovement.h"
+
+// How many ghosts each batch of the parallel update covers.
+const size_t SwarmBatchSize = 256;
+
+// Length of each scatter/chase wave, matching the ghost components. The last wave never ends.
+const unsigned SwarmWaveCount = 8;
+const float SwarmWaveTime[SwarmWaveCount] = { 7.0f, 20.0f, 7.0f, 20.0f, 5.0f, 20.0f, 5.0f, -1.0f };
+
+// Offsets to the neighboring tile in each direction, numbered up, left, down, right.
+const int DirectionOffsetX[4] = { 0, -1, 0, 1 };
+const int DirectionOffsetY[4] = { -1, 0, 1, 0 };
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+namespace Behaviors
+{
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Default constructor
+	GhostSwarm::GhostSwarm() : Component("GhostSwarm"), transform(nullptr), sprite(nullptr),
+		tilemap(nullptr), spriteTilemap(nullptr), mazeGraph(nullptr), player(), random(),
+		speed(8.25f), frightSpeed(5.5f), frightenTime(6.0f), stepTime(0.0f), playerState()
+	{
+		// Use the scatter targets of the ghost archetypes.
+		scatterTargets[GhostTargeting::BLINKY] = Vector2D(25.0f, -2.0f);
+		scatterTargets[GhostTargeting::PINKY] = Vector2D(2.0f, -2.0f);
+		scatterTargets[GhostTargeting::INKY] = Vector2D(27.0f, 32.0f);
+		scatterTargets[GhostTargeting::CLYDE] = Vector2D(27.0f, 32.0f);
+	}
+
+	// Clone a component and return a pointer to the cloned component.
+	// Returns:
+	//   A pointer to a dynamically allocated clone of the component.
+	Component* GhostSwarm::Clone() const
+	{
+		return new GhostSwarm(*this);
+	}
+
+	// Initialize this component (happens at object creation).
+	void GhostSwarm::Initialize()
+	{
+		transform = GetOwner()->GetComponent<Transform>();
+		sprite = GetOwner()->GetComponent<Sprite>();
+
+		GameObject* playerObject = GetOwner()->GetSpace()->GetObjectManager().GetObjectByName("PAC-MAN");
+		player = playerObject != nullptr ? playerObject->GetHandle() : GameObjectHandle();
+
+		random = GetOwner()->GetSpace()->GetRandom().Split();
+	}
+
+	// Updates components using a fixed timestep (usually just physics)
+	// Params:
+	//	 dt = A fixed change in time, usually 1/60th of a second.
+	void GhostSwarm::FixedUpdate(float dt)
+	{
+		if (mazeGraph == nullptr || ghosts.empty())
+			return;
+
+		// Read the player once for the whole swarm.
+		GameObject* playerObject = GetOwner()->GetSpace()->GetObjectManager().GetObjectByHandle(player);
+		if (playerObject != nullptr)
+		{
+			const GridMovement* playerMovement = playerObject->GetComponent<GridMovement>();
+			playerState.tile = spriteTilemap->WorldToTile(playerObject->GetComponent<Transform>()->GetTranslation());
+			playerState.ahead2 = playerMovement->GetDirectionVector(2);
+			playerState.ahead4 = playerMovement->GetDirectionVector(4);
+		}
+
+		stepTime = dt;
+		tileSnapshot = newTiles;
+
+		ThreadPool::GetInstance().ParallelFor(ghosts.size(), SwarmBatchSize, UpdateBatch, this);
+	}
+
+	// Draws every ghost in the swarm.
+	void GhostSwarm::Draw()
+	{
+		if (sprite == nullptr || spriteTilemap == nullptr)
+			return;
+
+		const Vector2D& translation = transform->GetTranslation();
+		for (size_t i = 0; i < ghosts.size(); ++i)
+		{
+			// Linearly interpolate from the old tile to the new tile, the same way GridMovement does.
+			Vector2D tileSpace = Interpolate(oldTiles[i].ToVector2D(), newTiles[i].ToVector2D(), std::min(1.0f, tileProgress[i]));
+			sprite->Draw(spriteTilemap->TileToWorld(tileSpace) - translation);
+		}
+	}
+
+	// Write object data to file
+	// Params:
+	//   parser = The parser that is writing this object to a file.
+	void GhostSwarm::Serialize(Parser& parser) const
+	{
+		parser.WriteVariable("speed", speed);
+		parser.WriteVariable("frightSpeed", frightSpeed);
+	}
+
+	// Read object data from a file
+	// Params:
+	//   parser = The parser that is reading this object's data from a file.
+	void GhostSwarm::Deserialize(Parser& parser)
+	{
+		parser.ReadVariable("speed", speed);
+		parser.ReadVariable("frightSpeed", frightSpeed);
+	}
+
+	// Sets the tilemap used for the grid.
+	// Params:
+	//   tilemap = The tilemap.
+	//   spriteTilemap = The sprite tilemap.
+	//   mazeGraph = The links between the tilemap's cells.
+	void GhostSwarm::SetTilemap(const Tilemap* tilemap_, const SpriteTilemap* spriteTilemap_, const MazeGraph* mazeGraph_)
+	{
+		tilemap = tilemap_;
+		spriteTilemap = spriteTilemap_;
+		mazeGraph = mazeGraph_;
+	}
+
+	// Reserves room in the arrays so they do not grow during play.
+	// Params:
+	//   count = How many ghosts to reserve room for.
+	void GhostSwarm::Reserve(size_t count)
+	{
+		ghosts.reserve(count);
+		partners.reserve(count);
+		oldTiles.reserve(count);
+		newTiles.reserve(count);
+		directions.reserve(count);
+		tileProgress.reserve(count);
+		modes.reserve(count);
+		waves.reserve(count);
+		waveTimers.reserve(count);
+		frightTimers.reserve(count);
+		speeds.reserve(count);
+		forceReverse.reserve(count);
+		randomStreams.reserve(count);
+		tileSnapshot.reserve(count);
+	}
+
+	// Adds a ghost to the swarm. Inky ghosts pair with the Blinky added most recently before them.
+	// Params:
+	//   ghost = Which ghost's targeting rule to use.
+	//   tile = The tile to start on.
+	// Returns:
+	//   The index of the new ghost.
+	size_t GhostSwarm::AddGhost(GhostTargeting::Ghost ghost, TileCoord tile)
+	{
+		const size_t index = ghosts.size();
+
+		// Find the Blinky to pair with. Without one, Inky pairs with itself.
+		unsigned partner = static_cast<unsigned>(index);
+		for (size_t i = index; i > 0; --i)
+		{
+			if (ghosts[i - 1] == GhostTargeting::BLINKY)
+			{
+				partner = static_cast<unsigned>(i - 1);
+				break;
+			}
+		}
+
+		ghosts.push_back(static_cast<unsigned char>(ghost));
+		partners.push_back(partner);
+		oldTiles.push_back(tile);
+		newTiles.push_back(tile);
+		directions.push_back(0);
+		tileProgress.push_back(0.0f);
+		modes.push_back(SCATTER);
+		waves.push_back(0);
+		waveTimers.push_back(0.0f);
+		frightTimers.push_back(0.0f);
+		speeds.push_back(speed);
+		forceReverse.push_back(0);
+		randomStreams.push_back(random.Split());
+
+		return index;
+	}
+
+	// Removes every ghost from the swarm.
+	void GhostSwarm::Clear()
+	{
+		ghosts.clear();
+		partners.clear();
+		oldTiles.clear();
+		newTiles.clear();
+		directions.clear();
+		tileProgress.clear();
+		modes.clear();
+		waves.clear();
+		waveTimers.clear();
+		frightTimers.clear();
+		speeds.clear();
+		forceReverse.clear();
+		randomStreams.clear();
+		tileSnapshot.clear();
+	}
+
+	// Gets how many ghosts are in the swarm.
+	size_t GhostSwarm::GetGhostCount() const
+	{
+		return ghosts.size();
+	}
+
+	// Gets the tile a ghost is moving to.
+	// Params:
+	//   index = The index of the ghost.
+	TileCoord GhostSwarm::GetTile(size_t index) const
+	{
+		return newTiles[index];
+	}
+
+	// Sets every ghost to the frightened state.
+	void GhostSwarm::SetFrightened()
+	{
+		for (size_t i = 0; i < ghosts.size(); ++i)
+		{
+			modes[i] = FRIGHTENED;
+			frightTimers[i] = frightenTime;
+			speeds[i] = frightSpeed;
+			forceReverse[i] = 1;
+		}
+	}
+
+	//------------------------------------------------------------------------------
+	// Private Functions:
+	//------------------------------------------------------------------------------
+
+	// Updates one batch of ghosts. Called by the thread pool.
+	// Params:
+	//   context = The swarm.
+	//   begin = The first ghost in the batch.
+	//   end = One past the last ghost in the batch.
+	void GhostSwarm::UpdateBatch(void* context, size_t begin, size_t end)
+	{
+		GhostSwarm* swarm = static_cast<GhostSwarm*>(context);
+		for (size_t i = begin; i < end; ++i)
+			swarm->UpdateGhost(i);
+	}
+
+	// Advances the mode and movement of one ghost. Only writes to that ghost's slots.
+	// Params:
+	//   i = The index of the ghost.
+	void GhostSwarm::UpdateGhost(size_t i)
+	{
+		// Frightened mode ends early once the last wave starts.
+		if (frightTimers[i] <= 0.0f || waves[i] == SwarmWaveCount - 1)
+		{
+			frightTimers[i] = 0.0f;
+			modes[i] = waves[i] % 2 == 0 ? SCATTER : CHASE;
+			speeds[i] = speed;
+
+			// Switch between scatter and chase when the wave is over.
+			waveTimers[i] += stepTime;
+			if (SwarmWaveTime[waves[i]] >= 0.0f && waveTimers[i] >= SwarmWaveTime[waves[i]])
+			{
+				modes[i] = modes[i] == CHASE ? SCATTER : CHASE;
+				forceReverse[i] = 1;
+				waveTimers[i] = 0.0f;
+				++waves[i];
+			}
+		}
+		else
+		{
+			frightTimers[i] -= stepTime;
+		}
+
+		tileProgress[i] += stepTime * speeds[i];
+
+		// Check if we have reached the end of this movement.
+		if (tileProgress[i] <= 1.0f)
+			return;
+
+		const TileCoord tile = newTiles[i];
+		if (mazeGraph->IsInside(tile.x, tile.y))
+		{
+			const unsigned direction = ChooseDirection(i);
+			directions[i] = static_cast<unsigned char>(direction);
+			oldTiles[i] = tile;
+
+			if (mazeGraph->IsEmpty(tile.x, tile.y, direction))
+			{
+				newTiles[i] = tile + TileCoord(DirectionOffsetX[direction], DirectionOffsetY[direction]);
+				tileProgress[i] -= 1.0f;
+			}
+			else
+			{
+				tileProgress[i] = 1.0f;
+			}
+		}
+		// If the current coordinate is outside the map, wrap around to the opposite edge.
+		else
+		{
+			TileCoord oldTile = newTiles[i];
+			TileCoord newTile = oldTiles[i];
+
+			const int width = static_cast<int>(tilemap->GetWidth());
+			const int height = static_cast<int>(tilemap->GetHeight());
+			if (DirectionOffsetX[directions[i]] == 0)
+			{
+				oldTile.y = height - oldTile.y - 1;
+				newTile.y = height - newTile.y - 1;
+			}
+			else
+			{
+				oldTile.x = width - oldTile.x - 1;
+				newTile.x = width - newTile.x - 1;
+			}
+
+			oldTiles[i] = oldTile;
+			newTiles[i] = newTile;
+			tileProgress[i] -= 1.0f;
+		}
+	}
+
+	// Chooses the direction of a ghost that has just reached the center of a tile inside the maze.
+	// Params:
+	//   i = The index of the ghost.
+	// Returns:
+	//   The new direction, numbered up, left, down, right.
+	unsigned GhostSwarm::ChooseDirection(size_t i)
+	{
+		const TileCoord tile = newTiles[i];
+		const unsigned reverse = (directions[i] + 2) % 4;
+
+		if (forceReverse[i])
+		{
+			forceReverse[i] = 0;
+			return reverse;
+		}
+
+		// Frightened ghosts pick a random open direction that is not backwards.
+		if (modes[i] == FRIGHTENED)
+		{
+			unsigned exits[4];
+			unsigned exitCount = 0;
+			for (unsigned direction = 0; direction < 4; ++direction)
+			{
+				if (direction != reverse && mazeGraph->IsEmpty(tile.x, tile.y, direction))
+					exits[exitCount++] = direction;
+			}
+
+			// Turn around at a dead end.
+			return exitCount != 0 ? exits[randomStreams[i].NextBelow(exitCount)] : reverse;
+		}
+
+		Vector2D target;
+		const GhostTargeting::Ghost ghost = static_cast<GhostTargeting::Ghost>(ghosts[i]);
+		if (modes[i] == SCATTER)
+			target = scatterTargets[ghost];
+		else
+			target = GhostTargeting::GetChaseTarget(ghost, playerState, tile.ToVector2D(), tileSnapshot[partners[i]].ToVector2D(), scatterTargets[ghost]);
+
+		// Choose the open neighbor closest to the target. Ties go to the first direction in the order up, left, down, right.
+		unsigned closest = reverse;
+		float closestDistance = FLT_MAX;
+		for (unsigned direction = 0; direction < 4; ++direction)
+		{
+			if (direction == reverse || !mazeGraph->IsEmpty(tile.x, tile.y, direction))
+				continue;
+
+			const TileCoord neighbor = tile + TileCoord(DirectionOffsetX[direction], DirectionOffsetY[direction]);
+			const float distance = neighbor.ToVector2D().DistanceSquared(target);
+			if (distance < closestDistance)
+			{
+				closestDistance = distance;
+				closest = direction;
+			}
+		}
+
+		return closest;
+	}
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,205 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	GhostSwarm.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		PAC-MAN
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "Component.h" // base class
+
+#include <GameObjectHandle.h>
+#include <TileCoord.h>
+#include <RandomStream.h>
+#include <vector>
+#include "GhostTargeting.h"
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Forward Declarations:
+//------------------------------------------------------------------------------
+
+class Transform;
+class Sprite;
+class Tilemap;
+class SpriteTilemap;
+class MazeGraph;
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+namespace Behaviors
+{
+	// Ghost swarm - Moves thousands of ghosts from a single game object. The state of each ghost is kept
+	//   in flat arrays (one per field) and updated in parallel batches, with the player read once per step.
+	// Ghosts follow the same wave schedule and targeting rules as the ghost components, but always choose
+	//   the neighbor closest to their target in a straight line, and do not collide or use the ghost house.
+	// Every ghost is drawn with the object's sprite, which also draws itself once at the object's transform.
+	class GhostSwarm : public Component
+	{
+	public:
+		//------------------------------------------------------------------------------
+		// Public Functions:
+		//------------------------------------------------------------------------------
+
+		// Default constructor
+		GhostSwarm();
+
+		// Clone a component and return a pointer to the cloned component.
+		// Returns:
+		//   A pointer to a dynamically allocated clone of the component.
+		Component* Clone() const override;
+
+		// Initialize this component (happens at object creation).
+		void Initialize() override;
+
+		// Updates components using a fixed timestep (usually just physics)
+		// Params:
+		//	 dt = A fixed change in time, usually 1/60th of a second.
+		void FixedUpdate(float dt) override;
+
+		// Draws every ghost in the swarm.
+		void Draw() override;
+
+		// Write object data to file
+		// Params:
+		//   parser = The parser that is writing this object to a file.
+		void Serialize(Parser& parser) const override;
+
+		// Read object data from a file
+		// Params:
+		//   parser = The parser that is reading this object's data from a file.
+		void Deserialize(Parser& parser) override;
+
+		// Sets the tilemap used for the grid.
+		// Params:
+		//   tilemap = The tilemap.
+		//   spriteTilemap = The sprite tilemap.
+		//   mazeGraph = The links between the tilemap's cells.
+		void SetTilemap(const Tilemap* tilemap, const SpriteTilemap* spriteTilemap, const MazeGraph* mazeGraph);
+
+		// Reserves room in the arrays so they do not grow during play.
+		// Params:
+		//   count = How many ghosts to reserve room for.
+		void Reserve(size_t count);
+
+		// Adds a ghost to the swarm. Inky ghosts pair with the Blinky added most recently before them.
+		// Params:
+		//   ghost = Which ghost's targeting rule to use.
+		//   tile = The tile to start on.
+		// Returns:
+		//   The index of the new ghost.
+		size_t AddGhost(GhostTargeting::Ghost ghost, TileCoord tile);
+
+		// Removes every ghost from the swarm.
+		void Clear();
+
+		// Gets how many ghosts are in the swarm.
+		size_t GetGhostCount() const;
+
+		// Gets the tile a ghost is moving to.
+		// Params:
+		//   index = The index of the ghost.
+		TileCoord GetTile(size_t index) const;
+
+		// Sets every ghost to the frightened state.
+		void SetFrightened();
+
+	private:
+		//------------------------------------------------------------------------------
+		// Private Enums:
+		//------------------------------------------------------------------------------
+
+		enum Mode
+		{
+			SCATTER = 0,
+			CHASE,
+			FRIGHTENED,
+
+			MODE_MAX
+		};
+
+		//------------------------------------------------------------------------------
+		// Private Functions:
+		//------------------------------------------------------------------------------
+
+		// Updates one batch of ghosts. Called by the thread pool.
+		// Params:
+		//   context = The swarm.
+		//   begin = The first ghost in the batch.
+		//   end = One past the last ghost in the batch.
+		static void UpdateBatch(void* context, size_t begin, size_t end);
+
+		// Advances the mode and movement of one ghost. Only writes to that ghost's slots.
+		// Params:
+		//   i = The index of the ghost.
+		void UpdateGhost(size_t i);
+
+		// Chooses the direction of a ghost that has just reached the center of a tile inside the maze.
+		// Params:
+		//   i = The index of the ghost.
+		// Returns:
+		//   The new direction, numbered up, left, down, right.
+		unsigned ChooseDirection(size_t i);
+
+		//------------------------------------------------------------------------------
+		// Private Variables:
+		//------------------------------------------------------------------------------
+
+		// Components
+		Transform* transform;
+		Sprite* sprite;
+
+		// The grid
+		const Tilemap* tilemap;
+		const SpriteTilemap* spriteTilemap;
+		const MazeGraph* mazeGraph;
+
+		// The player game object.
+		GameObjectHandle player;
+
+		// Each ghost's random stream is split from this one as the ghost is added.
+		RandomStream random;
+
+		// Shared settings
+		float speed;
+		float frightSpeed;
+		float frightenTime;
+		Vector2D scatterTargets[GhostTargeting::GHOST_MAX];
+
+		// State of the current step, written before the ghosts are updated.
+		float stepTime;
+		GhostTargeting::PlayerState playerState;
+
+		// Ghost state, one slot per ghost.
+		std::vector<unsigned char> ghosts;
+		std::vector<unsigned> partners;
+		std::vector<TileCoord> oldTiles;
+		std::vector<TileCoord> newTiles;
+		std::vector<unsigned char> directions;
+		std::vector<float> tileProgress;
+		std::vector<unsigned char> modes;
+		std::vector<unsigned char> waves;
+		std::vector<float> waveTimers;
+		std::vector<float> frightTimers;
+		std::vector<float> speeds;
+		std::vector<unsigned char> forceReverse;
+		std::vector<RandomStream> randomStreams;
+
+		// The tiles at the start of the step, so ghosts can read each other while they move.
+		std::vector<TileCoord> tileSnapshot;
+	};
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,110 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	GhostTargeting.cpp
+// Author(s):	A.J. Bussman (anthony.bussman)
+// Project:		PAC-MAN
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "GhostTargeting.h"
+
+const float MaxDistanceSqrd = 64.0f;
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+namespace GhostTargeting
+{
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Blinky chases the player directly.
+	// Params:
+	//   player = The player's state.
+	// Returns:
+	//   The tile Blinky should move towards.
+	Vector2D GetBlinkyTarget(const PlayerState& player)
+	{
+		return player.tile;
+	}
+
+	// Pinky aims 4 tiles ahead of the player.
+	// Params:
+	//   player = The player's state.
+	// Returns:
+	//   The tile Pinky should move towards.
+	Vector2D GetPinkyTarget(const PlayerState& player)
+	{
+		return player.tile + player.ahead4;
+	}
+
+	// Inky aims at Blinky's position mirrored around the tile 2 ahead of the player.
+	// Params:
+	//   player = The player's state.
+	//   blinkyTile = The tile Blinky is on.
+	// Returns:
+	//   The tile Inky should move towards.
+	Vector2D GetInkyTarget(const PlayerState& player, const Vector2D& blinkyTile)
+	{
+		// Get Vector from Blinky to two tiles infront of PAC-MAN
+		Vector2D blinkyPP2Vec = player.tile + player.ahead2 - blinkyTile;
+		// Target twice the vector blinkyPP2Vec
+		return blinkyTile + 2 * blinkyPP2Vec;
+	}
+
+	// Clyde chases the player while more than 8 tiles away, and retreats to its scatter target otherwise.
+	// Params:
+	//   player = The player's state.
+	//   clydeTile = The tile Clyde is on.
+	//   scatterTarget = Clyde's scatter target.
+	// Returns:
+	//   The tile Clyde should move towards.
+	Vector2D GetClydeTarget(const PlayerState& player, const Vector2D& clydeTile, const Vector2D& scatterTarget)
+	{
+		// If Clyde is further than 8 tiles from PAC-MAN 
+		if (clydeTile.DistanceSquared(player.tile) >= MaxDistanceSqrd)
+			return player.tile;
+		else
+			return scatterTarget;
+	}
+
+	// Gets the chase target of any ghost.
+	// Params:
+	//   ghost = Which ghost's rule to use.
+	//   player = The player's state.
+	//   ghostTile = The tile the ghost is on.
+	//   blinkyTile = The tile of the Blinky that Inky pairs with.
+	//   scatterTarget = The ghost's scatter target.
+	// Returns:
+	//   The tile the ghost should move towards.
+	Vector2D GetChaseTarget(Ghost ghost, const PlayerState& player, const Vector2D& ghostTile,
+		const Vector2D& blinkyTile, const Vector2D& scatterTarget)
+	{
+		switch (ghost)
+		{
+		case PINKY:
+			return GetPinkyTarget(player);
+		case INKY:
+			return GetInkyTarget(player, blinkyTile);
+		case CLYDE:
+			return GetClydeTarget(player, ghostTile, scatterTarget);
+		default:
+			return GetBlinkyTarget(player);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,108 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	GhostTargeting.h
+// Author(s):	A.J. Bussman (anthony.bussman)
+// Project:		PAC-MAN
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <Vector2D.h>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// The chase targeting rules of each ghost. They only read the positions passed in, so the
+//   ghost components and the ghost swarm share them, and they are safe to call from any thread.
+// All positions are in tile space.
+namespace GhostTargeting
+{
+	//------------------------------------------------------------------------------
+	// Public Enums:
+	//------------------------------------------------------------------------------
+
+	enum Ghost
+	{
+		BLINKY = 0,
+		PINKY,
+		INKY,
+		CLYDE,
+
+		GHOST_MAX
+	};
+
+	//------------------------------------------------------------------------------
+	// Public Structures:
+	//------------------------------------------------------------------------------
+
+	// The player's state that the targeting rules read, gathered once per update.
+	struct PlayerState
+	{
+		// The tile the player is on.
+		Vector2D tile;
+
+		// The player's direction vector scaled by 2 and by 4, including the original game's overflow bug.
+		Vector2D ahead2;
+		Vector2D ahead4;
+	};
+
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Blinky chases the player directly.
+	// Params:
+	//   player = The player's state.
+	// Returns:
+	//   The tile Blinky should move towards.
+	Vector2D GetBlinkyTarget(const PlayerState& player);
+
+	// Pinky aims 4 tiles ahead of the player.
+	// Params:
+	//   player = The player's state.
+	// Returns:
+	//   The tile Pinky should move towards.
+	Vector2D GetPinkyTarget(const PlayerState& player);
+
+	// Inky aims at Blinky's position mirrored around the tile 2 ahead of the player.
+	// Params:
+	//   player = The player's state.
+	//   blinkyTile = The tile Blinky is on.
+	// Returns:
+	//   The tile Inky should move towards.
+	Vector2D GetInkyTarget(const PlayerState& player, const Vector2D& blinkyTile);
+
+	// Clyde chases the player while more than 8 tiles away, and retreats to its scatter target otherwise.
+	// Params:
+	//   player = The player's state.
+	//   clydeTile = The tile Clyde is on.
+	//   scatterTarget = Clyde's scatter target.
+	// Returns:
+	//   The tile Clyde should move towards.
+	Vector2D GetClydeTarget(const PlayerState& player, const Vector2D& clydeTile, const Vector2D& scatterTarget);
+
+	// Gets the chase target of any ghost.
+	// Params:
+	//   ghost = Which ghost's rule to use.
+	//   player = The player's state.
+	//   ghostTile = The tile the ghost is on.
+	//   blinkyTile = The tile of the Blinky that Inky pairs with.
+	//   scatterTarget = The ghost's scatter target.
+	// Returns:
+	//   The tile the ghost should move towards.
+	Vector2D GetChaseTarget(Ghost ghost, const PlayerState& player, const Vector2D& ghostTile,
+		const Vector2D& blinkyTile, const Vector2D& scatterTarget);
+}
+
+//------------------------------------------------------------------------------
@@ -22,6 +22,10 @@
 #include <Interpolation.h>
 #include <GameObject.h>
 #include <Tilemap.h>
+#include <TilemapStreamer.h>
+#include <Space.h>
+#include <TileOccupancyMap.h>
+#include "MazeGraph.h"
 
 // Components
 #include <Transform.h>
@@ -43,18 +47,36 @@ namespace Behaviors
 	// Params:
 	//   speed = How fast the game object moves between tiles.
 	GridMovement::GridMovement(float speed) : Component("GridMovement"), direction(UP),
-		speed(speed), transform(nullptr), tilemap(nullptr), spriteTilemap(nullptr), tileProgress(0.0f), frozen(false), oldTile(), newTile()
+		speed(speed), transform(nullptr), tilemap(nullptr), spriteTilemap(nullptr), mazeGraph(nullptr),
+		tileProgress(0.0f), frozen(false), isPlayer(false), oldTile(), newTile(), oldPosition(), newPosition(),
+		occupancyPlaced(false), occupancyX(0), occupancyY(0)
 	{
 	}
 
+	// Destructor
+	GridMovement::~GridMovement()
+	{
+		// Take the owner off of its tile so the map never holds deleted objects.
+		if (occupancyPlaced)
+			GetOwner()->GetSpace()->GetTileOccupancy().Remove(*GetOwner());
+	}
+
 	// Initialize this component (happens at object creation).
 	void GridMovement::Initialize()
 	{
 		// Store the required components for ease of access.
 		transform = GetOwner()->GetComponent<Transform>();
 
+		// Only the player is kept out of the ghost house.
+		isPlayer = GetOwner()->GetName() == "PAC-MAN";
+
 		Vector2D tileSpace = spriteTilemap->WorldToTile(transform->GetTranslation());
-		oldTile = newTile = Vector2D(tileSpace.x, tileSpace.y);
+		oldTile = newTile = TileCoord::Floor(tileSpace);
+		oldPosition = newPosition = tileSpace;
+
+		// Clones start out unplaced, even if the original was on a tile.
+		occupancyPlaced = false;
+		UpdateTileOccupancy(tileSpace);
 	}
 
 	// Updates components using a fixed timestep (usually just physics)
@@ -70,9 +92,7 @@ namespace Behaviors
 		// Check if we have reached the end of this movement.
 		if (tileProgress > 1.0f)
 		{
-			bool currentTileValid;
-			GetCellValue(newTile, currentTileValid);
-			if (currentTileValid)
+			if (mazeGraph->IsInside(newTile.x, newTile.y))
 			{
 				AdjacentTile adjacentTiles[4];
 				size_t emptyCount;
@@ -85,45 +105,18 @@ namespace Behaviors
 				// Give child class a chance to update direction when we have reached the end of a move.
 				OnTileMove(adjacentTiles, emptyCount);
 
-				oldTile = Vector2D(newTile.x, newTile.y);
+				oldTile = newTile;
+				oldPosition = newPosition;
 
-				// Calculate the new tile based on the target direction.
-				switch (direction)
-				{
-				case UP:
-					newTile = oldTile + Vector2D(0.0f, -1.0f);
-					break;
-				case LEFT:
-					newTile = oldTile + Vector2D(-1.0f, 0.0f);
-					break;
-				case DOWN:
-					newTile = oldTile + Vector2D(0.0f, 1.0f);
-					break;
-				case RIGHT:
-					newTile = oldTile + Vector2D(1.0f, 0.0f);
-					break;
-				}
-
-				// If the tile in the target direction is not empty, cancel the movement.
-				bool isPlayer = GetOwner()->GetName() == "PAC-MAN";
-				bool newTileValid;
-				int cellValue = GetCellValue(newTile, newTileValid);
-				if (cellValue > 0 && !(!isPlayer && cellValue == 31))
-				{
-					newTile = oldTile;
-				}
-				else
-				{
-					// Round tiles.
-					newTile = Vector2D(floor(newTile.x), floor(newTile.y));
-				}
-
-				// If a new tile has been chosen, subtract 1 from tile movement progress so that we interpolate the correct amount.
-				if (!AlmostEqual(oldTile, newTile))
+				// If the tile in the target direction is empty, move onto it and subtract 1 from tile movement
+				//   progress so that we interpolate the correct amount.
+				if (isPlayer ? mazeGraph->IsEmpty(oldTile.x, oldTile.y, direction) : mazeGraph->IsGhostPassable(oldTile.x, oldTile.y, direction))
 				{
+					newTile = oldTile + GetDirectionOffset(direction);
+					newPosition = newTile.ToVector2D();
 					tileProgress -= 1.0f;
 				}
-				// If the tile is the same (nowhere to go) clamp tile movement progress to 1.
+				// If the tile is not empty (nowhere to go) clamp tile movement progress to 1.
 				else
 				{
 					tileProgress = 1.0f;
@@ -138,19 +131,26 @@ namespace Behaviors
 				// tile is closer to the center)
 
 				std::swap(oldTile, newTile);
-				
+				std::swap(oldPosition, newPosition);
+
 				// Mirror the coordinates around the axis we are moving.
+				const int width = static_cast<int>(tilemap->GetWidth());
+				const int height = static_cast<int>(tilemap->GetHeight());
 				switch (direction)
 				{
 				case UP:
 				case DOWN:
-					newTile = Vector2D(newTile.x, tilemap->GetHeight() - newTile.y - 1);
-					oldTile = Vector2D(oldTile.x, tilemap->GetHeight() - oldTile.y - 1);
+					newTile.y = height - newTile.y - 1;
+					oldTile.y = height - oldTile.y - 1;
+					newPosition.y = height - newPosition.y - 1;
+					oldPosition.y = height - oldPosition.y - 1;
 					break;
 				case LEFT:
 				case RIGHT:
-					newTile = Vector2D(tilemap->GetWidth() - newTile.x - 1, newTile.y);
-					oldTile = Vector2D(tilemap->GetWidth() - oldTile.x - 1, oldTile.y);
+					newTile.x = width - newTile.x - 1;
+					oldTile.x = width - oldTile.x - 1;
+					newPosition.x = width - newPosition.x - 1;
+					oldPosition.x = width - oldPosition.x - 1;
 					break;
 				}
 
@@ -159,9 +159,19 @@ namespace Behaviors
 		}
 
 		// Linearly interpolate from the old tile to the new tile based on how much tile movement progress we have.
-		Vector2D tileSpace = Interpolate(oldTile, newTile, std::min(1.0f, tileProgress));
+		Vector2D tileSpace = Interpolate(oldPosition, newPosition, std::min(1.0f, tileProgress));
 		Vector2D worldSpace = spriteTilemap->TileToWorld(tileSpace);
 		transform->SetTranslation(worldSpace);
+
+		UpdateTileOccupancy(tileSpace);
+
+		// Keep the tiles around the object loaded if the map is streamed, even when it is off the screen.
+		TilemapStreamer* streamer = tilemap->GetStreamer();
+		if (streamer != nullptr)
+		{
+			const int focusRadius = 8;
+			streamer->AddFocus(newTile.x - focusRadius, newTile.y - focusRadius, newTile.x + focusRadius, newTile.y + focusRadius);
+		}
 	}
 
 	// Write object data to file
@@ -208,10 +218,12 @@ namespace Behaviors
 	// Params:
 	//   tilemap = The tilemap.
 	//   spriteTilemap = The sprite tilemap.
-	void GridMovement::SetTilemap(Tilemap* tilemap_, SpriteTilemap* spriteTilemap_)
+	//   mazeGraph = The links between the tilemap's cells.
+	void GridMovement::SetTilemap(Tilemap* tilemap_, SpriteTilemap* spriteTilemap_, const MazeGraph* mazeGraph_)
 	{
 		tilemap = tilemap_;
 		spriteTilemap = spriteTilemap_;
+		mazeGraph = mazeGraph_;
 	}
 
 	// Gets a vector in the direction this game object is facing.
@@ -261,13 +273,13 @@ namespace Behaviors
 	//------------------------------------------------------------------------------
 
 	// Gets the old tile.
-	Vector2D GridMovement::GetOldTile() const
+	TileCoord GridMovement::GetOldTile() const
 	{
 		return oldTile;
 	}
 
 	// Gets the new tile.
-	Vector2D GridMovement::GetNewTile() const
+	TileCoord GridMovement::GetNewTile() const
 	{
 		return newTile;
 	}
@@ -290,23 +302,45 @@ namespace Behaviors
 		return spriteTilemap;
 	}
 
+	// Gets the links between the tilemap's cells.
+	const MazeGraph* GridMovement::GetMazeGraph() const
+	{
+		return mazeGraph;
+	}
+
 	// Fills out a Vector2D array with all adjacent tile coordinates.
 	// Params:
 	//   tiles = The array of tiles. Must have a size of 4!
 	//   emptyCount = How many empty tiles were found.
 	void GridMovement::GetAdjacentTiles(AdjacentTile tiles[4], size_t& emptyCount)
 	{
+		// Read the neighbors of tiles inside the maze straight from the graph.
+		if (mazeGraph->IsInside(newTile.x, newTile.y))
+		{
+			for (size_t i = 0; i < 4; i++)
+			{
+				const Direction tileDirection = static_cast<Direction>(i);
+				tiles[i].pos = newTile + GetDirectionOffset(tileDirection);
+				tiles[i].edge = mazeGraph->IsEdge(newTile.x, newTile.y, tileDirection);
+				tiles[i].empty = mazeGraph->IsEmpty(newTile.x, newTile.y, tileDirection);
+				tiles[i].direction = tileDirection;
+			}
+
+			emptyCount = mazeGraph->GetEmptyCount(newTile.x, newTile.y);
+			return;
+		}
+
 		// Check tile above.
-		tiles[0] = GetAdjacentTile(Vector2D(newTile.x, newTile.y - 1), UP);
+		tiles[0] = GetAdjacentTile(newTile + GetDirectionOffset(UP), UP);
 
 		// Check tile to the left.
-		tiles[1] = GetAdjacentTile(Vector2D(newTile.x - 1, newTile.y), LEFT);
+		tiles[1] = GetAdjacentTile(newTile + GetDirectionOffset(LEFT), LEFT);
 
 		// Check tile below.
-		tiles[2] = GetAdjacentTile(Vector2D(newTile.x, newTile.y + 1), DOWN);
+		tiles[2] = GetAdjacentTile(newTile + GetDirectionOffset(DOWN), DOWN);
 
 		// Check tile to the right.
-		tiles[3] = GetAdjacentTile(Vector2D(newTile.x + 1, newTile.y), RIGHT);
+		tiles[3] = GetAdjacentTile(newTile + GetDirectionOffset(RIGHT), RIGHT);
 
 		// Count the number of empty tiles.
 		emptyCount = 0;
@@ -321,7 +355,7 @@ namespace Behaviors
 	//   direction = The direction to move to get to this tile.
 	// Returns:
 	//   The filled out AdjacentTile struct.
-	GridMovement::AdjacentTile GridMovement::GetAdjacentTile(Vector2D pos, Direction direction_)
+	GridMovement::AdjacentTile GridMovement::GetAdjacentTile(TileCoord pos, Direction direction_)
 	{
 		AdjacentTile tile = { pos, true, true, direction_ };
 		bool valid;
@@ -336,9 +370,9 @@ namespace Behaviors
 	//   valid = Whether the coordinate was valid or not.
 	// Returns:
 	//   The cell value at the specified coordinate. If the coordinate was not valid, returns 0.
-	int GridMovement::GetCellValue(Vector2D pos, bool& valid)
+	int GridMovement::GetCellValue(TileCoord pos, bool& valid)
 	{
-		if (pos.x >= 0 && pos.y >= 0 && pos.x < tilemap->GetWidth() && pos.y < tilemap->GetHeight())
+		if (mazeGraph->IsInside(pos.x, pos.y))
 		{
 			valid = true;
 			return tilemap->GetCellValue(static_cast<unsigned>(pos.x), static_cast<unsigned>(pos.y));
@@ -349,6 +383,48 @@ namespace Behaviors
 			return 0;
 		}
 	}
+
+	//------------------------------------------------------------------------------
+	// Private Functions:
+	//------------------------------------------------------------------------------
+
+	// Gets the offset to the neighboring tile in a direction.
+	// Params:
+	//   direction = The direction of the neighbor.
+	TileCoord GridMovement::GetDirectionOffset(Direction direction_)
+	{
+		switch (direction_)
+		{
+		case UP:
+			return TileCoord(0, -1);
+		case LEFT:
+			return TileCoord(-1, 0);
+		case DOWN:
+			return TileCoord(0, 1);
+		case RIGHT:
+			return TileCoord(1, 0);
+		default:
+			return TileCoord();
+		}
+	}
+
+	// Moves the game object to the nearest tile in the space's tile occupancy map, if it has changed tiles.
+	// Params:
+	//   tileSpace = The game object's current position in tile space.
+	void GridMovement::UpdateTileOccupancy(const Vector2D& tileSpace)
+	{
+		int x = static_cast<int>(floor(tileSpace.x + 0.5f));
+		int y = static_cast<int>(floor(tileSpace.y + 0.5f));
+
+		// Most steps are spent between two tiles, so only touch the map when the nearest tile changes.
+		if (occupancyPlaced && x == occupancyX && y == occupancyY)
+			return;
+
+		GetOwner()->GetSpace()->GetTileOccupancy().Place(*GetOwner(), x, y);
+		occupancyPlaced = true;
+		occupancyX = x;
+		occupancyY = y;
+	}
 }
 
 //------------------------------------------------------------------------------
@@ -17,6 +17,7 @@
 
 #include "Component.h" // base class
 #include <Vector2D.h>
+#include <TileCoord.h>
 
 //------------------------------------------------------------------------------
 
@@ -27,6 +28,7 @@
 class Transform;
 class Tilemap;
 class SpriteTilemap;
+class MazeGraph;
 
 //------------------------------------------------------------------------------
 // Public Structures:
@@ -47,6 +49,9 @@ namespace Behaviors
 		//   speed = How fast the game object moves between tiles.
 		GridMovement(float speed = 4.0f);
 
+		// Destructor
+		~GridMovement();
+
 		// Initialize this component (happens at object creation).
 		void Initialize() override;
 
@@ -81,7 +86,8 @@ namespace Behaviors
 		// Params:
 		//   tilemap = The tilemap.
 		//   spriteTilemap = The sprite tilemap.
-		void SetTilemap(Tilemap* tilemap, SpriteTilemap* spriteTilemap);
+		//   mazeGraph = The links between the tilemap's cells.
+		void SetTilemap(Tilemap* tilemap, SpriteTilemap* spriteTilemap, const MazeGraph* mazeGraph);
 
 		// Gets a vector in the direction this game object is facing.
 		// This function calculates the vector in such a way that it
@@ -117,7 +123,7 @@ namespace Behaviors
 		struct AdjacentTile
 		{
 			// The tile's coordinate.
-			Vector2D pos;
+			TileCoord pos;
 
 			// Whether this tile is off the edge of the screen.
 			bool edge;
@@ -134,10 +140,10 @@ namespace Behaviors
 		//------------------------------------------------------------------------------
 
 		// Gets the old tile.
-		Vector2D GetOldTile() const;
+		TileCoord GetOldTile() const;
 
 		// Gets the new tile.
-		Vector2D GetNewTile() const;
+		TileCoord GetNewTile() const;
 
 		// Gets the transform (constant).
 		const Transform* GetTransform() const;
@@ -148,6 +154,9 @@ namespace Behaviors
 		// Gets the sprite tilemap (constant).
 		const SpriteTilemap* GetSpriteTilemap() const;
 
+		// Gets the links between the tilemap's cells.
+		const MazeGraph* GetMazeGraph() const;
+
 		// Fills out a Vector2D array with all adjacent tile coordinates.
 		// Params:
 		//   tiles = The array of tiles. Must have a size of 4!
@@ -160,7 +169,7 @@ namespace Behaviors
 		//   direction = The direction to move to get to this tile.
 		// Returns:
 		//   The filled out AdjacentTile struct.
-		AdjacentTile GetAdjacentTile(Vector2D pos, Direction direction);
+		AdjacentTile GetAdjacentTile(TileCoord pos, Direction direction);
 
 		// Helper function to get the cell value at the specified coordinate. If the coordinate was not valid, it returns 0.
 		// Params:
@@ -168,7 +177,7 @@ namespace Behaviors
 		//   valid = Whether the coordinate was valid or not.
 		// Returns:
 		//   The cell value at the specified coordinate. If the coordinate was not valid, returns 0.
-		int GetCellValue(Vector2D pos, bool& valid);
+		int GetCellValue(TileCoord pos, bool& valid);
 
 		// Called when finished moving to the next tile.
 		// Params:
@@ -190,6 +199,20 @@ namespace Behaviors
 		Direction direction;
 
 	private:
+		//------------------------------------------------------------------------------
+		// Private Functions:
+		//------------------------------------------------------------------------------
+
+		// Gets the offset to the neighboring tile in a direction.
+		// Params:
+		//   direction = The direction of the neighbor.
+		static TileCoord GetDirectionOffset(Direction direction);
+
+		// Moves the game object to the nearest tile in the space's tile occupancy map, if it has changed tiles.
+		// Params:
+		//   tileSpace = The game object's current position in tile space.
+		void UpdateTileOccupancy(const Vector2D& tileSpace);
+
 		//------------------------------------------------------------------------------
 		// Private Variables:
 		//------------------------------------------------------------------------------
@@ -203,12 +226,24 @@ namespace Behaviors
 		// The tilemap used for the grid.
 		Tilemap* tilemap;
 		SpriteTilemap* spriteTilemap;
+		const MazeGraph* mazeGraph;
 
 		// Other variables
 		float tileProgress;
 		bool frozen;
-		Vector2D oldTile;
-		Vector2D newTile;
+		bool isPlayer;
+		TileCoord oldTile;
+		TileCoord newTile;
+
+		// Where the old and new tiles are drawn, in tile space. These only differ from the tiles
+		//   when the object starts between two tiles, until it reaches its first whole tile.
+		Vector2D oldPosition;
+		Vector2D newPosition;
+
+		// The tile the game object occupies in the space's tile occupancy map.
+		bool occupancyPlaced;
+		int occupancyX;
+		int occupancyY;
 	};
 }
 
@@ -39,7 +39,7 @@ namespace Behaviors
 	//------------------------------------------------------------------------------
 
 	// Default constructor
-	InkyAI::InkyAI() : BaseAI(30), blinky(nullptr)
+	InkyAI::InkyAI() : BaseAI(30), blinky()
 	{
 	}
 
@@ -56,7 +56,8 @@ namespace Behaviors
 	{
 		BaseAI::Initialize();
 		
-		blinky = GetOwner()->GetSpace()->GetObjectManager().GetObjectByName("Blinky");
+		GameObject* blinkyObject = GetOwner()->GetSpace()->GetObjectManager().GetObjectByName("Blinky");
+		blinky = blinkyObject != nullptr ? blinkyObject->GetHandle() : GameObjectHandle();
 	}
 
 	//------------------------------------------------------------------------------
@@ -72,12 +73,13 @@ namespace Behaviors
 		UNREFERENCED_PARAMETER(adjacentTiles);
 		UNREFERENCED_PARAMETER(emptyCount);
 
-		// Get two tiles infornt of PAC-MAN
-		Vector2D pacmanPlus2 = GetSpriteTilemap()->WorldToTile(player->GetComponent<Transform>()->GetTranslation()) + player->GetComponent<GridMovement>()->GetDirectionVector(2);
-		// Get Vector from Blinky to two tiles infront of PAC-MAN
-		Vector2D blinkyPos = GetSpriteTilemap()->WorldToTile(blinky->GetComponent<Transform>()->GetTranslation());
-		Vector2D blinkyPP2Vec = pacmanPlus2 - blinkyPos;
-		// Set target to twice the vector blinkyPP2Vec
-		target = blinkyPos + 2 * blinkyPP2Vec;
+		// Keep the old target if either object is gone.
+		GameObject* playerObject = GetPlayer();
+		GameObject* blinkyObject = GetOwner()->GetSpace()->GetObjectManager().GetObjectByHandle(blinky);
+		if (playerObject == nullptr || blinkyObject == nullptr)
+			return;
+
+		Vector2D blinkyPos = GetSpriteTilemap()->WorldToTile(blinkyObject->GetComponent<Transform>()->GetTranslation());
+		target = GhostTargeting::GetInkyTarget(GetPlayerState(*playerObject), blinkyPos);
 	}
 }
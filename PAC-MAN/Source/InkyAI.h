@@ -60,6 +60,6 @@ namespace Behaviors
 		//------------------------------------------------------------------------------
 
 		// The Blinky game object.
-		GameObject* blinky;
+		GameObjectHandle blinky;
 	};
 }
@@ -30,8 +30,9 @@
 #include <Mesh.h>
 #include <GameObjectFactory.h>
 #include <Tilemap.h>
+#include "MazeGraph.h"
 #include <MeshHelper.h>
-#include <Random.h>
+#include <PhysicsStorage.h>
 
 // Components
 #include <Transform.h>
@@ -43,6 +44,7 @@
 #include "PlayerScore.h"
 #include "PlayerCollision.h"
 #include "PlayerAnimation.h"
+#include "Tags.h"
 #include <SpriteText.h>
 
 // Levels
@@ -62,13 +64,13 @@ namespace Levels
 
 	// Creates an instance of Level 2.
 	Level2::Level2() : Level("Level2"),
-		columnsMap(8), rowsMap(5), columnsEnergizer(4), columnsDot(2), rowsDot(1), rowsEnergizer(1), columnsPacMan(4), rowsPacMan(4), columnsGhost(5), rowsGhost(5),
+		columnsMap(8), rowsMap(5), streamingCellCount(4096 * 4096), columnsEnergizer(4), columnsDot(2), rowsDot(1), rowsEnergizer(1), columnsPacMan(4), rowsPacMan(4), columnsGhost(5), rowsGhost(5),
 		musicTimer(0.0f), musicPlayed(false), musicIntroPlayed(false), readyTimer(0.0f), winTimer(0.0f),
 		gameOver(false), startLives(3), lives(0), oldScore(0), oldDots(0), highScore(0),
 		kingGhostWave(0), kingGhostWaveTimer(0.0f),
 		fruitSpawnAmount(0), fruitDeathTimer(0), fruitAlive(false),
 		soundManager(nullptr), energizerPositions(), dotPositions(),
-		readyText(nullptr), scoreText(nullptr), pacMan(nullptr), fruit(nullptr)
+		readyText(), scoreText(), highScoreText(), pacMan(), fruit()
 	{
 	}
 
@@ -134,14 +136,32 @@ namespace Levels
 		objectManager.AddArchetype(*objectFactory.CreateObject("Bonus1600", resourceManager.GetMesh("Quad"), resourceManager.GetSpriteSource("Bonus1600.png")));
 		objectManager.AddArchetype(*objectFactory.CreateObject("Life", resourceManager.GetMesh("Quad"), resourceManager.GetSpriteSource("PacManIcon.png")));
 
-		// Load the tilemap.
-		dataMap = Tilemap::CreateTilemapFromFile("Assets/Levels/Level1.txt");
+		// Fill the pools of objects that are spawned and destroyed often, so they are not cloned during play.
+		objectManager.WarmPool("Dot", 240);
+		objectManager.WarmPool("Energizer", 4);
+		objectManager.WarmPool("Fruit", 1);
+		objectManager.WarmPool("Bonus100", 1);
+		objectManager.WarmPool("Bonus200", 1);
+		objectManager.WarmPool("Bonus400", 1);
+		objectManager.WarmPool("Bonus800", 1);
+		objectManager.WarmPool("Bonus1600", 1);
+
+		// Keep transforms and bodies in contiguous arrays. Reserve room for every dot plus the actors so the arrays never grow mid-frame.
+		objectManager.SetPhysicsStorage(true);
+		objectManager.GetPhysicsStorage()->Reserve(512, 32);
+
+		// Load the tilemap. Maps too large to keep in memory are streamed in chunks around the camera and actors.
+		dataMap = Tilemap::CreateTilemapFromFile("Assets/Levels/Level1.txt", streamingCellCount);
 		if (dataMap == nullptr)
 		{
 			std::cout << "Error loading map!" << std::endl;
+			mazeGraph = nullptr;
 		}
 		else
 		{
+			// Link the cells once, so moving between tiles is a table lookup.
+			mazeGraph = new MazeGraph(*dataMap);
+
 			// Create a new quad mesh for the sprite tilemap.
 			resourceManager.GetMesh("Map", columnsMap, rowsMap);
 
@@ -168,6 +188,10 @@ namespace Levels
 	{
 		GameObjectManager& objectManager = GetSpace()->GetObjectManager();
 
+		// A full board has under 250 dots and energizers. The rest covers the actors, HUD and score popups,
+		//   so the hundreds of adds below never reallocate the object lists.
+		objectManager.Reserve(320);
+
 		// Check if there are any lives remaining.
 		gameOver = lives == 0;
 
@@ -177,6 +201,16 @@ namespace Levels
 
 		SpriteTilemap* spriteTilemap = tilemap->GetComponent<SpriteTilemap>();
 
+		// Let objects find their tiles in the occupancy map.
+		GetSpace()->GetTileOccupancy().SetSpriteTilemap(spriteTilemap);
+
+		// Let ghosts share the way to each target. The tunnels wrap around the edges of the maze.
+		GetSpace()->GetFlowFields().SetTilemap(dataMap, true);
+
+		// Update the streamer of a streamed map every frame. Maps loaded whole are ignored.
+		if (dataMap != nullptr)
+			GetSpace()->AddStreamingTilemap(*dataMap);
+
 		if (lives == startLives)
 		{
 			// Place energizers and dots.
@@ -184,48 +218,54 @@ namespace Levels
 		}
 
 		// Add various HUD elements.
-		readyText = new GameObject(*objectManager.GetArchetypeByName("HUDText"));
-		readyText->GetComponent<Transform>()->SetTranslation(spriteTilemap->TileToWorld(Vector2D(14.0f, 17.25f)));
-		readyText->GetComponent<SpriteText>()->SetColor(Colors::Yellow);
-		readyText->GetComponent<SpriteText>()->SetHorizontalAlignment(SpriteText::Alignment::CENTER);
-		readyText->GetComponent<SpriteText>()->SetText("READY!");
-		objectManager.AddObject(*readyText);
+		GameObject* readyTextObject = new GameObject(*objectManager.GetArchetypeByName("HUDText"));
+		readyTextObject->GetComponent<Transform>()->SetTranslation(spriteTilemap->TileToWorld(Vector2D(14.0f, 17.25f)));
+		readyTextObject->GetComponent<SpriteText>()->SetColor(Colors::Yellow);
+		readyTextObject->GetComponent<SpriteText>()->SetHorizontalAlignment(SpriteText::Alignment::CENTER);
+		readyTextObject->GetComponent<SpriteText>()->SetText("READY!");
+		objectManager.AddObject(*readyTextObject);
+		readyText = readyTextObject->GetHandle();
 		readyTimer = 4.0f;
 
-		scoreText = new GameObject(*objectManager.GetArchetypeByName("HUDText"));
-		scoreText->GetComponent<Transform>()->SetTranslation(spriteTilemap->TileToWorld(Vector2D(6.75f, -1.5f)));
-		scoreText->GetComponent<SpriteText>()->SetText(std::to_string(oldScore).c_str());
-		objectManager.AddObject(*scoreText);
+		GameObject* scoreTextObject = new GameObject(*objectManager.GetArchetypeByName("HUDText"));
+		scoreTextObject->GetComponent<Transform>()->SetTranslation(spriteTilemap->TileToWorld(Vector2D(6.75f, -1.5f)));
+		scoreTextObject->GetComponent<SpriteText>()->SetText(std::to_string(oldScore).c_str());
+		objectManager.AddObject(*scoreTextObject);
+		scoreText = scoreTextObject->GetHandle();
 
-		highScoreText = new GameObject(*objectManager.GetArchetypeByName("HUDText"));
-		highScoreText->GetComponent<Transform>()->SetTranslation(spriteTilemap->TileToWorld(Vector2D(16.75f, -1.5f)));
-		highScoreText->GetComponent<SpriteText>()->SetText(std::to_string(oldScore).c_str());
-		objectManager.AddObject(*highScoreText);
+		GameObject* highScoreTextObject = new GameObject(*objectManager.GetArchetypeByName("HUDText"));
+		highScoreTextObject->GetComponent<Transform>()->SetTranslation(spriteTilemap->TileToWorld(Vector2D(16.75f, -1.5f)));
+		highScoreTextObject->GetComponent<SpriteText>()->SetText(std::to_string(oldScore).c_str());
+		objectManager.AddObject(*highScoreTextObject);
+		highScoreText = highScoreTextObject->GetHandle();
 
 		GameObject* highScoreLabelText = new GameObject(*objectManager.GetArchetypeByName("HUDText"));
 		highScoreLabelText->GetComponent<Transform>()->SetTranslation(spriteTilemap->TileToWorld(Vector2D(18.75f, -2.5f)));
 		highScoreLabelText->GetComponent<SpriteText>()->SetText("HIGH SCORE");
 		objectManager.AddObject(*highScoreLabelText);
 
-		lifeIcons[0] = new GameObject(*objectManager.GetArchetypeByName("Life"));
-		lifeIcons[0]->GetComponent<Transform>()->SetTranslation(spriteTilemap->TileToWorld(Vector2D(2.5f, 31.5f)));
-		lifeIcons[0]->GetComponent<Transform>()->SetScale(Vector2D(-40.0f, 40.0f));
-		objectManager.AddObject(*lifeIcons[0]);
-		lifeIcons[1] = new GameObject(*objectManager.GetArchetypeByName("Life"));
-		lifeIcons[1]->GetComponent<Transform>()->SetTranslation(spriteTilemap->TileToWorld(Vector2D(4.5f, 31.5f)));
-		lifeIcons[1]->GetComponent<Transform>()->SetScale(Vector2D(-40.0f, 40.0f));
-		objectManager.AddObject(*lifeIcons[1]);
-
+		GameObject* lifeIcon = new GameObject(*objectManager.GetArchetypeByName("Life"));
+		lifeIcon->GetComponent<Transform>()->SetTranslation(spriteTilemap->TileToWorld(Vector2D(2.5f, 31.5f)));
+		lifeIcon->GetComponent<Transform>()->SetScale(Vector2D(-40.0f, 40.0f));
+		objectManager.AddObject(*lifeIcon);
+		lifeIcons[0] = lifeIcon->GetHandle();
+		lifeIcon = new GameObject(*objectManager.GetArchetypeByName("Life"));
+		lifeIcon->GetComponent<Transform>()->SetTranslation(spriteTilemap->TileToWorld(Vector2D(4.5f, 31.5f)));
+		lifeIcon->GetComponent<Transform>()->SetScale(Vector2D(-40.0f, 40.0f));
+		objectManager.AddObject(*lifeIcon);
+		lifeIcons[1] = lifeIcon->GetHandle();
+
+		GameObject* pacManObject = nullptr;
 		if (!gameOver)
 		{
 			// PAC-MAN.
-			pacMan = new GameObject(*objectManager.GetArchetypeByName("PAC-MAN"));
-			pacMan->GetComponent<Behaviors::GridMovement>()->SetTilemap(dataMap, spriteTilemap);
-			pacMan->GetComponent<Behaviors::PlayerCollision>()->SetTilemap(dataMap, spriteTilemap);
-			pacMan->GetComponent<Transform>()->SetTranslation(spriteTilemap->TileToWorld(Vector2D(13.5f, 23.0f)));
+			pacManObject = new GameObject(*objectManager.GetArchetypeByName("PAC-MAN"));
+			pacManObject->GetComponent<Behaviors::GridMovement>()->SetTilemap(dataMap, spriteTilemap, mazeGraph);
+			pacManObject->GetComponent<Behaviors::PlayerCollision>()->SetTilemap(dataMap, spriteTilemap);
+			pacManObject->GetComponent<Transform>()->SetTranslation(spriteTilemap->TileToWorld(Vector2D(13.5f, 23.0f)));
 
 			// Restore the player's score, assuming they had lives left.
-			Behaviors::PlayerScore* playerScore = pacMan->GetComponent<Behaviors::PlayerScore>();
+			Behaviors::PlayerScore* playerScore = pacManObject->GetComponent<Behaviors::PlayerScore>();
 			playerScore->SetScore(oldScore);
 			playerScore->SetDots(oldDots);
 		}
@@ -234,7 +274,7 @@ namespace Levels
 		for (auto it = energizerPositions.begin(); it != energizerPositions.end(); ++it)
 		{
 			// Create energizer at position.
-			GameObject* energizerPellet = new GameObject(*objectManager.GetArchetypeByName("Energizer"));
+			GameObject* energizerPellet = objectManager.CreateObject("Energizer");
 			energizerPellet->GetComponent<Transform>()->SetTranslation(*it);
 			objectManager.AddObject(*energizerPellet);
 			energizerPellet->GetComponent<Animation>()->Play(0, 4, 0.0625f, true);
@@ -243,7 +283,7 @@ namespace Levels
 		for (auto it = dotPositions.begin(); it != dotPositions.end(); ++it)
 		{
 			// Create dot at position.
-			GameObject* dot = new GameObject(*objectManager.GetArchetypeByName("Dot"));
+			GameObject* dot = objectManager.CreateObject("Dot");
 			dot->GetComponent<Transform>()->SetTranslation(*it);
 			objectManager.AddObject(*dot);
 			dot->GetComponent<Animation>()->Play(0, 2, 0.125f, true);
@@ -252,13 +292,14 @@ namespace Levels
 		if (!gameOver)
 		{
 			GameObject* kingGhost = new GameObject(*objectManager.GetArchetypeByName("KingGhost"));
-			kingGhost->GetComponent<Behaviors::GridMovement>()->SetTilemap(dataMap, tilemap->GetComponent<SpriteTilemap>());
+			kingGhost->GetComponent<Behaviors::GridMovement>()->SetTilemap(dataMap, tilemap->GetComponent<SpriteTilemap>(), mazeGraph);
 			kingGhost->GetComponent<Behaviors::BaseAI>()->SetWaveProgress(kingGhostWave, kingGhostWaveTimer);
 			kingGhost->GetComponent<Transform>()->SetTranslation(spriteTilemap->TileToWorld(Vector2D(15.5f, 14.0f)));
 			objectManager.AddObject(*kingGhost);
 
 			// Add PAC-MAN here so it draws over everything else.
-			objectManager.AddObject(*pacMan);
+			objectManager.AddObject(*pacManObject);
+			pacMan = pacManObject->GetHandle();
 
 			// Re-initialize all ghosts so they can find the player object since it was added after them.
 			kingGhost->Initialize();
@@ -267,9 +308,9 @@ namespace Levels
 		}
 		else
 		{
-			readyText->GetComponent<Transform>()->SetTranslation(spriteTilemap->TileToWorld(Vector2D(13.75f, 17.25f)));
-			readyText->GetComponent<SpriteText>()->SetText("GAME OVER");
-			readyText->GetComponent<SpriteText>()->SetColor(Colors::Red);
+			readyTextObject->GetComponent<Transform>()->SetTranslation(spriteTilemap->TileToWorld(Vector2D(13.75f, 17.25f)));
+			readyTextObject->GetComponent<SpriteText>()->SetText("GAME OVER");
+			readyTextObject->GetComponent<SpriteText>()->SetColor(Colors::Red);
 		}
 	}
 
@@ -280,8 +321,18 @@ namespace Levels
 	{
 		UNREFERENCED_PARAMETER(dt);
 
+		// Pass cells edited since the last frame on to the maze graph, flow fields and baked tiles.
+		if (dataMap != nullptr)
+			dataMap->FlushChanges();
+
 		GameObjectManager& objectManager = GetSpace()->GetObjectManager();
 
+		// Find the objects kept from Initialize. PAC-MAN only resolves if the game is not over.
+		GameObject* pacManObject = objectManager.GetObjectByHandle(pacMan);
+		GameObject* readyTextObject = objectManager.GetObjectByHandle(readyText);
+		GameObject* scoreTextObject = objectManager.GetObjectByHandle(scoreText);
+		GameObject* highScoreTextObject = objectManager.GetObjectByHandle(highScoreText);
+
 		musicTimer -= dt;
 		if (musicTimer <= 0 && !musicPlayed)
 		{
@@ -299,21 +350,21 @@ namespace Levels
 		// Update score & high score in HUD
 		if (!gameOver)
 		{
-			unsigned score = pacMan->GetComponent<Behaviors::PlayerScore>()->GetScore();
+			unsigned score = pacManObject->GetComponent<Behaviors::PlayerScore>()->GetScore();
 
 			if (highScore < score)
 				highScore = score;
 
-			scoreText->GetComponent<SpriteText>()->SetText(std::to_string(score).c_str());
+			scoreTextObject->GetComponent<SpriteText>()->SetText(std::to_string(score).c_str());
 		}
 
-		highScoreText->GetComponent<SpriteText>()->SetText(std::to_string(highScore).c_str());
+		highScoreTextObject->GetComponent<SpriteText>()->SetText(std::to_string(highScore).c_str());
 
 		// Handle ready text
 		readyTimer -= dt;
 		if (readyTimer <= 0.0f)
 		{
-			readyText->GetComponent<SpriteText>()->SetAlpha(0.0f);
+			readyTextObject->GetComponent<SpriteText>()->SetAlpha(0.0f);
 
 			if (gameOver)
 			{
@@ -323,7 +374,7 @@ namespace Levels
 		}
 		else
 		{
-			readyText->GetComponent<SpriteText>()->SetAlpha(1.0f);
+			readyTextObject->GetComponent<SpriteText>()->SetAlpha(1.0f);
 		}
 
 		// Handle winning if there are no more dots.
@@ -331,9 +382,9 @@ namespace Levels
 		{
 			if (objectManager.GetObjectCount("Dot") == 0)
 			{
-				readyText->GetComponent<SpriteText>()->SetText("YOU WIN!");
-				readyText->GetComponent<SpriteText>()->SetAlpha(1.0f);
-				readyText->GetComponent<SpriteText>()->SetColor(Colors::Green);
+				readyTextObject->GetComponent<SpriteText>()->SetText("YOU WIN!");
+				readyTextObject->GetComponent<SpriteText>()->SetAlpha(1.0f);
+				readyTextObject->GetComponent<SpriteText>()->SetColor(Colors::Green);
 
 				winTimer += dt;
 			}
@@ -349,9 +400,9 @@ namespace Levels
 		for (unsigned i = 0; i < startLives - 1; i++)
 		{
 			if (i < lives)
-				lifeIcons[i]->GetComponent<Sprite>()->SetAlpha(1.0f);
+				objectManager.GetObjectByHandle(lifeIcons[i])->GetComponent<Sprite>()->SetAlpha(1.0f);
 			else
-				lifeIcons[i]->GetComponent<Sprite>()->SetAlpha(0.0f);
+				objectManager.GetObjectByHandle(lifeIcons[i])->GetComponent<Sprite>()->SetAlpha(0.0f);
 		}
 
 		if (!gameOver)
@@ -360,29 +411,35 @@ namespace Levels
 			if (fruitAlive)
 			{
 				fruitDeathTimer -= dt;
-				if (fruitDeathTimer <= 0 && fruit != nullptr)
+				if (fruitDeathTimer <= 0)
 				{
-					fruit->Destroy();
+					// The fruit is gone already if it was eaten.
+					GameObject* fruitObject = objectManager.GetObjectByHandle(fruit);
+					if (fruitObject != nullptr)
+						fruitObject->Destroy();
+
 					fruitAlive = false;
 				}
 			}
 
 			// First fruit
-			if (pacMan->GetComponent<Behaviors::PlayerScore>()->GetDots() >= 70 && fruitSpawnAmount == 0)
+			if (pacManObject->GetComponent<Behaviors::PlayerScore>()->GetDots() >= 70 && fruitSpawnAmount == 0)
 			{
-				fruitDeathTimer = RandomRange(9.0f, 10.0f);
-				fruit = new GameObject(*objectManager.GetArchetypeByName("Fruit"));
-				objectManager.AddObject(*fruit);
+				fruitDeathTimer = GetSpace()->GetRandom().Range(9.0f, 10.0f);
+				GameObject* fruitObject = objectManager.CreateObject("Fruit");
+				objectManager.AddObject(*fruitObject);
+				fruit = fruitObject->GetHandle();
 				++fruitSpawnAmount;
 				fruitAlive = true;
 			}
 
 			// Second fruit
-			if (pacMan->GetComponent<Behaviors::PlayerScore>()->GetDots() >= 170 && fruitSpawnAmount == 1)
+			if (pacManObject->GetComponent<Behaviors::PlayerScore>()->GetDots() >= 170 && fruitSpawnAmount == 1)
 			{
-				fruitDeathTimer = RandomRange(9.0f, 10.0f);
-				fruit = new GameObject(*objectManager.GetArchetypeByName("Fruit"));
-				objectManager.AddObject(*fruit);
+				fruitDeathTimer = GetSpace()->GetRandom().Range(9.0f, 10.0f);
+				GameObject* fruitObject = objectManager.CreateObject("Fruit");
+				objectManager.AddObject(*fruitObject);
+				fruit = fruitObject->GetHandle();
 				++fruitSpawnAmount;
 				fruitAlive = true;
 			}
@@ -410,11 +467,7 @@ namespace Levels
 				std::vector<GameObject*> enemies;
 
 				// Gather enemies.
-				objectManager.GetAllObjectsByName("Blinky", enemies);
-				objectManager.GetAllObjectsByName("Pinky", enemies);
-				objectManager.GetAllObjectsByName("Inky", enemies);
-				objectManager.GetAllObjectsByName("Clyde", enemies);
-				objectManager.GetAllObjectsByName("KingGhost", enemies);
+				objectManager.GetAllObjectsWithTags(Tags::Ghost, enemies);
 
 				for (auto it = enemies.begin(); it != enemies.end(); ++it)
 				{
@@ -435,6 +488,12 @@ namespace Levels
 	{
 		GameObjectManager& objectManager = GetSpace()->GetObjectManager();
 
+		// The tilemap is about to be destroyed.
+		GetSpace()->GetTileOccupancy().SetSpriteTilemap(nullptr);
+		GetSpace()->GetFlowFields().Clear();
+		if (dataMap != nullptr)
+			GetSpace()->RemoveStreamingTilemap(*dataMap);
+
 		// Gather all energizers.
 		std::vector<GameObject*> energizers;
 		objectManager.GetAllObjectsByName("Energizer", energizers);
@@ -459,7 +518,7 @@ namespace Levels
 
 		if (!gameOver)
 		{
-			Behaviors::PlayerScore* playerScore = pacMan->GetComponent<Behaviors::PlayerScore>();
+			Behaviors::PlayerScore* playerScore = objectManager.GetObjectByHandle(pacMan)->GetComponent<Behaviors::PlayerScore>();
 			oldScore = playerScore->GetScore();
 			oldDots = playerScore->GetDots();
 
@@ -475,6 +534,7 @@ namespace Levels
 	void Level2::Unload()
 	{
 		// Free all allocated memory.
+		delete mazeGraph;
 		delete dataMap;
 
 		// Unload all sounds.
@@ -19,6 +19,7 @@
 
 #include <vector>
 #include <Vector2D.h>
+#include <GameObjectHandle.h>
 
 //------------------------------------------------------------------------------
 
@@ -32,6 +33,7 @@ class Mesh;
 class SpriteSource;
 class GameObject;
 class Tilemap;
+class MazeGraph;
 class SoundManager;
 
 namespace FMOD
@@ -86,9 +88,13 @@ namespace Levels
 
 		// Tilemap
 		Tilemap* dataMap;
+		MazeGraph* mazeGraph;
 		unsigned columnsMap;
 		unsigned rowsMap;
 
+		// Maps with at least this many cells are streamed instead of loaded whole
+		size_t streamingCellCount;
+
 		// Dot
 		unsigned columnsDot;
 		unsigned rowsDot;
@@ -136,13 +142,13 @@ namespace Levels
 		std::vector<Vector2D> energizerPositions;
 		std::vector<Vector2D> dotPositions;
 
-		// Game objects
-		GameObject* readyText;
-		GameObject* scoreText;
-		GameObject* highScoreText;
-		GameObject* pacMan;
-		GameObject* fruit;
-		GameObject* lifeIcons[2];
+		// Game objects, kept as handles as they may be destroyed while the level holds on to them
+		GameObjectHandle readyText;
+		GameObjectHandle scoreText;
+		GameObjectHandle highScoreText;
+		GameObjectHandle pacMan;
+		GameObjectHandle fruit;
+		GameObjectHandle lifeIcons[2];
 	};
 }
 
@@ -28,6 +28,13 @@
 // Game object factory
 #include <GameObjectFactory.h>
 
+// Tilemap conversion
+#include <Tilemap.h>
+#include <sstream>
+
+// Benchmarks
+#include "Benchmarks.h"
+
 // Components
 #include "ColorChange.h"
 #include "MonkeyAnimation.h"
@@ -48,6 +55,8 @@
 #include "ClydeAI.h"
 #include "GhostAnimation.h"
 #include "PlayerGhostController.h"
+#include "TileOccupant.h"
+#include "GhostSwarm.h"
 
 //------------------------------------------------------------------------------
 
@@ -64,10 +73,33 @@ int WINAPI WinMain(_In_ HINSTANCE instance, _In_opt_ HINSTANCE prevInstance, _In
 
 	// Unused parameters
 	UNREFERENCED_PARAMETER(prevInstance);
-	UNREFERENCED_PARAMETER(command_line);
 	UNREFERENCED_PARAMETER(show);
 	UNREFERENCED_PARAMETER(instance);
 
+	// Convert text tilemaps to binary ones instead of running the game,
+	//   e.g. "PAC-MAN.exe -tmb Assets/Levels/Level1.txt Assets/Levels/Level2.txt".
+	std::istringstream arguments(command_line);
+	std::string argument;
+	if (arguments >> argument && argument == "-tmb")
+	{
+		int failures = 0;
+		while (arguments >> argument)
+		{
+			if (!Tilemap::ConvertToBinaryFile(argument))
+				++failures;
+		}
+
+		return failures;
+	}
+
+	// Run a benchmark instead of the game, e.g. "PAC-MAN.exe -bench components > results.txt".
+	if (argument == "-bench")
+	{
+		std::string name;
+		arguments >> name;
+		return Benchmarks::Run(name, std::cout);
+	}
+
 	GameObjectFactory& objectFactory = GameObjectFactory::GetInstance();
 
 	// Register components with the game object factory so game objects can be fully deserialized.
@@ -90,6 +122,8 @@ int WINAPI WinMain(_In_ HINSTANCE instance, _In_opt_ HINSTANCE prevInstance, _In
 	objectFactory.RegisterComponent<Behaviors::ClydeAI>();
 	objectFactory.RegisterComponent<Behaviors::GhostAnimation>();
 	objectFactory.RegisterComponent<Behaviors::PlayerGhostController>();
+	objectFactory.RegisterComponent<Behaviors::TileOccupant>();
+	objectFactory.RegisterComponent<Behaviors::GhostSwarm>();
 
 	// Create a new space called "GameSpace"
 	Space* space = new Space("GameSpace");
@@ -0,0 +1,189 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	MazeGraph.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		PAC-MAN
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "MazeGraph.h"
+
+// Systems
+#include <Tilemap.h>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// Constructor
+// Params:
+//   tilemap = The tilemap to build the graph from.
+MazeGraph::MazeGraph(const Tilemap& tilemap) : tilemap(tilemap),
+	width(static_cast<int>(tilemap.GetWidth())), height(static_cast<int>(tilemap.GetHeight())),
+	links(static_cast<size_t>(width) * height)
+{
+	Rebuild(0, 0, width - 1, height - 1);
+
+	// Keep the links up to date as cells are edited.
+	tilemap.Subscribe(OnTilemapChanged, this);
+}
+
+// Destructor
+MazeGraph::~MazeGraph()
+{
+	tilemap.Unsubscribe(OnTilemapChanged, this);
+}
+
+// Rebuilds the links of every cell in a rectangle, and of the cells bordering it. Call after
+//   editing cells of the tilemap.
+// Params:
+//   minColumn = The left edge of the edited rectangle.
+//   minRow = The top edge of the edited rectangle.
+//   maxColumn = The right edge of the edited rectangle.
+//   maxRow = The bottom edge of the edited rectangle.
+void MazeGraph::Rebuild(int minColumn, int minRow, int maxColumn, int maxRow)
+{
+	// The neighbors of an edited cell link to it, so grow the rectangle by one cell.
+	minColumn = std::max(minColumn - 1, 0);
+	minRow = std::max(minRow - 1, 0);
+	maxColumn = std::min(maxColumn + 1, width - 1);
+	maxRow = std::min(maxRow + 1, height - 1);
+
+	for (int row = minRow; row <= maxRow; ++row)
+	{
+		for (int column = minColumn; column <= maxColumn; ++column)
+			links[static_cast<size_t>(row) * width + column] = BuildLinks(column, row);
+	}
+}
+
+// Checks whether a cell is inside the maze.
+// Params:
+//   column = The column of the cell.
+//   row = The row of the cell.
+bool MazeGraph::IsInside(int column, int row) const
+{
+	return column >= 0 && row >= 0 && column < width && row < height;
+}
+
+// Checks whether the neighbor of a cell is empty, meaning the player may move onto it.
+//   Neighbors off the edge of the maze are empty.
+// Params:
+//   column = The column of the cell. The cell must be inside the maze.
+//   row = The row of the cell. The cell must be inside the maze.
+//   direction = The direction of the neighbor.
+bool MazeGraph::IsEmpty(int column, int row, unsigned direction) const
+{
+	return (links[static_cast<size_t>(row) * width + column] & (1 << (EMPTY_SHIFT + direction))) != 0;
+}
+
+// Checks whether a ghost may move onto the neighbor of a cell, which includes the ghost house door.
+// Params:
+//   column = The column of the cell. The cell must be inside the maze.
+//   row = The row of the cell. The cell must be inside the maze.
+//   direction = The direction of the neighbor.
+bool MazeGraph::IsGhostPassable(int column, int row, unsigned direction) const
+{
+	return (links[static_cast<size_t>(row) * width + column] & (1 << (GHOST_SHIFT + direction))) != 0;
+}
+
+// Checks whether the neighbor of a cell is off the edge of the maze. Moving onto it wraps around to
+//   the opposite edge.
+// Params:
+//   column = The column of the cell. The cell must be inside the maze.
+//   row = The row of the cell. The cell must be inside the maze.
+//   direction = The direction of the neighbor.
+bool MazeGraph::IsEdge(int column, int row, unsigned direction) const
+{
+	return (links[static_cast<size_t>(row) * width + column] & (1 << (EDGE_SHIFT + direction))) != 0;
+}
+
+// Gets how many neighbors of a cell are empty.
+// Params:
+//   column = The column of the cell. The cell must be inside the maze.
+//   row = The row of the cell. The cell must be inside the maze.
+unsigned MazeGraph::GetEmptyCount(int column, int row) const
+{
+	return (links[static_cast<size_t>(row) * width + column] & COUNT_MASK) >> COUNT_SHIFT;
+}
+
+// Checks whether a cell is an intersection, meaning more than two of its neighbors are empty.
+// Params:
+//   column = The column of the cell. The cell must be inside the maze.
+//   row = The row of the cell. The cell must be inside the maze.
+bool MazeGraph::IsIntersection(int column, int row) const
+{
+	return GetEmptyCount(column, row) > 2;
+}
+
+//------------------------------------------------------------------------------
+// Private Functions:
+//------------------------------------------------------------------------------
+
+// Computes the links of a cell from the tilemap.
+// Params:
+//   column = The column of the cell.
+//   row = The row of the cell.
+unsigned short MazeGraph::BuildLinks(int column, int row) const
+{
+	// Offsets to each neighbor, in the order up, left, down, right.
+	static const int offsetX[4] = { 0, -1, 0, 1 };
+	static const int offsetY[4] = { -1, 0, 1, 0 };
+
+	unsigned cellLinks = 0;
+	unsigned emptyCount = 0;
+
+	for (unsigned direction = 0; direction < 4; ++direction)
+	{
+		const int neighborColumn = column + offsetX[direction];
+		const int neighborRow = row + offsetY[direction];
+
+		// Cells off the edge of the maze count as empty, as that is where the tunnels wrap around.
+		int cellValue = 0;
+		if (IsInside(neighborColumn, neighborRow))
+			cellValue = tilemap.GetCellValue(static_cast<unsigned>(neighborColumn), static_cast<unsigned>(neighborRow));
+		else
+			cellLinks |= 1 << (EDGE_SHIFT + direction);
+
+		if (cellValue == 0)
+		{
+			cellLinks |= 1 << (EMPTY_SHIFT + direction);
+			++emptyCount;
+		}
+
+		if (cellValue == 0 || cellValue == ghostDoorValue)
+			cellLinks |= 1 << (GHOST_SHIFT + direction);
+	}
+
+	return static_cast<unsigned short>(cellLinks | (emptyCount << COUNT_SHIFT));
+}
+
+// Rebuilds the links around the changed cells of the tilemap.
+// Params:
+//   context = The maze graph that subscribed.
+//   tilemap = The tilemap that changed.
+//   minColumn = The left edge of the changed rectangle.
+//   minRow = The top edge of the changed rectangle.
+//   maxColumn = The right edge of the changed rectangle.
+//   maxRow = The bottom edge of the changed rectangle.
+void MazeGraph::OnTilemapChanged(void* context, const Tilemap& tilemap, int minColumn, int minRow, int maxColumn, int maxRow)
+{
+	UNREFERENCED_PARAMETER(tilemap);
+	static_cast<MazeGraph*>(context)->Rebuild(minColumn, minRow, maxColumn, maxRow);
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,157 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	MazeGraph.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		PAC-MAN
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Forward References:
+//------------------------------------------------------------------------------
+
+class Tilemap;
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+// Maze graph - The links between each cell of the maze and its four neighbors, built once when
+//   the tilemap is loaded so that moving between tiles is a table lookup instead of four cell reads.
+// Directions are numbered up, left, down, right, matching GridMovement's directions.
+class MazeGraph
+{
+public:
+	//------------------------------------------------------------------------------
+	// Public Constants:
+	//------------------------------------------------------------------------------
+
+	// The cell value of the ghost house door, which only ghosts may pass through.
+	static const int ghostDoorValue = 31;
+
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Constructor
+	// Params:
+	//   tilemap = The tilemap to build the graph from.
+	MazeGraph(const Tilemap& tilemap);
+
+	// Destructor
+	~MazeGraph();
+
+	// Rebuilds the links of every cell in a rectangle, and of the cells bordering it. Call after
+	//   editing cells of the tilemap.
+	// Params:
+	//   minColumn = The left edge of the edited rectangle.
+	//   minRow = The top edge of the edited rectangle.
+	//   maxColumn = The right edge of the edited rectangle.
+	//   maxRow = The bottom edge of the edited rectangle.
+	void Rebuild(int minColumn, int minRow, int maxColumn, int maxRow);
+
+	// Checks whether a cell is inside the maze.
+	// Params:
+	//   column = The column of the cell.
+	//   row = The row of the cell.
+	bool IsInside(int column, int row) const;
+
+	// Checks whether the neighbor of a cell is empty, meaning the player may move onto it.
+	//   Neighbors off the edge of the maze are empty.
+	// Params:
+	//   column = The column of the cell. The cell must be inside the maze.
+	//   row = The row of the cell. The cell must be inside the maze.
+	//   direction = The direction of the neighbor.
+	bool IsEmpty(int column, int row, unsigned direction) const;
+
+	// Checks whether a ghost may move onto the neighbor of a cell, which includes the ghost house door.
+	// Params:
+	//   column = The column of the cell. The cell must be inside the maze.
+	//   row = The row of the cell. The cell must be inside the maze.
+	//   direction = The direction of the neighbor.
+	bool IsGhostPassable(int column, int row, unsigned direction) const;
+
+	// Checks whether the neighbor of a cell is off the edge of the maze. Moving onto it wraps around to
+	//   the opposite edge.
+	// Params:
+	//   column = The column of the cell. The cell must be inside the maze.
+	//   row = The row of the cell. The cell must be inside the maze.
+	//   direction = The direction of the neighbor.
+	bool IsEdge(int column, int row, unsigned direction) const;
+
+	// Gets how many neighbors of a cell are empty.
+	// Params:
+	//   column = The column of the cell. The cell must be inside the maze.
+	//   row = The row of the cell. The cell must be inside the maze.
+	unsigned GetEmptyCount(int column, int row) const;
+
+	// Checks whether a cell is an intersection, meaning more than two of its neighbors are empty.
+	// Params:
+	//   column = The column of the cell. The cell must be inside the maze.
+	//   row = The row of the cell. The cell must be inside the maze.
+	bool IsIntersection(int column, int row) const;
+
+private:
+	//------------------------------------------------------------------------------
+	// Private Constants:
+	//------------------------------------------------------------------------------
+
+	// Layout of the links of a cell. Each group has one bit per direction.
+	enum LinkBits
+	{
+		EMPTY_SHIFT = 0,
+		GHOST_SHIFT = 4,
+		EDGE_SHIFT = 8,
+		COUNT_SHIFT = 12,
+		COUNT_MASK = 0x7 << COUNT_SHIFT,
+	};
+
+	//------------------------------------------------------------------------------
+	// Private Functions:
+	//------------------------------------------------------------------------------
+
+	// Computes the links of a cell from the tilemap.
+	// Params:
+	//   column = The column of the cell.
+	//   row = The row of the cell.
+	unsigned short BuildLinks(int column, int row) const;
+
+	// Rebuilds the links around the changed cells of the tilemap.
+	// Params:
+	//   context = The maze graph that subscribed.
+	//   tilemap = The tilemap that changed.
+	//   minColumn = The left edge of the changed rectangle.
+	//   minRow = The top edge of the changed rectangle.
+	//   maxColumn = The right edge of the changed rectangle.
+	//   maxRow = The bottom edge of the changed rectangle.
+	static void OnTilemapChanged(void* context, const Tilemap& tilemap, int minColumn, int minRow, int maxColumn, int maxRow);
+
+	//------------------------------------------------------------------------------
+	// Private Variables:
+	//------------------------------------------------------------------------------
+
+	// The tilemap the graph is built from
+	const Tilemap& tilemap;
+
+	// Dimensions of the maze
+	int width;
+	int height;
+
+	// The links of each cell, in row-major order
+	std::vector<unsigned short> links;
+};
+
+//------------------------------------------------------------------------------
@@ -63,14 +63,12 @@ namespace Behaviors
 		UNREFERENCED_PARAMETER(adjacentTiles);
 		UNREFERENCED_PARAMETER(emptyCount);
 
+		GameObject* playerObject = GetPlayer();
+		if (playerObject == nullptr)
+			return;
+
 		// Set Chase Target (4 infront of Player Position)
 		if (mode == CHASE)
-		{
-			// Set target to player
-			target = GetSpriteTilemap()->WorldToTile(player->GetComponent<Transform>()->GetTranslation());
-
-			// Add 4 * Direction Vector of PAC-MAN
-			target += player->GetComponent<PlayerController>()->GetDirectionVector(4);
-		}
+			target = GhostTargeting::GetPinkyTarget(GetPlayerState(*playerObject));
 	}
 }
\ No newline at end of file
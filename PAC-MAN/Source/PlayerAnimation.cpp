@@ -30,6 +30,7 @@
 #include <Transform.h>
 #include "PlayerController.h"
 #include "GhostAnimation.h"
+#include "Tags.h"
 
 //------------------------------------------------------------------------------
 
@@ -171,11 +172,7 @@ namespace Behaviors
 					GameObjectManager& objectManager = GetOwner()->GetSpace()->GetObjectManager();
 
 					// Gather enemies.
-					objectManager.GetAllObjectsByName("Blinky", enemies);
-					objectManager.GetAllObjectsByName("Pinky", enemies);
-					objectManager.GetAllObjectsByName("Inky", enemies);
-					objectManager.GetAllObjectsByName("Clyde", enemies);
-					objectManager.GetAllObjectsByName("KingGhost", enemies);
+					objectManager.GetAllObjectsWithTags(Tags::Ghost, enemies);
 
 					// Turn all ghosts invisible.
 					for (auto it = enemies.begin(); it != enemies.end(); ++it)
@@ -241,7 +238,7 @@ namespace Behaviors
 			return;
 		}
 
-		if (AlmostEqual(playerController->GetOldTile(), playerController->GetNewTile()))
+		if (playerController->GetOldTile() == playerController->GetNewTile())
 		{
 			nextState = State::StateIdle;
 		}
@@ -24,6 +24,7 @@
 #include <GameObjectManager.h>
 #include <GameObject.h>
 #include <Tilemap.h>
+#include <TileOccupancyMap.h>
 
 // Components
 #include <Transform.h>
@@ -34,6 +35,7 @@
 #include "PlayerController.h"
 #include "PlayerAnimation.h"
 #include "Energizer.h"
+#include "Tags.h"
 
 //------------------------------------------------------------------------------
 
@@ -93,27 +95,33 @@ namespace Behaviors
 	{
 		UNREFERENCED_PARAMETER(dt);
 
-		Vector2D playerTile = FloorVector2D(spriteTilemap->WorldToTile(transform->GetTranslation()));
+		GameObjectManager& objectManager = GetOwner()->GetSpace()->GetObjectManager();
+		TileOccupancyMap& tileOccupancy = GetOwner()->GetSpace()->GetTileOccupancy();
 
-		std::vector<GameObject*> enemies;
+		// Find the tile the player is on. Grid movement keeps it up to date in the occupancy map.
+		int playerX, playerY;
+		if (!tileOccupancy.GetTile(*GetOwner(), playerX, playerY))
+		{
+			Vector2D playerTile = FloorVector2D(spriteTilemap->WorldToTile(transform->GetTranslation()));
+			playerX = static_cast<int>(playerTile.x);
+			playerY = static_cast<int>(playerTile.y);
+		}
 
-		GameObjectManager& objectManager = GetOwner()->GetSpace()->GetObjectManager();
+		// Gather everything sharing the player's tile.
+		std::vector<GameObject*> occupants;
+		tileOccupancy.GetObjectsAt(playerX, playerY, occupants);
+
+		std::vector<GameObject*> enemies;
 
 		// Gather enemies.
-		objectManager.GetAllObjectsByName("Blinky", enemies);
-		objectManager.GetAllObjectsByName("Pinky", enemies);
-		objectManager.GetAllObjectsByName("Inky", enemies);
-		objectManager.GetAllObjectsByName("Clyde", enemies);
-		objectManager.GetAllObjectsByName("KingGhost", enemies);
+		objectManager.GetAllObjectsWithTags(Tags::Ghost, enemies);
 
-		for (auto it = enemies.begin(); it != enemies.end(); ++it)
+		for (auto it = occupants.begin(); it != occupants.end(); ++it)
 		{
-			Vector2D enemyTile = FloorVector2D(spriteTilemap->WorldToTile((*it)->GetComponent<Transform>()->GetTranslation()));
-
-			// Check if the player and this enemy are on the same tile.
-			if (AlmostEqual(playerTile, enemyTile))
+			// Check if this object on the player's tile is an enemy.
+			BaseAI* baseAI = (*it)->GetComponent<BaseAI>();
+			if (baseAI != nullptr)
 			{
-				BaseAI* baseAI = (*it)->GetComponent<BaseAI>();
 				if (!baseAI->IsDead())
 				{
 					if (baseAI->IsFrightened())
@@ -138,7 +146,7 @@ namespace Behaviors
 							break;
 						}
 
-						GameObject* scoreObject = new GameObject(*objectManager.GetArchetypeByName("Bonus" + std::to_string(score)));
+						GameObject* scoreObject = objectManager.CreateObject("Bonus" + std::to_string(score));
 						scoreObject->GetComponent<Transform>()->SetTranslation(transform->GetTranslation());
 						objectManager.AddObject(*scoreObject);
 
@@ -167,33 +175,25 @@ namespace Behaviors
 			}
 		}
 
-		std::vector<GameObject*> gameObjects;
-		objectManager.GetAllObjectsByName("Fruit", gameObjects);
-
-		for (auto it = gameObjects.begin(); it != gameObjects.end(); ++it)
+		for (auto it = occupants.begin(); it != occupants.end(); ++it)
 		{
-			Vector2D fruit = FloorVector2D(spriteTilemap->WorldToTile((*it)->GetComponent<Transform>()->GetTranslation()));
-			if (AlmostEqual(playerTile, fruit))
+			// Skip anything already consumed by an earlier check.
+			if ((*it)->IsDestroyed())
+				continue;
+
+			const std::string& name = (*it)->GetName();
+
+			if (name == "Fruit")
 			{
 				playerScore->IncreaseScore(100);
 				(*it)->Destroy();
 				Engine::GetInstance().GetModule<SoundManager>()->PlaySound("EatFruit.wav");
 
-				GameObject* scoreObject = new GameObject(*objectManager.GetArchetypeByName("Bonus100"));
+				GameObject* scoreObject = objectManager.CreateObject("Bonus100");
 				scoreObject->GetComponent<Transform>()->SetTranslation(transform->GetTranslation());
 				objectManager.AddObject(*scoreObject);
 			}
-		}
-
-		gameObjects.clear();
-		objectManager.GetAllObjectsByName("Dot", gameObjects);
-
-		for (auto it = gameObjects.begin(); it != gameObjects.end(); ++it)
-		{
-			Vector2D dotTile = FloorVector2D(spriteTilemap->WorldToTile((*it)->GetComponent<Transform>()->GetTranslation()));
-
-			// Check if the player and this dot are on the same tile.
-			if (AlmostEqual(playerTile, dotTile))
+			else if (name == "Dot")
 			{
 				// Add score and destroy the dot.
 				playerScore->IncreaseScore(10);
@@ -213,17 +213,7 @@ namespace Behaviors
 
 				oddConsumable = !oddConsumable;
 			}
-		}
-
-		gameObjects.clear();
-		objectManager.GetAllObjectsByName("Energizer", gameObjects);
-
-		for (auto it = gameObjects.begin(); it != gameObjects.end(); ++it)
-		{
-			Vector2D energizerTIle = FloorVector2D(spriteTilemap->WorldToTile((*it)->GetComponent<Transform>()->GetTranslation()));
-
-			// Check if the player and this energizer are on the same tile.
-			if (AlmostEqual(playerTile, energizerTIle))
+			else if (name == "Energizer")
 			{
 				// Add score and destroy the energizer.
 				playerScore->IncreaseScore(50);
@@ -307,11 +297,7 @@ namespace Behaviors
 		GameObjectManager& objectManager = GetOwner()->GetSpace()->GetObjectManager();
 
 		// Gather enemies.
-		objectManager.GetAllObjectsByName("Blinky", enemies);
-		objectManager.GetAllObjectsByName("Pinky", enemies);
-		objectManager.GetAllObjectsByName("Inky", enemies);
-		objectManager.GetAllObjectsByName("Clyde", enemies);
-		objectManager.GetAllObjectsByName("KingGhost", enemies);
+		objectManager.GetAllObjectsWithTags(Tags::Ghost, enemies);
 
 		// Freeze player.
 		GetOwner()->GetComponent<GridMovement>()->SetFrozen(true);
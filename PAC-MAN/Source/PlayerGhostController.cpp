@@ -108,10 +108,10 @@ namespace Behaviors
 	{
 		BaseAI::OnTileMove(adjacentTiles, emptyCount);
 
-		Vector2D tile = GetNewTile();
+		TileCoord tile = GetNewTile();
 
 		// Make sure the player is not dead or in the ghost house.
-		if (!(tile.x >= 10.0f && tile.x <= 17.0f && tile.y >= 12.0f && tile.y <= 16.0f) && !IsDead())
+		if (!(tile.x >= 10 && tile.x <= 17 && tile.y >= 12 && tile.y <= 16) && !IsDead())
 		{
 			Input& input = Input::GetInstance();
 
@@ -91,7 +91,7 @@ namespace Behaviors
 		physics = GetOwner()->GetComponent<Physics>();
 
 		// Add the collision handler to the collider.
-		GetOwner()->GetComponent<Collider>()->SetCollisionHandler(CollisionHandlerShip);
+		GetOwner()->GetComponent<Collider>()->SetCollisionEnterHandler(CollisionHandlerShip);
 
 		GameObject* owner = GetOwner();
 		Space* space = owner->GetSpace();
@@ -216,8 +216,8 @@ namespace Behaviors
 		// Check if the space key is pressed.
 		if (input.CheckTriggered(VK_SPACE))
 		{
-			// Create a new instance of the bullet archetype.
-			GameObject* bullet = new GameObject(*bulletArchetype);
+			// Create a new instance of the bullet archetype, reusing a destroyed bullet if possible.
+			GameObject* bullet = GetOwner()->GetSpace()->GetObjectManager().CreateObject(bulletArchetype->GetName());
 
 			// Calculate the direction the ship the ship is facing.
 			Vector2D direction = Vector2D::FromAngleRadians(transform->GetRotation());
@@ -0,0 +1,28 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	Tags.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		PAC-MAN
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+namespace Tags
+{
+	// Bits used with GameObject::SetTags and GameObjectManager::GetAllObjectsWithTags.
+	enum Tag : unsigned
+	{
+		// Any object controlled by a ghost AI (including the player-controlled King Ghost).
+		Ghost = 1u << 0,
+	};
+}
+
+//------------------------------------------------------------------------------
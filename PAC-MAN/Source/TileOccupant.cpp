@@ -0,0 +1,95 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	TileOccupant.cpp
+// Author(s):	David Cohen (david.cohen)
+// Project:		PAC-MAN
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "TileOccupant.h"
+
+// Systems
+#include <GameObject.h>
+#include <Space.h>
+#include <TileOccupancyMap.h>
+
+// Components
+#include <Transform.h>
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+namespace Behaviors
+{
+	//------------------------------------------------------------------------------
+	// Public Functions:
+	//------------------------------------------------------------------------------
+
+	// Constructor
+	TileOccupant::TileOccupant() : Component("TileOccupant"), placed(false)
+	{
+	}
+
+	// Destructor
+	TileOccupant::~TileOccupant()
+	{
+		// Take the owner off of its tile so the map never holds deleted objects.
+		if (placed)
+			GetOwner()->GetSpace()->GetTileOccupancy().Remove(*GetOwner());
+	}
+
+	// Clone a component and return a pointer to the cloned component.
+	// Returns:
+	//   A pointer to a dynamically allocated clone of the component.
+	Component* TileOccupant::Clone() const
+	{
+		TileOccupant* clone = new TileOccupant(*this);
+		clone->placed = false;
+		return clone;
+	}
+
+	// Reset the component to match the archetype's, so a pooled object can be reused.
+	// Params:
+	//   archetype = The matching component of the object's archetype.
+	// Returns:
+	//   True, as the component can always be reset.
+	bool TileOccupant::Reset(const Component& archetype)
+	{
+		UNREFERENCED_PARAMETER(archetype);
+
+		// The owner may still be on the tile it was destroyed on.
+		if (placed)
+			GetOwner()->GetSpace()->GetTileOccupancy().Remove(*GetOwner());
+
+		placed = false;
+		return true;
+	}
+
+	// Initialize this component (happens at object creation).
+	void TileOccupant::Initialize()
+	{
+		TileOccupancyMap& tileOccupancy = GetOwner()->GetSpace()->GetTileOccupancy();
+
+		// Place the owner on the tile nearest to its position.
+		int x, y;
+		if (tileOccupancy.WorldToTile(GetOwner()->GetComponent<Transform>()->GetTranslation(), x, y))
+		{
+			tileOccupancy.Place(*GetOwner(), x, y);
+			placed = true;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,67 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	TileOccupant.h
+// Author(s):	David Cohen (david.cohen)
+// Project:		PAC-MAN
+// Course:		WANIC VGP2 2018-2019
+//
+// Copyright  2018 DigiPen (USA) Corporation.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "Component.h" // base class
+
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+namespace Behaviors
+{
+	// Places a static object (such as a dot or fruit) in its space's tile occupancy map for as long as it exists.
+	class TileOccupant : public Component
+	{
+	public:
+		//------------------------------------------------------------------------------
+		// Public Functions:
+		//------------------------------------------------------------------------------
+
+		// Constructor
+		TileOccupant();
+
+		// Destructor
+		~TileOccupant();
+
+		// Clone a component and return a pointer to the cloned component.
+		// Returns:
+		//   A pointer to a dynamically allocated clone of the component.
+		Component* Clone() const override;
+
+		// Reset the component to match the archetype's, so a pooled object can be reused.
+		// Params:
+		//   archetype = The matching component of the object's archetype.
+		// Returns:
+		//   True, as the component can always be reset.
+		bool Reset(const Component& archetype) override;
+
+		// Initialize this component (happens at object creation).
+		void Initialize() override;
+
+	private:
+		//------------------------------------------------------------------------------
+		// Private Variables:
+		//------------------------------------------------------------------------------
+
+		// Whether the owner has been placed in the occupancy map.
+		bool placed;
+	};
+}
+
+//------------------------------------------------------------------------------
@@ -52,6 +52,17 @@ namespace Behaviors
 		return new TimedDeath(*this);
 	}
 
+	// Reset the component to match the archetype's, so a pooled object can be reused.
+	// Params:
+	//   archetype = The matching component of the object's archetype.
+	// Returns:
+	//   True, as the component can always be reset.
+	bool TimedDeath::Reset(const Component& archetype)
+	{
+		timeUntilDeath = static_cast<const TimedDeath&>(archetype).timeUntilDeath;
+		return true;
+	}
+
 	// Loads object data from a file.
 	// Params:
 	//   parser = The parser for the file.
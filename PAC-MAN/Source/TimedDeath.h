@@ -52,6 +52,13 @@ namespace Behaviors
 		//   A pointer to a dynamically allocated clone of the component.
 		Component* Clone() const override;
 
+		// Reset the component to match the archetype's, so a pooled object can be reused.
+		// Params:
+		//   archetype = The matching component of the object's archetype.
+		// Returns:
+		//   True, as the component can always be reset.
+		bool Reset(const Component& archetype) override;
+
 		// Update function for this component.
 		// Params:
 		//   dt = The (fixed) change in time since the last step.